@@ -0,0 +1,95 @@
+#ifndef COLUMNSTORE_H
+#define COLUMNSTORE_H
+
+#include "containers/datacontainer.h"
+#include "models/tour.h"
+#include "models/order.h"
+#include <QVector>
+
+using RowMask = QVector<quint8>;
+
+template<typename T>
+void maskRange(const T* values, qsizetype count, T low, T high, quint8* mask) {
+    for (qsizetype i = 0; i < count; ++i) {
+        mask[i] &= static_cast<quint8>((values[i] >= low) & (values[i] <= high));
+    }
+}
+
+template<typename T>
+void maskEquals(const T* values, qsizetype count, T value, quint8* mask) {
+    for (qsizetype i = 0; i < count; ++i) {
+        mask[i] &= static_cast<quint8>(values[i] == value);
+    }
+}
+
+qint64 maskedSum(const qint64* values, const quint8* mask, qsizetype count);
+
+class TourColumnStore {
+public:
+    TourColumnStore() = default;
+
+    void rebuild(const DataContainer<Tour>& tours);
+    void clear();
+
+    int size() const { return costs_.size(); }
+    quint64 generation() const { return generation_; }
+    RowMask allRows() const { return RowMask(costs_.size(), 1); }
+
+    const QVector<qint64>& costs() const { return costs_; }
+    const QVector<qint64>& startDays() const { return startDays_; }
+    const QVector<qint64>& endDays() const { return endDays_; }
+    const QVector<qint32>& durations() const { return durations_; }
+    const QVector<quint32>& countryIds() const { return countryIds_; }
+
+    void filterCost(qint64 minKopecks, qint64 maxKopecks, RowMask& mask) const;
+    void filterDuration(qint32 minDays, qint32 maxDays, RowMask& mask) const;
+    void filterStartDay(qint64 firstDay, qint64 lastDay, RowMask& mask) const;
+    void filterCountry(quint32 countryId, RowMask& mask) const;
+
+    QVector<int> selectedRows(const RowMask& mask) const;
+    void sortByCost(QVector<int>& rows) const;
+
+    qint64 totalCost(const RowMask& mask) const;
+    bool costRange(qint64& minKopecks, qint64& maxKopecks) const;
+
+private:
+    quint64 generation_ = 0;
+    QVector<qint64> costs_;
+    QVector<qint64> startDays_;
+    QVector<qint64> endDays_;
+    QVector<qint32> durations_;
+    QVector<quint32> countryIds_;
+};
+
+class OrderColumnStore {
+public:
+    OrderColumnStore() = default;
+
+    void rebuild(const DataContainer<Order>& orders);
+    void clear();
+
+    int size() const { return costs_.size(); }
+    quint64 generation() const { return generation_; }
+    RowMask allRows() const { return RowMask(costs_.size(), 1); }
+
+    const QVector<qint64>& costs() const { return costs_; }
+    const QVector<qint64>& orderDays() const { return orderDays_; }
+    const QVector<quint8>& statuses() const { return statuses_; }
+    const QVector<quint32>& countryIds() const { return countryIds_; }
+
+    void filterCost(qint64 minKopecks, qint64 maxKopecks, RowMask& mask) const;
+    void filterOrderDay(qint64 firstDay, qint64 lastDay, RowMask& mask) const;
+    void filterStatus(OrderStatus status, RowMask& mask) const;
+    void filterUnpaid(RowMask& mask) const;
+
+    qint64 totalCost(const RowMask& mask) const;
+
+private:
+    quint64 generation_ = 0;
+    QVector<qint64> costs_;
+    QVector<qint64> orderDays_;
+    QVector<quint8> statuses_;
+    QVector<quint32> countryIds_;
+};
+
+#endif
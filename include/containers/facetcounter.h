@@ -0,0 +1,49 @@
+#ifndef FACETCOUNTER_H
+#define FACETCOUNTER_H
+
+#include "containers/columnstore.h"
+#include <QHash>
+#include <QSet>
+#include <QVector>
+
+class FacetCounter {
+public:
+    static constexpr int MaxFacets = 8;
+
+    FacetCounter() = default;
+
+    void reset(int rowCount);
+    int addFacet(const QVector<quint32>& values);
+
+    int rowCount() const { return base_.size(); }
+    int facetCount() const { return facets_.size(); }
+
+    void setBaseMask(const RowMask& mask);
+    void select(int facet, const QSet<quint32>& values);
+    void select(int facet, quint32 value) { select(facet, QSet<quint32>{value}); }
+    void clearSelection(int facet) { select(facet, QSet<quint32>()); }
+
+    int count(int facet, quint32 value) const;
+    int total(int facet) const;
+    const QHash<quint32, int>& counts(int facet) const { return facets_[facet].counts; }
+
+    bool matches(int row) const { return base_[row] && misses_[row] == 0; }
+    int matchingRows() const { return matching_; }
+    RowMask matchingMask() const;
+
+private:
+    struct Facet {
+        QVector<quint32> values;
+        QSet<quint32> selected;
+        QHash<quint32, int> counts;
+    };
+
+    void applyRow(int row, quint8 misses, int delta);
+
+    QVector<Facet> facets_;
+    RowMask base_;
+    QVector<quint8> misses_;
+    int matching_ = 0;
+};
+
+#endif
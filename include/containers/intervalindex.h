@@ -0,0 +1,52 @@
+#ifndef INTERVALINDEX_H
+#define INTERVALINDEX_H
+
+#include <QVector>
+#include <QDate>
+#include <algorithm>
+
+class IntervalIndex {
+public:
+    struct Interval {
+        qint64 start = 0;
+        qint64 end = 0;
+        int id = -1;
+    };
+
+    IntervalIndex() = default;
+
+    void build(QVector<Interval> intervals);
+    void clear();
+
+    int size() const { return intervals_.size(); }
+    bool isEmpty() const { return intervals_.isEmpty(); }
+
+    QVector<int> overlapping(qint64 first, qint64 last) const;
+    QVector<int> containing(qint64 first, qint64 last) const;
+    QVector<int> within(qint64 first, qint64 last) const;
+    QVector<int> startingIn(qint64 first, qint64 last) const;
+
+    template<typename Predicate>
+    int findStartingBefore(qint64 last, Predicate pred) const {
+        auto end = std::upper_bound(intervals_.cbegin(), intervals_.cend(), last,
+            [](qint64 value, const Interval& interval) { return value < interval.start; });
+        for (auto it = end; it != intervals_.cbegin();) {
+            --it;
+            if (pred(it->id)) {
+                return it->id;
+            }
+        }
+        return -1;
+    }
+
+    static qint64 dayOf(const QDate& date) { return date.toJulianDay(); }
+
+private:
+    qint64 buildMaxEnd(int low, int high);
+    void collect(int low, int high, qint64 startMax, qint64 endMin, QVector<int>& result) const;
+
+    QVector<Interval> intervals_;
+    QVector<qint64> maxEnd_;
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef ORDERSTATUSINDEX_H
+#define ORDERSTATUSINDEX_H
+
+#include "containers/datacontainer.h"
+#include "models/order.h"
+#include <QHash>
+#include <QSet>
+#include <array>
+
+class OrderStatusIndex {
+public:
+    OrderStatusIndex() = default;
+
+    void rebuild(const DataContainer<Order>& orders);
+    void clear();
+
+    void insert(int orderId, OrderStatus status);
+    void remove(int orderId);
+    void update(int orderId, OrderStatus status);
+
+    bool contains(int orderId) const { return statusById_.contains(orderId); }
+    int count(OrderStatus status) const { return idsByStatus_[index(status)].size(); }
+    int unpaidCount() const;
+    int size() const { return statusById_.size(); }
+
+    const QSet<int>& ids(OrderStatus status) const { return idsByStatus_[index(status)]; }
+    QSet<int> unpaidIds() const;
+
+private:
+    static int index(OrderStatus status) { return static_cast<int>(status); }
+
+    std::array<QSet<int>, OrderStatusInfo::Count> idsByStatus_;
+    QHash<int, OrderStatus> statusById_;
+};
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef SCHEDULEINDEX_H
+#define SCHEDULEINDEX_H
+
+#include "containers/datacontainer.h"
+#include "containers/intervalindex.h"
+#include "models/transportcompany.h"
+#include <QDate>
+#include <QVector>
+
+struct ScheduleRef {
+    int companyIndex = -1;
+    int scheduleIndex = -1;
+};
+
+class ScheduleIndex {
+public:
+    ScheduleIndex() = default;
+
+    void rebuild(const DataContainer<TransportCompany>& companies);
+    void clear();
+
+    int size() const { return refs_.size(); }
+
+    QVector<ScheduleRef> overlapping(const QDate& first, const QDate& last) const;
+    QVector<ScheduleRef> containing(const QDate& first, const QDate& last) const;
+    QVector<ScheduleRef> departingBefore(const QDate& date, int days) const;
+    QVector<ScheduleRef> departingBefore(int companyIndex, const QDate& date, int days) const;
+    QVector<ScheduleRef> undated() const;
+
+    template<typename Predicate>
+    ScheduleRef findDepartureBefore(const QDate& date, Predicate pred) const {
+        int id = all_.findStartingBefore(IntervalIndex::dayOf(date),
+                                         [&](int candidate) { return pred(refs_[candidate]); });
+        if (id >= 0) {
+            return refs_[id];
+        }
+        for (int candidate : undated_) {
+            if (pred(refs_[candidate])) {
+                return refs_[candidate];
+            }
+        }
+        return ScheduleRef();
+    }
+
+private:
+    QVector<ScheduleRef> resolve(const QVector<int>& ids) const;
+
+    QVector<ScheduleRef> refs_;
+    QVector<int> undated_;
+    IntervalIndex all_;
+    QVector<IntervalIndex> byCompany_;
+};
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef TOURSEARCHINDEX_H
+#define TOURSEARCHINDEX_H
+
+#include "containers/columnstore.h"
+#include "containers/intervalindex.h"
+#include <QSet>
+#include <QVector>
+#include <limits>
+
+struct TourQuery {
+    enum class DateMatch {
+        Any,
+        Overlaps,
+        Within
+    };
+
+    qint64 minCost = std::numeric_limits<qint64>::min();
+    qint64 maxCost = std::numeric_limits<qint64>::max();
+    qint32 minDuration = std::numeric_limits<qint32>::min();
+    qint32 maxDuration = std::numeric_limits<qint32>::max();
+    qint64 firstStartDay = std::numeric_limits<qint64>::min();
+    qint64 lastStartDay = std::numeric_limits<qint64>::max();
+
+    DateMatch dateMatch = DateMatch::Any;
+    qint64 firstDay = 0;
+    qint64 lastDay = 0;
+
+    bool filterCountries = false;
+    bool excludeCountries = false;
+    QSet<quint32> countryIds;
+
+    int limit = 0;
+};
+
+class TourSearchIndex {
+public:
+    TourSearchIndex() = default;
+
+    void rebuild(const TourColumnStore& columns);
+    void invalidate();
+    bool isValidFor(const TourColumnStore& columns) const;
+
+    int size() const { return byCost_.size(); }
+
+    QVector<int> query(const TourQuery& query) const;
+    int count(const TourQuery& query) const;
+
+private:
+    struct Slice {
+        const int* begin = nullptr;
+        const int* end = nullptr;
+        int size() const { return static_cast<int>(end - begin); }
+    };
+
+    template<typename T>
+    static Slice rangeSlice(const QVector<int>& order, const QVector<T>& values, T low, T high);
+
+    Slice driverSlice(const TourQuery& query, bool& sortedByCost) const;
+    QVector<int> dateCandidates(const TourQuery& query) const;
+    bool matches(int row, const TourQuery& query) const;
+    void sortTopK(QVector<int>& rows, int limit) const;
+
+    const TourColumnStore* columns_ = nullptr;
+    quint64 generation_ = 0;
+    bool valid_ = false;
+    QVector<int> byCost_;
+    QVector<int> byDuration_;
+    QVector<int> byStartDay_;
+    IntervalIndex dates_;
+};
+
+#endif
@@ -29,9 +29,9 @@ public:
                           DataContainer<TransportCompany>* companies,
                           const BookTourUIElements& uiElements);
     
-    double calculateTotalCost() const;
-    double calculateTransportCost() const;
-    double calculateHotelCost() const;
+    Money calculateTotalCost() const;
+    Money calculateTransportCost() const;
+    Money calculateHotelCost() const;
     int calculateNights() const;
     double getStarMultiplier(int stars) const;
     double getCountryMultiplier(const QString& country) const;
@@ -13,6 +13,7 @@
 #include "containers/datacontainer.h"
 #include "dialogs/booktourcostcalculator.h"
 #include "dialogs/toursetuphelper.h"
+#include "utils/routeplanner.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class BookTourDialog; }
@@ -67,11 +68,13 @@ private:
     void updateRoomsCombo();
     void updateToursCombo();
     void updateUIForMode();
+    void updateOriginCombo();
+    void updateRoute();
     
     QString findCountryCapital(const QString& selectedCountry) const;
-    QSet<QString> collectCitiesInCountry(const QString& selectedCountry) const;
+    QSet<Symbol> collectCitiesInCountry(const QString& selectedCountry) const;
     TransportCompany* findSelectedTransportCompany() const;
-    void populateScheduleCombo(TransportCompany* company, const QSet<QString>& citiesInCountry, const QString& capital) const;
+    void populateScheduleCombo(TransportCompany* company, const QSet<Symbol>& citiesInCountry, const QString& capital) const;
     bool findExistingTour(const Tour& tour, int& tourIndex);
     void setupSelectMode(int tourIndex, const QString& clientName, const QString& clientPhone, const QString& clientEmail);
     void setupCreateMode(const Tour& tour, const QString& clientName, const QString& clientPhone, const QString& clientEmail);
@@ -84,6 +87,10 @@ private:
     
     std::unique_ptr<BookTourCostCalculator> costCalculator_;
     std::unique_ptr<TourSetupHelper> tourSetupHelper_;
+    RoutePlanner routePlanner_;
+    
+    static constexpr int MaxRouteTransfers = 2;
+    static constexpr const char* DefaultOriginCity = "Минск";
 };
 
 #endif
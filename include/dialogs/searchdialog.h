@@ -5,6 +5,8 @@
 #include <memory>
 #include "models/tour.h"
 #include "containers/datacontainer.h"
+#include "containers/columnstore.h"
+#include "containers/toursearchindex.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class SearchDialog; }
@@ -15,7 +17,9 @@ class SearchDialog : public QDialog {
 
 public:
     explicit SearchDialog(QWidget *parent = nullptr, 
-                         DataContainer<Tour>* tours = nullptr);
+                         DataContainer<Tour>* tours = nullptr,
+                         const TourColumnStore* columns = nullptr,
+                         TourSearchIndex* index = nullptr);
     ~SearchDialog();
 
 private slots:
@@ -25,11 +29,19 @@ private slots:
 private:
     std::unique_ptr<Ui::SearchDialog> ui;
     DataContainer<Tour>* tours_;
+    const TourColumnStore* columns_;
+    TourSearchIndex* index_;
+    TourColumnStore localColumns_;
+    TourSearchIndex localIndex_;
     
-    void updateResultsTable(const QVector<Tour>& results);
-    bool matchesTourFilter(const Tour& tour, const QString& countryFilter, double maxCost,
-                          int minDuration, int countryFilterState, int costFilterState,
-                          int durationFilterState) const;
+    static constexpr int ResultLimit = 1000;
+    
+    void ensureIndex();
+    TourQuery buildQuery(const QString& countryFilter, const Money& maxCost, int minDuration,
+                         int countryFilterState, int costFilterState,
+                         int durationFilterState) const;
+    void applyDateFilter(TourQuery& query) const;
+    void updateResultsTable(const QVector<int>& rows, int totalMatches);
 };
 
 #endif
@@ -47,18 +47,18 @@ private:
     void updateTransportCombo();
     void updateSchedulesCombo();
     
-    double calculateTransportCost() const;
-    double calculateHotelCost() const;
+    Money calculateTransportCost() const;
+    Money calculateHotelCost() const;
     TransportCompany* findSelectedTransportCompany() const;
     
     Hotel getSelectedHotel(const QString& country) const;
     void setupTourTransport(Tour& tour, const QString& country) const;
     
     bool hasRelevantScheduleForCountry(const TransportCompany& company, 
-                                       const QSet<QString>& citiesInCountry, 
+                                       const QSet<Symbol>& citiesInCountry, 
                                        const QString& capital) const;
     void populateScheduleCombo(TransportCompany* company, 
-                               const QSet<QString>& citiesInCountry, 
+                               const QSet<Symbol>& citiesInCountry, 
                                const QString& capital) const;
 };
 
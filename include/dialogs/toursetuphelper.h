@@ -6,6 +6,12 @@
 #include "models/hotel.h"
 #include "models/transportcompany.h"
 #include "containers/datacontainer.h"
+#include "containers/scheduleindex.h"
+#include "utils/fuzzymatcher.h"
+#include "utils/symboltable.h"
+#include <QSet>
+#include <QDate>
+#include <QVector>
 
 QT_BEGIN_NAMESPACE
 class QComboBox;
@@ -14,6 +20,8 @@ QT_END_NAMESPACE
 
 class TourSetupHelper {
 public:
+    static constexpr int ScheduleWindowDays = 30;
+    
     TourSetupHelper(DataContainer<Country>* countries,
                    DataContainer<Hotel>* hotels,
                    DataContainer<TransportCompany>* companies,
@@ -38,19 +46,24 @@ public:
                            QComboBox* scheduleCombo) const;
     
     QString findCountryCapital(const QString& selectedCountry) const;
-    QSet<QString> collectCitiesInCountry(const QString& selectedCountry) const;
+    QSet<Symbol> collectCitiesInCountry(const QString& selectedCountry) const;
+    QVector<int> orderSchedulesForStart(TransportCompany* company, const QDate& startDate) const;
+    bool arrivesIn(Symbol arrivalCity, const QSet<Symbol>& cities, const QString& capital) const;
 
 private:
     DataContainer<Country>* countries_;
     DataContainer<Hotel>* hotels_;
     DataContainer<TransportCompany>* companies_;
     DataContainer<Tour>* tours_;
+    ScheduleIndex scheduleIndex_;
+    FuzzyIndex cityIndex_;
     
     TransportCompany* findSelectedTransportCompany(QComboBox* countryCombo,
                                                    QComboBox* transportCombo) const;
     void findAndSetSchedule(QComboBox* scheduleCombo, TransportCompany* company,
                            const TransportSchedule& schedule, int scheduleIndex) const;
     int findScheduleComboIndex(QComboBox* scheduleCombo, int scheduleIndex) const;
+    void buildCityIndex();
 };
 
 #endif
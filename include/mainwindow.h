@@ -10,17 +10,26 @@
 #include <QSet>
 #include <QString>
 #include <QWidget>
+#include <array>
 #include <memory>
 #include "containers/datacontainer.h"
+#include "containers/orderstatusindex.h"
+#include "containers/columnstore.h"
+#include "containers/toursearchindex.h"
+#include "containers/facetcounter.h"
 #include "models/country.h"
 #include "models/hotel.h"
 #include "models/transportcompany.h"
 #include "models/tour.h"
 #include "models/order.h"
+#include "utils/tourlinker.h"
 #include "utils/filemanager.h"
+#include "utils/orderpartitions.h"
+#include "utils/snapshotcache.h"
 #include "mainwindow/tablemanager.h"
 #include "mainwindow/filtermanager.h"
 #include "mainwindow/filtercomboupdater.h"
+#include "mainwindow/diagnosticsdock.h"
 #include "mainwindow/actions/action.h"
 #include "mainwindow/actions/countryactions.h"
 #include "mainwindow/actions/hotelactions.h"
@@ -30,6 +39,8 @@
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QTimer>
+#include <QThread>
+#include <QPointer>
 #include <QMap>
 
 QT_BEGIN_NAMESPACE
@@ -47,6 +58,9 @@ private slots:
 
     void saveData();
     void loadData();
+    void loadOrderArchive();
+    void archiveFinishedOrders();
+    void searchOrderArchive();
 
     void onTabChanged(int index);
     
@@ -60,6 +74,11 @@ private slots:
     void updateCurrencyRates();
     void onCurrencyDataReceived(QNetworkReply* reply);
 
+    void setTracingEnabled(bool enabled);
+    void exportTrace();
+    void clearTrace();
+    void verifyDataFiles();
+
 private:
     std::unique_ptr<Ui::MainWindow> ui;
     
@@ -68,11 +87,50 @@ private:
     DataContainer<TransportCompany> transportCompanies_;
     DataContainer<Tour> tours_;
     DataContainer<Order> orders_;
+    OrderStatusIndex orderStatusIndex_;
+    TourColumnStore tourColumns_;
+    TourSearchIndex tourSearchIndex_;
+    FacetCounter countryFacets_;
+    FacetCounter hotelFacets_;
+    FacetCounter transportFacets_;
+    FacetCounter tourFacets_;
+    FacetCounter orderFacets_;
+    TourLinker tourLinker_;
+    OrderColumnStore orderColumns_;
+    
+    static constexpr int UnpaidStatusFilter = -1;
+    static constexpr int ContinentFacet = 0;
+    static constexpr int CurrencyFacet = 1;
+    static constexpr int HotelCountryFacet = 0;
+    static constexpr int StarsFacet = 1;
+    static constexpr int TransportTypeFacet = 0;
+    static constexpr int TourCountryFacet = 0;
+    static constexpr int OrderStatusFacet = 0;
+    
+    enum View {
+        CountriesView,
+        HotelsView,
+        TransportView,
+        ToursView,
+        OrdersView,
+        ViewCount
+    };
+    
+    enum StalePart {
+        StaleTable = 1,
+        StaleFilters = 2,
+        StaleAll = StaleTable | StaleFilters
+    };
     
     FileManager fileManager_;
+    OrderPartitions orderPartitions_;
     
     QNetworkAccessManager* networkManager_;
     QTimer* currencyTimer_;
+    DiagnosticsDock* diagnosticsDock_;
+    QTimer* idleRefreshTimer_;
+    QPointer<QThread> snapshotThread_;
+    std::array<int, ViewCount> staleViews_{};
     
     void setupUI();
     void setupCurrencyUpdater();
@@ -96,21 +154,25 @@ private:
     int getSelectedTourIndex() const;
     int getSelectedOrderIndex() const;
     
+    View viewForTab(int index) const;
+    bool isViewVisible(View view) const;
+    bool isViewStale(View view) const { return staleViews_[view] != 0; }
+    bool deferIfHidden(View view, int parts = StaleTable);
+    void refreshView(View view);
+    void refreshNextStaleView();
+    
     void linkToursWithHotelsAndTransport();
     void linkOrdersToursWithHotelsAndTransport();
     
-    QString findCountryCapital(const QString& countryName) const;
-    QSet<QString> collectTargetCities(const QString& tourCountry, const QString& capital) const;
-    Hotel* findHotelForTour(const QString& tourCountry);
-    bool matchesCity(const QString& arrivalCity, const QSet<QString>& targetCities, 
-                     const QString& capital, const QString& tourCountry) const;
-    bool findTransportForTour(Tour& tour, const QSet<QString>& targetCities, 
-                               const QString& capital, const QDate& tourStartDate);
     
     QString findDataDirectory() const;
     bool validateDataDirectory(const QString& dataPath);
     QStringList checkRequiredFiles(const QString& dataPath);
     void clearAllData();
+    void openOrderPartitions(const QString& dataPath);
+    void saveOrdersTo(const QString& dataPath);
+    void saveOrderStatus(const QString& dataPath, const Order& order, bool wasOpen);
+    void reloadOrdersView();
     struct LoadResult {
         int countries = 0;
         int hotels = 0;
@@ -120,6 +182,9 @@ private:
         QStringList errors;
     };
     LoadResult loadAllDataFiles(const QString& dataPath);
+    bool loadSnapshot(const SnapshotCache& snapshot, LoadResult& result);
+    void saveSnapshotInBackground(const SnapshotCache& snapshot, const QByteArray& fingerprint);
+    void waitForSnapshotThread();
     void showLoadResults(const LoadResult& result, const QString& dataPath);
     
     QWidget* createActionButtons(int dataIndex, const QString& type);
@@ -135,6 +200,21 @@ private:
     void updateTransportFilterCombo();
     void updateToursFilterCombo();
     void updateOrdersFilterCombo();
+    void updateOrderStatusCounts();
+    void applyOrderStatusFilter(int filterCode, RowMask& mask) const;
+    bool isRowInMask(QTableWidget* table, int row, const RowMask& mask) const;
+    void rebuildCountryFacets();
+    void rebuildHotelFacets();
+    void rebuildTransportFacets();
+    void rebuildTourFacets();
+    void rebuildOrderFacets();
+    void tourDataChanged();
+    void orderDataChanged();
+    RowMask searchMask(QTableWidget* table, int rowCount, const QString& searchText,
+                       int excludeColumn = -1) const;
+    static void selectFacet(FacetCounter& facets, int facet, const QVariant& key);
+    void applyFacetVisibility(QTableWidget* table, const FacetCounter& facets);
+    void updateFacetLabels(QComboBox* combo, const FacetCounter& facets, int facet);
     
     void applyCountriesFilters();
     void applyHotelsFilters();
@@ -177,7 +257,6 @@ private:
     int getSelectedRow(QTableWidget* table) const;
     
     bool matchesSearchInTable(QTableWidget* table, int row, const QString& searchText, int excludeColumn = -1) const;
-    double extractCostFromTableItem(QTableWidget* table, int row, int column) const;
     
     void resizeEvent(QResizeEvent* event) override;
 };
@@ -0,0 +1,62 @@
+#ifndef DIAGNOSTICSDOCK_H
+#define DIAGNOSTICSDOCK_H
+
+#include <QDockWidget>
+#include "containers/datacontainer.h"
+#include "models/country.h"
+#include "models/hotel.h"
+#include "models/transportcompany.h"
+#include "models/tour.h"
+#include "models/order.h"
+#include "utils/memoryaccounting.h"
+#include <QElapsedTimer>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QTableWidget;
+class QTimer;
+QT_END_NAMESPACE
+
+class DiagnosticsDock : public QDockWidget {
+public:
+    static constexpr int RefreshIntervalMs = 1000;
+    static constexpr int MemoryRefreshIntervalMs = 30000;
+
+    DiagnosticsDock(const DataContainer<Country>* countries,
+                    const DataContainer<Hotel>* hotels,
+                    const DataContainer<TransportCompany>* companies,
+                    const DataContainer<Tour>* tours,
+                    const DataContainer<Order>* orders,
+                    QWidget* parent = nullptr);
+
+    void refresh();
+    void showMemoryReport();
+
+protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+
+private:
+    static QString formatDuration(qint64 nanoseconds);
+    static QString formatBytes(qint64 bytes);
+
+    void refreshMetrics();
+    void refreshContainers();
+    void measureMemory();
+    void applyMemoryReport(const MemoryAccounting::Report& report);
+
+    const DataContainer<Country>* countries_;
+    const DataContainer<Hotel>* hotels_;
+    const DataContainer<TransportCompany>* companies_;
+    const DataContainer<Tour>* tours_;
+    const DataContainer<Order>* orders_;
+
+    QTableWidget* metricsTable_;
+    QTableWidget* containersTable_;
+    QTimer* refreshTimer_;
+    QElapsedTimer memoryAge_;
+    QVector<int> measuredCounts_;
+    QVector<qint64> measuredBytes_;
+};
+
+#endif
@@ -2,11 +2,14 @@
 #define FILTERCOMBOUPDATER_H
 
 #include <QComboBox>
+#include <QVariant>
+#include <functional>
 #include "containers/datacontainer.h"
 #include "models/country.h"
 #include "models/hotel.h"
 #include "models/transportcompany.h"
 #include "models/tour.h"
+#include "models/orderstatus.h"
 
 QT_BEGIN_NAMESPACE
 class QComboBox;
@@ -14,8 +17,13 @@ QT_END_NAMESPACE
 
 class FilterComboUpdater {
 public:
+    static constexpr int LabelRole = Qt::UserRole + 3;
+    
     FilterComboUpdater();
     
+    static void addFacetItem(QComboBox* combo, const QString& label, const QVariant& key);
+    static void updateFacetCounts(QComboBox* combo, const std::function<int(const QVariant&)>& countFor);
+    
     void updateCountriesFilterCombo(QComboBox* continentCombo,
                                    QComboBox* currencyCombo,
                                    const DataContainer<Country>& countries);
@@ -5,6 +5,10 @@
 #include <QTableWidget>
 #include <QLineEdit>
 #include <QComboBox>
+#include "utils/symboltable.h"
+#include "models/orderstatus.h"
+#include "models/transportcompany.h"
+#include "containers/columnstore.h"
 
 QT_BEGIN_NAMESPACE
 class QTableWidget;
@@ -28,11 +32,13 @@ public:
                              QLineEdit* searchEdit,
                              QComboBox* typeCombo);
     void applyToursFilters(QTableWidget* table,
+                          const TourColumnStore& columns,
                           QLineEdit* searchEdit,
                           QComboBox* countryCombo,
                           QLineEdit* minPriceEdit,
                           QLineEdit* maxPriceEdit);
     void applyOrdersFilters(QTableWidget* table,
+                           const OrderColumnStore& columns,
                            QLineEdit* searchEdit,
                            QComboBox* statusCombo,
                            QLineEdit* minCostEdit,
@@ -40,7 +46,8 @@ public:
 
 private:
     bool matchesSearchText(QTableWidget* table, int row, const QString& searchText) const;
-    double extractCostFromItem(QTableWidgetItem* item) const;
+    bool isRowInMask(QTableWidget* table, int row, const RowMask& mask) const;
+    bool matchesSymbol(QTableWidgetItem* item, Symbol filter) const;
 };
 
 #endif
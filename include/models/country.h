@@ -2,6 +2,7 @@
 #define COUNTRY_H
 
 #include "models/touristservice.h"
+#include "utils/symboltable.h"
 #include <QString>
 #include <iostream>
 #include <fstream>
@@ -13,14 +14,20 @@ public:
     QString getType() const override { return "Country"; }
     QString getDescription() const override;
     
-    QString getContinent() const { return continent_; }
-    void setContinent(const QString& continent) { continent_ = continent; }
+    QString getContinent() const { return continent_.toString(); }
+    Symbol getContinentSymbol() const { return continent_; }
+    void setContinent(const QString& continent) { continent_ = Symbol(continent); }
+    void setContinent(Symbol continent) { continent_ = continent; }
     
-    QString getCapital() const { return capital_; }
-    void setCapital(const QString& capital) { capital_ = capital; }
+    QString getCapital() const { return capital_.toString(); }
+    Symbol getCapitalSymbol() const { return capital_; }
+    void setCapital(const QString& capital) { capital_ = Symbol(capital); }
+    void setCapital(Symbol capital) { capital_ = capital; }
     
-    QString getCurrency() const { return currency_; }
-    void setCurrency(const QString& currency) { currency_ = currency; }
+    QString getCurrency() const { return currency_.toString(); }
+    Symbol getCurrencySymbol() const { return currency_; }
+    void setCurrency(const QString& currency) { currency_ = Symbol(currency); }
+    void setCurrency(Symbol currency) { currency_ = currency; }
     
     friend bool operator==(const Country& lhs, const Country& rhs) {
         return lhs.getName() == rhs.getName() && lhs.continent_ == rhs.continent_ &&
@@ -35,9 +42,9 @@ public:
     
     friend std::ostream& operator<<(std::ostream& os, const Country& country) {
         os << country.getName().toStdString() << "\n"
-           << country.continent_.toStdString() << "\n"
-           << country.capital_.toStdString() << "\n"
-           << country.currency_.toStdString() << "\n";
+           << country.continent_.toString().toStdString() << "\n"
+           << country.capital_.toString().toStdString() << "\n"
+           << country.currency_.toString().toStdString() << "\n";
         return os;
     }
     
@@ -52,9 +59,9 @@ public:
         std::getline(is, currency);
         
         country.setName(QString::fromStdString(name));
-        country.continent_ = QString::fromStdString(continent);
-        country.capital_ = QString::fromStdString(capital);
-        country.currency_ = QString::fromStdString(currency);
+        country.continent_ = Symbol(QString::fromStdString(continent));
+        country.capital_ = Symbol(QString::fromStdString(capital));
+        country.currency_ = Symbol(QString::fromStdString(currency));
         
         return is;
     }
@@ -63,9 +70,9 @@ public:
     void readFromFile(std::ifstream& ifs);
 
 private:
-    QString continent_;
-    QString capital_ = "";
-    QString currency_ = "";
+    Symbol continent_;
+    Symbol capital_;
+    Symbol currency_;
 };
 
 #endif
@@ -3,6 +3,7 @@
 
 #include "models/touristservice.h"
 #include "models/room.h"
+#include "utils/symboltable.h"
 #include <QString>
 #include <QVector>
 #include <memory>
@@ -14,10 +15,12 @@ public:
     
     QString getType() const override { return "Hotel"; }
     QString getDescription() const override;
-    double calculateCost() const override;
+    Money calculateCost() const override;
     
-    QString getCountry() const { return country_; }
-    void setCountry(const QString& country) { country_ = country; }
+    QString getCountry() const { return country_.toString(); }
+    Symbol getCountrySymbol() const { return country_; }
+    void setCountry(const QString& country) { country_ = Symbol(country); }
+    void setCountry(Symbol country) { country_ = country; }
     
     int getStars() const { return stars_; }
     void setStars(int stars) { stars_ = stars; }
@@ -33,7 +36,7 @@ public:
     int getRoomCount() const { return rooms_.size(); }
 
 private:
-    QString country_;
+    Symbol country_;
     int stars_;
     QString address_;
     QVector<Room> rooms_;
@@ -0,0 +1,75 @@
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <QString>
+#include <QtGlobal>
+#include <exception>
+#include <string>
+
+class MoneyException : public std::exception {
+public:
+    explicit MoneyException(const QString& message) : message_(message.toStdString()) {}
+    const char* what() const noexcept override { return message_.c_str(); }
+private:
+    std::string message_;
+};
+
+class Money {
+public:
+    static constexpr qint64 KopecksPerUnit = 100;
+    static constexpr quint32 DefaultCurrency = (quint32('B') << 16) | (quint32('Y') << 8) | quint32('N');
+
+    constexpr Money() = default;
+    constexpr explicit Money(qint64 kopecks, quint32 currency = DefaultCurrency)
+        : kopecks_(kopecks), currency_(currency) {}
+
+    static Money fromDouble(double amount, quint32 currency = DefaultCurrency);
+    static bool tryParse(const QString& text, Money& result, quint32 currency = DefaultCurrency);
+    static Money fromString(const QString& text, quint32 currency = DefaultCurrency);
+
+    static quint32 currencyFromCode(const QString& code);
+    static QString codeFromCurrency(quint32 currency);
+
+    qint64 kopecks() const { return kopecks_; }
+    quint32 currency() const { return currency_; }
+    QString currencyCode() const { return codeFromCurrency(currency_); }
+
+    bool isZero() const { return kopecks_ == 0; }
+    bool isPositive() const { return kopecks_ > 0; }
+
+    double toDouble() const { return static_cast<double>(kopecks_) / KopecksPerUnit; }
+    QString toString() const;
+    QString toDisplayString() const;
+
+    Money scaled(double factor) const;
+
+    Money& operator+=(const Money& other);
+    Money& operator-=(const Money& other);
+
+    friend Money operator+(Money lhs, const Money& rhs) { return lhs += rhs; }
+    friend Money operator-(Money lhs, const Money& rhs) { return lhs -= rhs; }
+    friend Money operator*(const Money& money, qint64 count) { return Money(money.kopecks_ * count, money.currency_); }
+    friend Money operator*(qint64 count, const Money& money) { return money * count; }
+
+    friend bool operator==(const Money& lhs, const Money& rhs) {
+        return lhs.kopecks_ == rhs.kopecks_ && lhs.currency_ == rhs.currency_;
+    }
+    friend bool operator!=(const Money& lhs, const Money& rhs) { return !(lhs == rhs); }
+    friend bool operator<(const Money& lhs, const Money& rhs) {
+        return lhs.currency_ != rhs.currency_ ? lhs.currency_ < rhs.currency_ : lhs.kopecks_ < rhs.kopecks_;
+    }
+    friend bool operator>(const Money& lhs, const Money& rhs) { return rhs < lhs; }
+    friend bool operator<=(const Money& lhs, const Money& rhs) { return !(rhs < lhs); }
+    friend bool operator>=(const Money& lhs, const Money& rhs) { return !(lhs < rhs); }
+
+    static qint64 sumKopecks(const qint64* values, qsizetype count);
+    static bool rangeKopecks(const qint64* values, qsizetype count, qint64& minValue, qint64& maxValue);
+
+private:
+    void checkCurrency(const Money& other) const;
+
+    qint64 kopecks_ = 0;
+    quint32 currency_ = DefaultCurrency;
+};
+
+#endif
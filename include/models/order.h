@@ -2,11 +2,16 @@
 #define ORDER_H
 
 #include "models/tour.h"
+#include "models/orderstatus.h"
+#include "utils/orderidallocator.h"
 #include <QString>
 #include <QDate>
 #include <QDateTime>
 #include <iostream>
 #include <fstream>
+#include <memory>
+
+class OrderDetailSource;
 
 class Order {
 public:
@@ -14,9 +19,23 @@ public:
     Order(const Tour& tour, const QString& clientName, const QString& clientPhone, const QString& clientEmail = "");
     
     int getId() const { return id_; }
+    void setId(int id) { id_ = id; }
+    bool hasId() const { return id_ > 0; }
     
-    Tour getTour() const { return tour_; }
-    void setTour(const Tour& tour) { tour_ = tour; }
+    Tour getTour() const;
+    std::shared_ptr<const Tour> getSharedTour() const { return tour_; }
+    void setTour(const Tour& tour);
+    void setTour(std::shared_ptr<const Tour> tour);
+
+    void setLazyTour(std::shared_ptr<OrderDetailSource> source, int row,
+                     Symbol tourName, Symbol tourCountry, const Money& cost);
+    bool hasLazyTour() const { return details_ != nullptr; }
+    const std::shared_ptr<OrderDetailSource>& getDetailSource() const { return details_; }
+    int getDetailRow() const { return detailRow_; }
+
+    QString getTourName() const { return tourName_.toString(); }
+    QString getTourCountry() const { return tourCountry_.toString(); }
+    Symbol getTourCountrySymbol() const { return tourCountry_; }
     
     QString getClientName() const { return clientName_; }
     void setClientName(const QString& name) { clientName_ = name; }
@@ -30,10 +49,12 @@ public:
     QDateTime getOrderDate() const { return orderDate_; }
     void setOrderDate(const QDateTime& date) { orderDate_ = date; }
     
-    double getTotalCost() const { return tour_.calculateCost(); }
+    Money getTotalCost() const { return cost_; }
     
-    QString getStatus() const { return status_; }
-    void setStatus(const QString& status) { status_ = status; }
+    OrderStatus getStatus() const { return status_; }
+    QString getStatusText() const { return OrderStatusInfo::toString(status_); }
+    void setStatus(OrderStatus status) { status_ = status; }
+    void transitionTo(OrderStatus status);
     
     QString toString() const;
     
@@ -51,11 +72,11 @@ public:
     
     friend std::ostream& operator<<(std::ostream& os, const Order& order) {
         os << order.id_ << "\n";
-        os << order.tour_.getName().toStdString() << "\n";
+        os << order.getTourName().toStdString() << "\n";
         os << order.clientName_.toStdString() << "\n";
         os << order.clientPhone_.toStdString() << "\n";
         os << order.orderDate_.toString(Qt::ISODate).toStdString() << "\n";
-        os << order.status_.toStdString() << "\n";
+        os << order.getStatusText().toStdString() << "\n";
         return os;
     }
     
@@ -66,6 +87,7 @@ public:
         std::string dateStr;
         std::string status;
         is >> order.id_;
+        OrderIdAllocator::instance().observe(order.id_);
         std::getline(is, tourName);
         std::getline(is, clientName);
         std::getline(is, clientPhone);
@@ -75,7 +97,7 @@ public:
         order.clientName_ = QString::fromStdString(clientName);
         order.clientPhone_ = QString::fromStdString(clientPhone);
         order.orderDate_ = QDateTime::fromString(QString::fromStdString(dateStr), Qt::ISODate);
-        order.status_ = QString::fromStdString(status);
+        order.status_ = OrderStatusInfo::fromString(QString::fromStdString(status));
         
         return is;
     }
@@ -84,14 +106,18 @@ public:
     void readFromFile(std::ifstream& ifs);
 
 private:
-    static int nextId_;
-    int id_;
-    Tour tour_;
+    int id_ = 0;
+    std::shared_ptr<const Tour> tour_;
+    std::shared_ptr<OrderDetailSource> details_;
+    int detailRow_ = -1;
+    Symbol tourName_;
+    Symbol tourCountry_;
+    Money cost_;
     QString clientName_;
     QString clientPhone_;
     QString clientEmail_;
     QDateTime orderDate_ = QDateTime::currentDateTime();
-    QString status_ = "В обработке";
+    OrderStatus status_ = OrderStatus::Processing;
 };
 
 #endif
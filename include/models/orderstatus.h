@@ -0,0 +1,45 @@
+#ifndef ORDERSTATUS_H
+#define ORDERSTATUS_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <Qt>
+#include <exception>
+#include <string>
+
+enum class OrderStatus : quint8 {
+    Processing,
+    Confirmed,
+    Paid,
+    Completed,
+    Cancelled
+};
+
+class OrderStatusException : public std::exception {
+public:
+    explicit OrderStatusException(const QString& message) : message_(message.toStdString()) {}
+    const char* what() const noexcept override { return message_.c_str(); }
+private:
+    std::string message_;
+};
+
+class OrderStatusInfo {
+public:
+    static constexpr int Count = 5;
+    static constexpr int StatusRole = Qt::UserRole + 2;
+
+    static QString toString(OrderStatus status);
+    static bool tryParse(const QString& str, OrderStatus& status);
+    static OrderStatus fromString(const QString& str);
+
+    static bool canTransition(OrderStatus from, OrderStatus to);
+    static QVector<OrderStatus> allowedTransitions(OrderStatus from);
+    static bool isUnpaid(OrderStatus status);
+    static bool isFinal(OrderStatus status);
+
+    static QVector<OrderStatus> all();
+    static QStringList names();
+};
+
+#endif
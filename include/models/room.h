@@ -14,7 +14,7 @@ public:
     };
 
     explicit Room(const QString& name = "", RoomType type = RoomType::Single, 
-         double pricePerNight = 0.0, int capacity = 1);
+         const Money& pricePerNight = Money(), int capacity = 1);
     
     QString getType() const override { return "Room"; }
     QString getDescription() const override;
@@ -25,8 +25,8 @@ public:
     int getCapacity() const { return capacity_; }
     void setCapacity(int capacity) { capacity_ = capacity; }
     
-    double getPricePerNight() const { return pricePerNight_; }
-    void setPricePerNight(double price) { pricePerNight_ = price; }
+    Money getPricePerNight() const { return pricePerNight_; }
+    void setPricePerNight(const Money& price) { pricePerNight_ = price; }
     
     static QString roomTypeToString(RoomType type);
     static RoomType stringToRoomType(const QString& str);
@@ -34,7 +34,7 @@ public:
 private:
     RoomType roomType_;
     int capacity_;
-    double pricePerNight_;
+    Money pricePerNight_;
 };
 
 #endif
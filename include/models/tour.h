@@ -5,6 +5,7 @@
 #include "models/country.h"
 #include "models/hotel.h"
 #include "models/transportcompany.h"
+#include "utils/symboltable.h"
 #include <QString>
 #include <QDate>
 #include <memory>
@@ -16,10 +17,12 @@ public:
     
     QString getType() const override { return "Tour"; }
     QString getDescription() const override;
-    double calculateCost() const override;
+    Money calculateCost() const override;
     
-    QString getCountry() const { return country_; }
-    void setCountry(const QString& country) { country_ = country; }
+    QString getCountry() const { return country_.toString(); }
+    Symbol getCountrySymbol() const { return country_; }
+    void setCountry(const QString& country) { country_ = Symbol(country); }
+    void setCountry(Symbol country) { country_ = country; }
     
     QDate getStartDate() const { return startDate_; }
     void setStartDate(const QDate& date) { startDate_ = date; }
@@ -41,7 +44,7 @@ public:
     TransportSchedule getTransportSchedule() const { return transportSchedule_; }
 
 private:
-    QString country_;
+    Symbol country_;
     QDate startDate_;
     QDate endDate_;
     Hotel hotel_;
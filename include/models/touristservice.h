@@ -1,34 +1,35 @@
 #ifndef TOURISTSERVICE_H
 #define TOURISTSERVICE_H
 
+#include "models/money.h"
 #include <QString>
 #include <QDate>
 #include <memory>
 
 class TouristService {
 public:
-    explicit TouristService(const QString& name = "", double price = 0.0);
+    explicit TouristService(const QString& name = "", const Money& price = Money());
     virtual ~TouristService() = default;
 
     QString getName() const { return name_; }
     void setName(const QString& name) { name_ = name; }
 
-    double getPrice() const { return price_; }
-    void setPrice(double price) { price_ = price; }
+    Money getPrice() const { return price_; }
+    void setPrice(const Money& price) { price_ = price; }
 
     virtual QString getType() const = 0;
     virtual QString getDescription() const = 0;
     
-    virtual double calculateCost() const { return price_; }
+    virtual Money calculateCost() const { return price_; }
     
     virtual void writeToStream(std::ostream& os) const;
     virtual void readFromStream(std::istream& is);
 
 protected:
     void setNameProtected(const QString& name) { name_ = name; }
-    void setPriceProtected(double price) { price_ = price; }
+    void setPriceProtected(const Money& price) { price_ = price; }
     const QString& getNameProtected() const { return name_; }
-    double getPriceProtected() const { return price_; }
+    Money getPriceProtected() const { return price_; }
 
     friend std::ostream& operator<<(std::ostream& os, const TouristService& service) {
         service.writeToStream(os);
@@ -42,7 +43,7 @@ protected:
 
 private:
     QString name_;
-    double price_;
+    Money price_;
 };
 
 #endif
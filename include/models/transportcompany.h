@@ -2,16 +2,17 @@
 #define TRANSPORTCOMPANY_H
 
 #include "models/touristservice.h"
+#include "utils/symboltable.h"
 #include <QString>
 #include <QDate>
 #include <QVector>
 
 struct TransportSchedule {
-    QString departureCity;
-    QString arrivalCity;
+    Symbol departureCity;
+    Symbol arrivalCity;
     QDate departureDate;
     QDate arrivalDate;
-    double price = 0.0;
+    Money price;
     int availableSeats = 0;
     
     TransportSchedule() = default;
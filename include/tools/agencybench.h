@@ -0,0 +1,54 @@
+#ifndef AGENCYBENCH_H
+#define AGENCYBENCH_H
+
+#include "containers/datacontainer.h"
+#include "models/country.h"
+#include "models/hotel.h"
+#include "models/transportcompany.h"
+#include "models/tour.h"
+#include "models/order.h"
+#include <QJsonObject>
+#include <QString>
+#include <QTextStream>
+#include <QVector>
+#include <functional>
+
+class AgencyBench {
+public:
+    struct Result {
+        QString name;
+        int size = 0;
+        int iterations = 0;
+        qint64 minNs = 0;
+        qint64 medianNs = 0;
+        qint64 maxNs = 0;
+        qint64 records = 0;
+    };
+
+    explicit AgencyBench(QTextStream& log);
+
+    void setIterations(int iterations) { iterations_ = iterations; }
+    void setFilter(const QString& filter) { filter_ = filter; }
+
+    QVector<Result> run(int records);
+
+    static QJsonObject toJson(const QVector<Result>& results, const QVector<int>& sizes);
+
+private:
+    void measure(const QString& name, qint64 records, const std::function<void()>& body);
+    bool enabled(const QString& name) const;
+
+    QTextStream& log_;
+    int iterations_ = 5;
+    QString filter_;
+    int size_ = 0;
+    QVector<Result> results_;
+
+    DataContainer<Country> countries_;
+    DataContainer<Hotel> hotels_;
+    DataContainer<TransportCompany> companies_;
+    DataContainer<Tour> tours_;
+    DataContainer<Order> orders_;
+};
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef AGENCYCLI_H
+#define AGENCYCLI_H
+
+#include "containers/datacontainer.h"
+#include "models/country.h"
+#include "models/hotel.h"
+#include "models/transportcompany.h"
+#include "models/tour.h"
+#include "models/order.h"
+#include "utils/filemanager.h"
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+#include <QVector>
+
+class AgencyCli {
+public:
+    enum ExitCode {
+        Success = 0,
+        Failure = 1,
+        UsageError = 2
+    };
+
+    enum class Format {
+        Unknown,
+        Text,
+        Stream,
+        Json,
+        Binary
+    };
+
+    AgencyCli(QTextStream& out, QTextStream& err);
+
+    int run(const QStringList& arguments);
+
+    static Format parseFormat(const QString& name);
+    static QString formatName(Format format);
+    static Format detectFormat(const QString& path);
+
+private:
+    struct Timing {
+        QString step;
+        qint64 nanoseconds = 0;
+        int records = 0;
+    };
+
+    int runCommand(const QString& command, const QStringList& rest);
+    int runStats(const QStringList& arguments);
+    int runValidate(const QStringList& arguments);
+    int runConvert(const QStringList& arguments);
+    int runRelink(const QStringList& arguments);
+    int runPrice(const QStringList& arguments);
+    int runMemory(const QStringList& arguments);
+    int runIndex(const QStringList& arguments);
+    int runOrder(const QStringList& arguments);
+    int runOrders(const QStringList& arguments);
+    int runPartition(const QStringList& arguments);
+    int runArchive(const QStringList& arguments);
+    int runArchiveSearch(const QStringList& arguments);
+    int runVerify(const QStringList& arguments);
+    int runBench(const QStringList& arguments);
+    int runGenerate(const QStringList& arguments);
+    void printUsage() const;
+
+    bool load(const QString& path, Format format);
+    int loadOrders(const QString& dataPath);
+    void saveOrders(const QString& dataPath) const;
+    void save(const QString& path, Format format) const;
+    void clear();
+    void relink();
+    QStringList validate() const;
+    void printTimings() const;
+
+    template<typename Step>
+    void timed(const QString& step, Step&& action);
+
+    static QString option(const QStringList& arguments, const QString& name,
+                          const QString& defaultValue = QString());
+    static bool hasFlag(const QStringList& arguments, const QString& name);
+    static QStringList positional(const QStringList& arguments);
+    static Format formatFor(const QStringList& arguments, const QString& name, const QString& path);
+    static QStringList orderFiles(const QString& dataPath);
+
+    QTextStream& out_;
+    QTextStream& err_;
+    FileManager fileManager_;
+
+    DataContainer<Country> countries_;
+    DataContainer<Hotel> hotels_;
+    DataContainer<TransportCompany> companies_;
+    DataContainer<Tour> tours_;
+    DataContainer<Order> orders_;
+
+    QVector<Timing> timings_;
+    QStringList loadErrors_;
+};
+
+#endif
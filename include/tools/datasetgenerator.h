@@ -0,0 +1,70 @@
+#ifndef DATASETGENERATOR_H
+#define DATASETGENERATOR_H
+
+#include "containers/datacontainer.h"
+#include "models/country.h"
+#include "models/hotel.h"
+#include "models/transportcompany.h"
+#include "models/tour.h"
+#include "models/order.h"
+#include <QDate>
+#include <QString>
+#include <QVector>
+#include <functional>
+
+class DatasetGenerator {
+public:
+    struct Options {
+        int countries = 0;
+        int citiesPerCountry = 3;
+        int hotels = 0;
+        int roomsPerHotel = 3;
+        int companies = 0;
+        int schedulesPerCompany = 20;
+        int tours = 0;
+        int orders = 0;
+        double countrySkew = 1.0;
+        double citySkew = 1.0;
+        quint64 seed = 1;
+
+        static Options forRecords(int records);
+    };
+
+    using Progress = std::function<void(const QString& file, qint64 written)>;
+
+    explicit DatasetGenerator(const Options& options);
+
+    const Options& options() const { return options_; }
+
+    Country country(int index) const;
+    Hotel hotel(int index) const;
+    TransportCompany company(int index) const;
+    Tour tour(int index) const;
+    Order order(int index) const;
+
+    void generate(DataContainer<Country>& countries,
+                  DataContainer<Hotel>& hotels,
+                  DataContainer<TransportCompany>& companies,
+                  DataContainer<Tour>& tours,
+                  DataContainer<Order>& orders) const;
+
+    qint64 writeText(const QString& directory, const Progress& progress = Progress()) const;
+
+private:
+    static QVector<double> zipfTable(int count, double skew);
+
+    quint64 random(quint64 stream, qint64 index) const;
+    int pick(quint64 stream, qint64 index, int bound) const;
+    int pickSkewed(const QVector<double>& table, quint64 stream, qint64 index) const;
+
+    QString countryName(int index) const;
+    QString capitalOf(int countryIndex) const;
+    QString cityIn(int countryIndex, int variant) const;
+
+    Options options_;
+    QDate firstDay_;
+    QVector<double> countryTable_;
+    QVector<double> cityTable_;
+};
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef BLOCKCHECKSUMS_H
+#define BLOCKCHECKSUMS_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class BlockChecksums {
+public:
+    static constexpr quint32 Magic = 0x54414353;
+    static constexpr quint32 FormatVersion = 1;
+    static constexpr qint64 DefaultBlockSize = 64 * 1024;
+
+    enum class Status {
+        Ok,
+        Unchecked,
+        Modified,
+        Corrupt,
+        Missing
+    };
+
+    struct Damage {
+        int block = 0;
+        qint64 offset = 0;
+        qint64 length = 0;
+        qint64 firstLine = 0;
+        qint64 lastLine = 0;
+    };
+
+    struct Report {
+        QString filename;
+        Status status = Status::Unchecked;
+        qint64 size = 0;
+        int blocks = 0;
+        qint64 expectedSize = 0;
+        bool changedAfterSeal = false;
+        QVector<Damage> damage;
+
+        bool isCorrupt() const { return status == Status::Corrupt; }
+        QString describe() const;
+    };
+
+    static QString pathFor(const QString& dataFile);
+
+    static BlockChecksums compute(const char* data, qint64 size, qint64 blockSize = DefaultBlockSize);
+    static BlockChecksums computeFile(const QString& dataFile, qint64 blockSize = DefaultBlockSize);
+    static bool seal(const QString& dataFile);
+
+    static Report verify(const QString& dataFile);
+    static QVector<Report> verifyDirectory(const QString& dataPath);
+
+    qint64 blockSize() const { return blockSize_; }
+    qint64 sourceSize() const { return sourceSize_; }
+    int size() const { return crcs_.size(); }
+    quint32 crc(int block) const { return crcs_[block]; }
+
+    void stamp(const QString& dataFile);
+
+    bool load(const QString& path);
+    bool save(const QString& path) const;
+
+private:
+    qint64 blockSize_ = DefaultBlockSize;
+    qint64 sourceSize_ = 0;
+    qint64 sourceModified_ = 0;
+    QVector<quint32> crcs_;
+};
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef CRC32C_H
+#define CRC32C_H
+
+#include <QtGlobal>
+
+class Crc32c {
+public:
+    static quint32 compute(const char* data, qint64 size, quint32 crc = 0);
+    static void computeBlocks(const char* data, qint64 size, qint64 blockSize, quint32* crcs);
+
+    static bool isHardwareAccelerated();
+    static const char* implementation();
+};
+
+#endif
@@ -7,8 +7,11 @@
 #include "models/transportcompany.h"
 #include "models/tour.h"
 #include "models/order.h"
+#include "utils/recordindex.h"
 #include <QString>
+#include <QStringList>
 #include <QFile>
+#include <QSaveFile>
 #include <QTextStream>
 #include <exception>
 
@@ -22,8 +25,34 @@ private:
 
 class FileManager {
 public:
+    enum class Parser {
+        Stream,
+        Mapped
+    };
+
+    enum class Format {
+        V1,
+        V2
+    };
+
     FileManager();
 
+    Parser parser() const { return parser_; }
+    void setParser(Parser parser) { parser_ = parser; }
+
+    Format format() const { return format_; }
+    void setFormat(Format format) { format_ = format; }
+
+    bool indexing() const { return indexing_; }
+    void setIndexing(bool indexing) { indexing_ = indexing; }
+
+    bool lazyOrderDetails() const { return lazyOrderDetails_; }
+    void setLazyOrderDetails(bool lazy) { lazyOrderDetails_ = lazy; }
+
+    bool checksums() const { return checksums_; }
+    void setChecksums(bool checksums) { checksums_ = checksums; }
+    QStringList takeChecksumWarnings() const;
+
     void saveCountries(const DataContainer<Country>& countries, const QString& filename) const;
     void saveHotels(const DataContainer<Hotel>& hotels, const QString& filename) const;
     void saveTransportCompanies(const DataContainer<TransportCompany>& companies, const QString& filename) const;
@@ -36,6 +65,12 @@ public:
     void loadTours(DataContainer<Tour>& tours, const QString& filename) const;
     void loadOrders(DataContainer<Order>& orders, const QString& filename) const;
 
+    RecordIndex openIndex(const QString& filename) const;
+    Tour readTour(const QString& filename, const RecordIndex& index, int row) const;
+    Order readOrder(const QString& filename, const RecordIndex& index, int row) const;
+    void updateOrder(const QString& filename, RecordIndex& index, const Order& order,
+                     const DataContainer<Order>& orders) const;
+
     void saveAll(const DataContainer<Country>& countries,
                  const DataContainer<Hotel>& hotels,
                  const DataContainer<TransportCompany>& companies,
@@ -50,26 +85,59 @@ public:
                  DataContainer<Order>& orders,
                  const QString& basePath = "data") const;
 
+    void saveHeaderToStream(QTextStream& out, const QString& header, int count) const;
+    void saveOrderIdHighWaterToStream(QTextStream& out, int nextId) const;
+    void saveCountryToStream(QTextStream& out, const Country& country) const;
+    void saveHotelToStream(QTextStream& out, const Hotel& hotel) const;
+    void saveTransportCompanyToStream(QTextStream& out, const TransportCompany& company) const;
+    void saveTourToStream(QTextStream& out, const Tour& tour) const;
+    void saveOrderToStream(QTextStream& out, const Order& order) const;
+
 private:
     QString dataPath_;
+    Parser parser_ = Parser::Mapped;
+    Format format_ = Format::V2;
+    bool indexing_ = true;
+    bool lazyOrderDetails_ = true;
+    bool checksums_ = true;
+    mutable QStringList checksumWarnings_;
+
+    struct ReferenceCatalog;
     
-    void openFileForWriting(QFile& file, const QString& filename) const;
+    void openFileForWriting(QSaveFile& file, const QString& filename) const;
+    void commitFile(QSaveFile& file, const QString& filename) const;
     void openFileForReading(QFile& file, const QString& filename) const;
     void validateFileHeader(QTextStream& in, const QString& expectedHeader) const;
+    void writeIndex(const QString& filename) const;
+    void writeChecksums(const QString& filename) const;
+    void verifyChecksums(const QString& filename) const;
+    void rebindOrderDetails(const DataContainer<Order>& orders, const QVector<int>& detailRows,
+                            const QString& filename) const;
+    void refreshOrderDetails(const DataContainer<Order>& orders, const QString& filename,
+                             const RecordIndex& index) const;
     
-    void saveHotelToStream(QTextStream& out, const Hotel& hotel) const;
     void saveRoomToStream(QTextStream& out, const Room& room) const;
-    void saveTransportCompanyToStream(QTextStream& out, const TransportCompany& company) const;
     void saveScheduleToStream(QTextStream& out, const TransportSchedule& schedule) const;
+    void saveToursV2(QTextStream& out, const DataContainer<Tour>& tours) const;
+    void saveOrdersV2(QTextStream& out, const DataContainer<Order>& orders, QVector<int>& tourRefs) const;
+    QString tourRecordV2(const Tour& tour, ReferenceCatalog& catalog) const;
     
     Hotel loadHotelFromStream(QTextStream& in) const;
     Room loadRoomFromStream(QTextStream& in) const;
     TransportCompany loadTransportCompanyFromStream(QTextStream& in) const;
     TransportSchedule loadScheduleFromStream(QTextStream& in) const;
+    void loadToursV2(QTextStream& in, DataContainer<Tour>& tours) const;
+    void loadOrdersV2(QTextStream& in, DataContainer<Order>& orders) const;
+    void loadCatalogFromStream(QTextStream& in, QVector<Hotel>& hotels, QVector<TransportCompany>& companies) const;
+    Tour loadTourRecordFromStream(QTextStream& in, const QVector<Hotel>& hotels,
+                                  const QVector<TransportCompany>& companies) const;
     
     Room readRoomFromStream(QTextStream& in, const QString& hotelName, int hotelIndex, int roomIndex) const;
     void skipInvalidHotelLines(QTextStream& in, int linesToSkip) const;
-    QString determineOrderStatus(QTextStream& in, int orderIndex, int totalOrders) const;
+    bool parseMoney(const QString& text, Money& result) const;
+    Money readMoney(QTextStream& in) const;
+    bool readOrderIdHighWater(QTextStream& in) const;
+    OrderStatus readOrderStatus(QTextStream& in) const;
 };
 
 #endif
@@ -0,0 +1,54 @@
+#ifndef FUZZYMATCHER_H
+#define FUZZYMATCHER_H
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QVector>
+#include "utils/symboltable.h"
+
+class FuzzyMatcher {
+public:
+    static QString normalize(const QString& text);
+    static int editDistance(const QString& lhs, const QString& rhs);
+    static int maxDistanceFor(int length);
+    static bool isSimilar(const QString& normalizedLhs, const QString& normalizedRhs);
+    static bool matches(const QString& lhs, const QString& rhs);
+    static bool matchesNormalized(const QString& left, const QString& right);
+
+private:
+    static int bitParallelDistance(const QString& pattern, const QString& text);
+    static int dynamicDistance(const QString& lhs, const QString& rhs);
+};
+
+class FuzzyIndex {
+public:
+    FuzzyIndex() = default;
+
+    void clear();
+    void add(Symbol symbol);
+    void add(const QSet<Symbol>& symbols);
+
+    int size() const { return entries_.size(); }
+
+    QVector<Symbol> lookup(const QString& query) const;
+    QVector<Symbol> similarTo(Symbol symbol) const;
+    QString normalized(Symbol symbol) const;
+
+private:
+    struct Entry {
+        Symbol symbol;
+        QString normalized;
+    };
+
+    QVector<Symbol> lookupNormalized(const QString& normalized) const;
+    static QVector<quint32> bigrams(const QString& normalized);
+
+    QVector<Entry> entries_;
+    QHash<quint32, int> bySymbol_;
+    QHash<quint32, QVector<int>> postings_;
+    QHash<int, QVector<int>> byLength_;
+    mutable QHash<quint32, QVector<Symbol>> similarCache_;
+};
+
+#endif
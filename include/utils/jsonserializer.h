@@ -0,0 +1,53 @@
+#ifndef JSONSERIALIZER_H
+#define JSONSERIALIZER_H
+
+#include "containers/datacontainer.h"
+#include "models/country.h"
+#include "models/hotel.h"
+#include "models/transportcompany.h"
+#include "models/tour.h"
+#include "models/order.h"
+#include <QByteArray>
+#include <QJsonObject>
+#include <QString>
+
+class JsonSerializer {
+public:
+    static constexpr int FormatVersion = 1;
+
+    static QJsonObject toJson(const DataContainer<Country>& countries,
+                              const DataContainer<Hotel>& hotels,
+                              const DataContainer<TransportCompany>& companies,
+                              const DataContainer<Tour>& tours,
+                              const DataContainer<Order>& orders);
+
+    static void fromJson(const QJsonObject& root,
+                         DataContainer<Country>& countries,
+                         DataContainer<Hotel>& hotels,
+                         DataContainer<TransportCompany>& companies,
+                         DataContainer<Tour>& tours,
+                         DataContainer<Order>& orders);
+
+    static QByteArray encode(const QJsonObject& root, bool binary);
+    static QJsonObject decode(const QByteArray& data, bool binary);
+
+    static QJsonObject countryToJson(const Country& country);
+    static QJsonObject hotelToJson(const Hotel& hotel);
+    static QJsonObject companyToJson(const TransportCompany& company);
+    static QJsonObject scheduleToJson(const TransportSchedule& schedule);
+    static QJsonObject tourToJson(const Tour& tour);
+    static QJsonObject orderToJson(const Order& order);
+
+    static Country countryFromJson(const QJsonObject& object);
+    static Hotel hotelFromJson(const QJsonObject& object);
+    static TransportCompany companyFromJson(const QJsonObject& object);
+    static TransportSchedule scheduleFromJson(const QJsonObject& object);
+    static Tour tourFromJson(const QJsonObject& object);
+    static Order orderFromJson(const QJsonObject& object);
+
+private:
+    static QJsonObject moneyToJson(const Money& money);
+    static Money moneyFromJson(const QJsonObject& object);
+};
+
+#endif
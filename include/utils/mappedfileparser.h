@@ -0,0 +1,29 @@
+#ifndef MAPPEDFILEPARSER_H
+#define MAPPEDFILEPARSER_H
+
+#include "containers/datacontainer.h"
+#include "models/country.h"
+#include "models/hotel.h"
+#include "models/transportcompany.h"
+#include "models/tour.h"
+#include "models/order.h"
+#include "utils/recordindex.h"
+#include <QString>
+
+class MappedFileParser {
+public:
+    MappedFileParser() = default;
+
+    void loadCountries(DataContainer<Country>& countries, const QString& filename) const;
+    void loadHotels(DataContainer<Hotel>& hotels, const QString& filename) const;
+    void loadTransportCompanies(DataContainer<TransportCompany>& companies, const QString& filename) const;
+    void loadTours(DataContainer<Tour>& tours, const QString& filename) const;
+    void loadOrders(DataContainer<Order>& orders, const QString& filename, bool lazyDetails = false) const;
+
+    RecordIndex buildIndex(const QString& filename) const;
+    Tour readTour(const QString& filename, const RecordIndex& index, int row) const;
+    Order readOrder(const QString& filename, const RecordIndex& index, int row) const;
+    Tour readCatalogTour(const QString& filename, const RecordIndex& index, int row) const;
+};
+
+#endif
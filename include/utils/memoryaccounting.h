@@ -0,0 +1,63 @@
+#ifndef MEMORYACCOUNTING_H
+#define MEMORYACCOUNTING_H
+
+#include "containers/datacontainer.h"
+#include "models/country.h"
+#include "models/hotel.h"
+#include "models/transportcompany.h"
+#include "models/tour.h"
+#include "models/order.h"
+#include <QJsonObject>
+#include <QString>
+#include <QVector>
+
+class MemoryAccounting {
+public:
+    struct EntityStats {
+        QString type;
+        int count = 0;
+        qint64 containerBytes = 0;
+        qint64 deepBytes = 0;
+        qint64 ownedBytes = 0;
+
+        qint64 bytesPerEntity() const { return count > 0 ? deepBytes / count : 0; }
+    };
+
+    struct StringStats {
+        qint64 references = 0;
+        qint64 logicalBytes = 0;
+        qint64 buffers = 0;
+        qint64 physicalBytes = 0;
+        qint64 duplicateBuffers = 0;
+        qint64 duplicateBytes = 0;
+    };
+
+    struct Offender {
+        QString text;
+        int buffers = 0;
+        int references = 0;
+        qint64 wastedBytes = 0;
+    };
+
+    struct Report {
+        QVector<EntityStats> entities;
+        StringStats strings;
+        QVector<Offender> offenders;
+        int symbols = 0;
+        qint64 symbolTableBytes = 0;
+        qint64 totalBytes = 0;
+    };
+
+    static Report measure(const DataContainer<Country>& countries,
+                          const DataContainer<Hotel>& hotels,
+                          const DataContainer<TransportCompany>& companies,
+                          const DataContainer<Tour>& tours,
+                          const DataContainer<Order>& orders,
+                          int topCount = 10);
+
+    static QString toText(const Report& report);
+    static QJsonObject toJson(const Report& report);
+    static QString formatBytes(qint64 bytes);
+};
+
+#endif
@@ -3,14 +3,17 @@
 
 #include <QTableWidgetItem>
 #include <QVariant>
+#include "models/money.h"
 
 class NumericSortItem : public QTableWidgetItem {
 public:
-    NumericSortItem(const QString& text, double numericValue)
-        : QTableWidgetItem(text), numericValue_(numericValue) {
-        setData(Qt::DisplayRole, text);
-        setData(Qt::UserRole, numericValue);
-        setData(Qt::EditRole, numericValue);
+    NumericSortItem(const QString& text, qlonglong sortKey)
+        : QTableWidgetItem(text), sortKey_(sortKey) {
+        setData(Qt::UserRole, sortKey_);
+    }
+    
+    explicit NumericSortItem(const Money& amount)
+        : NumericSortItem(amount.toDisplayString(), amount.kopecks()) {
     }
     
     bool operator<(const QTableWidgetItem& other) const override {
@@ -18,7 +21,7 @@ public:
     }
     
     friend bool operator<(const NumericSortItem& lhs, const NumericSortItem& rhs) {
-        return lhs.numericValue_ < rhs.numericValue_;
+        return lhs.sortKey_ < rhs.sortKey_;
     }
     
 private:
@@ -28,18 +31,8 @@ private:
         }
         
         QVariant otherData = other->data(Qt::UserRole);
-        if (otherData.isValid() && otherData.canConvert<double>()) {
-            double otherValue = otherData.toDouble();
-            return numericValue_ < otherValue;
-        }
-        
-        QString otherText = other->text();
-        otherText = otherText.replace(" руб", "").replace(" ", "").trimmed();
-        bool ok;
-        double otherValue = otherText.toDouble(&ok);
-        
-        if (ok) {
-            return numericValue_ < otherValue;
+        if (otherData.isValid() && otherData.canConvert<qlonglong>()) {
+            return sortKey_ < otherData.toLongLong();
         }
         
         return false;
@@ -47,14 +40,13 @@ private:
     
     QVariant data(int role) const override {
         if (role == Qt::UserRole) {
-            return numericValue_;
+            return sortKey_;
         }
         return QTableWidgetItem::data(role);
     }
     
 private:
-    double numericValue_;
+    qlonglong sortKey_;
 };
 
 #endif
-
@@ -0,0 +1,69 @@
+#ifndef ORDERARCHIVE_H
+#define ORDERARCHIVE_H
+
+#include "containers/datacontainer.h"
+#include "models/order.h"
+#include <QByteArray>
+#include <QDate>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+class OrderArchive {
+public:
+    static constexpr quint32 Magic = 0x54414152;
+    static constexpr quint32 BlockMagic = 0x54414142;
+    static constexpr quint32 FormatVersion = 1;
+    static constexpr int OrdersPerBlock = 4096;
+
+    struct Block {
+        qint64 offset = 0;
+        qint64 length = 0;
+        bool tombstone = false;
+        QDate firstDate;
+        QDate lastDate;
+        QVector<qint32> ids;
+
+        bool overlaps(const QDate& first, const QDate& last) const;
+    };
+
+    struct Query {
+        int id = 0;
+        QString text;
+        QDate since;
+        QDate until;
+    };
+
+    explicit OrderArchive(const QString& dataPath = QString());
+
+    static QString pathIn(const QString& dataPath);
+    static bool existsIn(const QString& dataPath);
+    static bool isArchivable(const Order& order, const QDate& before = QDate());
+
+    bool isActive() const { return !path_.isEmpty(); }
+    const QString& path() const { return path_; }
+    const QVector<Block>& blocks() const { return blocks_; }
+    int size() const { return live_.size(); }
+    bool contains(int orderId) const { return live_.contains(orderId); }
+
+    void open();
+    int append(const DataContainer<Order>& orders);
+    int archive(DataContainer<Order>& orders, const QDate& before = QDate());
+    DataContainer<Order> search(const Query& query) const;
+    int restore(const QVector<int>& orderIds, DataContainer<Order>& orders);
+
+private:
+    QString path_;
+    QVector<Block> blocks_;
+    QHash<int, int> live_;
+    qint64 archiveSize_ = 0;
+
+    bool loadIndex();
+    void saveIndex() const;
+    void scan();
+    void rebuildLive();
+    void writeBlock(Block block, const QByteArray& payload);
+    DataContainer<Order> readBlock(int row) const;
+};
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef ORDERDETAILSOURCE_H
+#define ORDERDETAILSOURCE_H
+
+#include "models/tour.h"
+#include "utils/recordindex.h"
+#include <QHash>
+#include <QString>
+#include <memory>
+#include <mutex>
+
+class OrderDetailSource {
+public:
+    OrderDetailSource(const QString& filename, const QString& header);
+
+    const QString& filename() const { return filename_; }
+
+    std::shared_ptr<const Tour> tour(int row) const;
+    void rebind(const RecordIndex& index, const QHash<int, int>& rows);
+    void refresh(const RecordIndex& index);
+
+private:
+    QString filename_;
+    bool normalized_ = false;
+    qint64 sourceSize_ = -1;
+    qint64 sourceModified_ = 0;
+    bool remapped_ = false;
+    QHash<int, int> rows_;
+
+    mutable std::mutex mutex_;
+    mutable bool indexed_ = false;
+    mutable RecordIndex index_;
+    mutable QHash<int, std::shared_ptr<const Tour>> tours_;
+
+    void openIndex() const;
+};
+
+#endif
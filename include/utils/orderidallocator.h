@@ -0,0 +1,26 @@
+#ifndef ORDERIDALLOCATOR_H
+#define ORDERIDALLOCATOR_H
+
+#include <atomic>
+
+class OrderIdAllocator {
+public:
+    static OrderIdAllocator& instance();
+
+    int allocate();
+    int reserve(int count);
+    void observe(int id);
+
+    int peekNext() const { return next_.load(std::memory_order_acquire); }
+    void reset(int next = 1) { next_.store(next, std::memory_order_release); }
+
+    OrderIdAllocator(const OrderIdAllocator&) = delete;
+    OrderIdAllocator& operator=(const OrderIdAllocator&) = delete;
+
+private:
+    OrderIdAllocator() = default;
+
+    std::atomic<int> next_{1};
+};
+
+#endif
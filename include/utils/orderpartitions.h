@@ -0,0 +1,72 @@
+#ifndef ORDERPARTITIONS_H
+#define ORDERPARTITIONS_H
+
+#include "containers/datacontainer.h"
+#include "models/order.h"
+#include <QDate>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class FileManager;
+
+class OrderPartitions {
+public:
+    static constexpr int DefaultRecentYears = 2;
+
+    struct Partition {
+        int year = 0;
+        QString fileName;
+        int orderCount = 0;
+        int openCount = 0;
+        QDate firstDate;
+        QDate lastDate;
+        bool loaded = false;
+
+        bool overlaps(const QDate& first, const QDate& last) const;
+    };
+
+    explicit OrderPartitions(const QString& dataPath = QString());
+
+    static QString directoryIn(const QString& dataPath);
+    static bool existIn(const QString& dataPath);
+    static QString fileNameFor(int year);
+    static int yearOf(const Order& order);
+    static bool isOpen(const Order& order);
+
+    bool isActive() const { return !directory_.isEmpty(); }
+    const QString& directory() const { return directory_; }
+    QString catalogPath() const;
+    QString filePath(const Partition& partition) const;
+    QString filePathFor(const Order& order) const;
+    QStringList sourceFiles() const;
+
+    const QVector<Partition>& partitions() const { return partitions_; }
+    bool isEmpty() const { return partitions_.isEmpty(); }
+    int loadedCount() const;
+
+    bool readCatalog();
+    void writeCatalog() const;
+
+    QVector<int> prune(const QDate& first, const QDate& last) const;
+    QVector<int> recent(int years = DefaultRecentYears, const QDate& today = QDate::currentDate()) const;
+
+    int load(const FileManager& fileManager, DataContainer<Order>& orders, const QVector<int>& rows);
+    int loadRange(const FileManager& fileManager, DataContainer<Order>& orders, const QDate& first, const QDate& last);
+    int loadRecent(const FileManager& fileManager, DataContainer<Order>& orders, int years = DefaultRecentYears);
+    int loadAll(const FileManager& fileManager, DataContainer<Order>& orders);
+    void markLoaded(const DataContainer<Order>& orders);
+    void markAllLoaded();
+
+    void save(const FileManager& fileManager, const DataContainer<Order>& orders);
+    void orderClosed(const Order& order);
+
+private:
+    QString directory_;
+    QVector<Partition> partitions_;
+
+    int find(int year) const;
+    static void summarize(Partition& partition, const DataContainer<Order>& orders);
+};
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#include <QElapsedTimer>
+#include <QString>
+#include <array>
+#include <atomic>
+
+class PerfCounters {
+public:
+    enum Metric {
+        LoadCountries,
+        LoadHotels,
+        LoadTransport,
+        LoadTours,
+        LoadOrders,
+        LinkTours,
+        LinkOrders,
+        TableRefresh,
+        Filter,
+        MetricCount
+    };
+
+    struct Snapshot {
+        qint64 count = 0;
+        qint64 lastNs = 0;
+        qint64 p50Ns = 0;
+        qint64 p99Ns = 0;
+    };
+
+    static PerfCounters& instance();
+    static QString metricName(Metric metric);
+
+    void record(Metric metric, qint64 nanoseconds);
+    Snapshot snapshot(Metric metric) const;
+    void reset();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+private:
+    static constexpr int SubBuckets = 4;
+    static constexpr int BucketCount = 64 * SubBuckets;
+
+    struct Slot {
+        std::atomic<qint64> lastNs{0};
+        std::array<std::atomic<quint32>, BucketCount> buckets{};
+    };
+
+    PerfCounters() = default;
+
+    static int bucketFor(qint64 nanoseconds);
+    static qint64 bucketMidpoint(int bucket);
+
+    std::array<Slot, MetricCount> slots_;
+};
+
+class PerfTimer {
+public:
+    explicit PerfTimer(PerfCounters::Metric metric)
+        : metric_(metric) {
+        timer_.start();
+    }
+
+    ~PerfTimer() {
+        PerfCounters::instance().record(metric_, timer_.nsecsElapsed());
+    }
+
+    PerfTimer(const PerfTimer&) = delete;
+    PerfTimer& operator=(const PerfTimer&) = delete;
+
+private:
+    PerfCounters::Metric metric_;
+    QElapsedTimer timer_;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef RECORDINDEX_H
+#define RECORDINDEX_H
+
+#include "models/tour.h"
+#include <QString>
+#include <QVector>
+#include <array>
+
+class RecordIndex {
+public:
+    static constexpr quint32 Magic = 0x54414958;
+    static constexpr quint32 FormatVersion = 1;
+
+    enum Section {
+        Hotels,
+        Companies,
+        Tours,
+        Records,
+        SectionCount
+    };
+
+    struct Entry {
+        qint64 offset = 0;
+        qint64 length = 0;
+        quint64 keyHash = 0;
+    };
+
+    static QString pathFor(const QString& dataFile);
+
+    static quint64 keyHash(const char* data, qsizetype size, quint64 seed = 14695981039346656037ULL);
+    static quint64 keyHash(const QString& key);
+    static quint64 tourKey(const Tour& tour);
+    static quint64 orderKey(int orderId);
+
+    const QString& header() const { return header_; }
+    void setHeader(const QString& header) { header_ = header; }
+
+    bool hasStoredIds() const { return hasStoredIds_; }
+    void setHasStoredIds(bool stored) { hasStoredIds_ = stored; }
+
+    int size(Section section) const { return sections_[section].size(); }
+    const Entry& entry(Section section, int row) const { return sections_[section][row]; }
+    void append(Section section, const Entry& entry) { sections_[section].append(entry); }
+    void reserve(Section section, int count) { sections_[section].reserve(count); }
+    int find(Section section, quint64 keyHash, int from = 0) const;
+
+    void resize(Section section, int row, qint64 length);
+
+    void stamp(const QString& dataFile);
+    bool matches(const QString& dataFile) const;
+
+    bool load(const QString& path);
+    bool save(const QString& path) const;
+
+private:
+    QString header_;
+    bool hasStoredIds_ = false;
+    qint64 sourceSize_ = -1;
+    qint64 sourceModified_ = 0;
+    std::array<QVector<Entry>, SectionCount> sections_;
+};
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef ROUTEPLANNER_H
+#define ROUTEPLANNER_H
+
+#include <QDate>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QVector>
+#include "containers/datacontainer.h"
+#include "models/money.h"
+#include "models/transportcompany.h"
+#include "utils/symboltable.h"
+
+struct RouteLeg {
+    int companyIndex = -1;
+    int scheduleIndex = -1;
+    Symbol from;
+    Symbol to;
+    QDate departure;
+    QDate arrival;
+    Money price;
+};
+
+struct Route {
+    QVector<RouteLeg> legs;
+    Money totalPrice;
+
+    bool isEmpty() const { return legs.isEmpty(); }
+    int transfers() const { return legs.isEmpty() ? 0 : legs.size() - 1; }
+    QDate departure() const { return legs.isEmpty() ? QDate() : legs.first().departure; }
+    QDate arrival() const { return legs.isEmpty() ? QDate() : legs.last().arrival; }
+    QString toString() const;
+};
+
+enum class RouteCriterion {
+    Cheapest,
+    Fastest
+};
+
+struct RouteRequest {
+    Symbol origin;
+    QSet<Symbol> destinations;
+    QDate earliestDeparture;
+    QDate latestArrival;
+    int maxTransfers = 2;
+    int minLayoverDays = 0;
+    RouteCriterion criterion = RouteCriterion::Cheapest;
+};
+
+class RoutePlanner {
+public:
+    RoutePlanner() = default;
+
+    void rebuild(const DataContainer<TransportCompany>& companies);
+    void clear();
+
+    int edgeCount() const { return edges_.size(); }
+    QVector<Symbol> departureCities() const;
+
+    Route findRoute(const RouteRequest& request) const;
+
+private:
+    struct Edge {
+        quint32 from = 0;
+        quint32 to = 0;
+        qint64 departure = 0;
+        qint64 arrival = 0;
+        qint64 price = 0;
+        int companyIndex = -1;
+        int scheduleIndex = -1;
+    };
+
+    struct Label {
+        quint32 city = 0;
+        qint64 arrival = 0;
+        qint64 cost = 0;
+        int legs = 0;
+        int edge = -1;
+        int parent = -1;
+    };
+
+    bool isDominated(const QVector<Label>& labels, const QVector<int>& bag, const Label& candidate) const;
+    Route buildRoute(const QVector<Label>& labels, int last) const;
+
+    QVector<Edge> edges_;
+    QHash<quint32, QVector<int>> outgoing_;
+};
+
+#endif
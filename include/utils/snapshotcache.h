@@ -0,0 +1,47 @@
+#ifndef SNAPSHOTCACHE_H
+#define SNAPSHOTCACHE_H
+
+#include "containers/datacontainer.h"
+#include "models/country.h"
+#include "models/hotel.h"
+#include "models/transportcompany.h"
+#include "models/tour.h"
+#include "models/order.h"
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+
+class SnapshotCache {
+public:
+    static constexpr quint32 Magic = 0x54415350;
+    static constexpr quint32 FormatVersion = 1;
+
+    SnapshotCache(const QString& cachePath, const QStringList& sourceFiles);
+
+    static QString defaultCachePath(const QString& dataPath);
+    static QStringList sourceFilesIn(const QString& dataPath);
+
+    const QString& cachePath() const { return cachePath_; }
+    QByteArray fingerprint() const;
+
+    bool load(DataContainer<Country>& countries,
+              DataContainer<Hotel>& hotels,
+              DataContainer<TransportCompany>& companies,
+              DataContainer<Tour>& tours,
+              DataContainer<Order>& orders) const;
+
+    bool save(const QByteArray& fingerprint,
+              const DataContainer<Country>& countries,
+              const DataContainer<Hotel>& hotels,
+              const DataContainer<TransportCompany>& companies,
+              const DataContainer<Tour>& tours,
+              const DataContainer<Order>& orders) const;
+
+    void remove() const;
+
+private:
+    QString cachePath_;
+    QStringList sourceFiles_;
+};
+
+#endif
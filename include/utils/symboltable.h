@@ -0,0 +1,57 @@
+#ifndef SYMBOLTABLE_H
+#define SYMBOLTABLE_H
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QReadWriteLock>
+#include <Qt>
+
+class Symbol {
+public:
+    Symbol() = default;
+    explicit Symbol(const QString& text);
+
+    static Symbol fromId(quint32 id);
+    static Symbol find(const QString& text);
+
+    quint32 id() const { return id_; }
+    bool isEmpty() const { return id_ == 0; }
+    QString toString() const;
+
+    friend bool operator==(Symbol lhs, Symbol rhs) { return lhs.id_ == rhs.id_; }
+    friend bool operator!=(Symbol lhs, Symbol rhs) { return lhs.id_ != rhs.id_; }
+    friend bool operator<(Symbol lhs, Symbol rhs) { return lhs.id_ < rhs.id_; }
+
+private:
+    quint32 id_ = 0;
+};
+
+inline size_t qHash(Symbol symbol, size_t seed = 0) noexcept {
+    return qHash(symbol.id(), seed);
+}
+
+class SymbolTable {
+public:
+    static constexpr int SymbolRole = Qt::UserRole + 1;
+
+    static SymbolTable& instance();
+
+    quint32 intern(const QString& text);
+    quint32 lookup(const QString& text) const;
+    QString text(quint32 id) const;
+    int size() const;
+    qint64 memoryUsage() const;
+
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+private:
+    SymbolTable();
+
+    mutable QReadWriteLock lock_;
+    QVector<QString> strings_;
+    QHash<QString, quint32> ids_;
+};
+
+#endif
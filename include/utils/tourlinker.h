@@ -0,0 +1,66 @@
+#ifndef TOURLINKER_H
+#define TOURLINKER_H
+
+#include "containers/datacontainer.h"
+#include "containers/scheduleindex.h"
+#include "models/country.h"
+#include "models/hotel.h"
+#include "models/transportcompany.h"
+#include "models/tour.h"
+#include "models/order.h"
+#include "utils/fuzzymatcher.h"
+#include "utils/symboltable.h"
+#include <QDate>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+class TourLinker {
+public:
+    struct Result {
+        int tours = 0;
+        int withHotel = 0;
+        int withTransport = 0;
+        int orders = 0;
+        int ordersLinked = 0;
+    };
+
+    TourLinker(DataContainer<Country>* countries,
+               DataContainer<Hotel>* hotels,
+               DataContainer<TransportCompany>* companies,
+               DataContainer<Tour>* tours,
+               DataContainer<Order>* orders);
+
+    Result linkTours();
+    Result linkOrders();
+
+    static void buildCityIndex(FuzzyIndex& index,
+                               const DataContainer<Country>* countries,
+                               const DataContainer<Hotel>* hotels,
+                               const DataContainer<TransportCompany>* companies);
+
+private:
+    struct CountryTargets {
+        QString capital;
+        QString normalizedCapital;
+        QSet<Symbol> cities;
+        QStringList loweredCities;
+        Hotel* hotel = nullptr;
+    };
+
+    DataContainer<Country>* countries_;
+    DataContainer<Hotel>* hotels_;
+    DataContainer<TransportCompany>* companies_;
+    DataContainer<Tour>* tours_;
+    DataContainer<Order>* orders_;
+    ScheduleIndex scheduleIndex_;
+    FuzzyIndex cityIndex_;
+
+    QString findCountryCapital(const QString& countryName) const;
+    QSet<Symbol> collectTargetCities(const QString& tourCountry, const QString& capital) const;
+    Hotel* findHotelForTour(const QString& tourCountry);
+    bool matchesCity(Symbol arrivalCity, const CountryTargets& targets, const QString& tourCountry) const;
+    bool findTransportForTour(Tour& tour, const CountryTargets& targets, const QDate& tourStartDate);
+};
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef TOURPRICING_H
+#define TOURPRICING_H
+
+#include "models/hotel.h"
+#include "models/money.h"
+#include "models/tour.h"
+#include <QString>
+
+class TourPricing {
+public:
+    static double starMultiplier(int stars);
+    static double countryMultiplier(const QString& country);
+
+    static Money hotelCost(const Hotel& hotel, int roomIndex, int nights);
+    static Money totalCost(const Money& transportCost, const Money& hotelCost, const QString& country);
+    static Money quote(const Tour& tour, int roomIndex = 0);
+};
+
+#endif
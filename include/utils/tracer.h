@@ -0,0 +1,101 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <mutex>
+
+class Tracer {
+public:
+    static constexpr int MaxEvents = 1000000;
+
+    static Tracer& instance();
+
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+    void setEnabled(bool enabled);
+
+    qint64 nowNs() const { return clock_.nsecsElapsed(); }
+
+    void recordZone(const char* name, const char* category, qint64 startNs, qint64 durationNs);
+    void recordCounter(const char* name, qint64 value);
+
+    void clear();
+    int eventCount() const;
+    int droppedCount() const;
+
+    QByteArray toChromeJson() const;
+    bool exportToFile(const QString& filename) const;
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+private:
+    enum class EventType : quint8 {
+        Zone,
+        Counter
+    };
+
+    struct Event {
+        const char* name = nullptr;
+        const char* category = nullptr;
+        qint64 timestampNs = 0;
+        qint64 value = 0;
+        quint32 thread = 0;
+        EventType type = EventType::Zone;
+    };
+
+    Tracer();
+
+    bool append(const Event& event);
+    static quint32 currentThread();
+
+    std::atomic<bool> enabled_{false};
+    QElapsedTimer clock_;
+    mutable std::mutex mutex_;
+    QVector<Event> events_;
+    int dropped_ = 0;
+};
+
+class TraceScope {
+public:
+    explicit TraceScope(const char* name, const char* category = "app")
+        : name_(name)
+        , category_(category)
+        , startNs_(Tracer::instance().isEnabled() ? Tracer::instance().nowNs() : -1) {}
+
+    ~TraceScope() {
+        if (startNs_ >= 0) {
+            Tracer& tracer = Tracer::instance();
+            tracer.recordZone(name_, category_, startNs_, tracer.nowNs() - startNs_);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name_;
+    const char* category_;
+    qint64 startNs_;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#ifdef TOURIST_AGENCY_NO_TRACING
+#define TRACE_SCOPE(name, category) do {} while (false)
+#define TRACE_COUNTER(name, value) do {} while (false)
+#else
+#define TRACE_SCOPE(name, category) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name, category)
+#define TRACE_COUNTER(name, value)                                          \
+    do {                                                                    \
+        if (Tracer::instance().isEnabled()) {                               \
+            Tracer::instance().recordCounter(name, static_cast<qint64>(value)); \
+        }                                                                   \
+    } while (false)
+#endif
+
+#endif
@@ -0,0 +1,124 @@
+#include "containers/columnstore.h"
+#include <algorithm>
+
+qint64 maskedSum(const qint64* values, const quint8* mask, qsizetype count) {
+    qint64 total = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        total += values[i] * static_cast<qint64>(mask[i]);
+    }
+    return total;
+}
+
+void TourColumnStore::rebuild(const DataContainer<Tour>& tours) {
+    clear();
+    int count = tours.size();
+    costs_.reserve(count);
+    startDays_.reserve(count);
+    endDays_.reserve(count);
+    durations_.reserve(count);
+    countryIds_.reserve(count);
+
+    for (const auto& tour : tours.getData()) {
+        costs_.append(tour.calculateCost().kopecks());
+        startDays_.append(tour.getStartDate().toJulianDay());
+        endDays_.append(tour.getEndDate().toJulianDay());
+        durations_.append(tour.getDuration());
+        countryIds_.append(tour.getCountrySymbol().id());
+    }
+}
+
+void TourColumnStore::clear() {
+    ++generation_;
+    costs_.clear();
+    startDays_.clear();
+    endDays_.clear();
+    durations_.clear();
+    countryIds_.clear();
+}
+
+void TourColumnStore::filterCost(qint64 minKopecks, qint64 maxKopecks, RowMask& mask) const {
+    maskRange(costs_.constData(), costs_.size(), minKopecks, maxKopecks, mask.data());
+}
+
+void TourColumnStore::filterDuration(qint32 minDays, qint32 maxDays, RowMask& mask) const {
+    maskRange(durations_.constData(), durations_.size(), minDays, maxDays, mask.data());
+}
+
+void TourColumnStore::filterStartDay(qint64 firstDay, qint64 lastDay, RowMask& mask) const {
+    maskRange(startDays_.constData(), startDays_.size(), firstDay, lastDay, mask.data());
+}
+
+void TourColumnStore::filterCountry(quint32 countryId, RowMask& mask) const {
+    maskEquals(countryIds_.constData(), countryIds_.size(), countryId, mask.data());
+}
+
+QVector<int> TourColumnStore::selectedRows(const RowMask& mask) const {
+    QVector<int> rows;
+    for (int i = 0; i < mask.size(); ++i) {
+        if (mask[i]) {
+            rows.append(i);
+        }
+    }
+    return rows;
+}
+
+void TourColumnStore::sortByCost(QVector<int>& rows) const {
+    const qint64* costs = costs_.constData();
+    std::stable_sort(rows.begin(), rows.end(), [costs](int lhs, int rhs) {
+        return costs[lhs] < costs[rhs];
+    });
+}
+
+qint64 TourColumnStore::totalCost(const RowMask& mask) const {
+    return maskedSum(costs_.constData(), mask.constData(), costs_.size());
+}
+
+bool TourColumnStore::costRange(qint64& minKopecks, qint64& maxKopecks) const {
+    return Money::rangeKopecks(costs_.constData(), costs_.size(), minKopecks, maxKopecks);
+}
+
+void OrderColumnStore::rebuild(const DataContainer<Order>& orders) {
+    clear();
+    int count = orders.size();
+    costs_.reserve(count);
+    orderDays_.reserve(count);
+    statuses_.reserve(count);
+    countryIds_.reserve(count);
+
+    for (const auto& order : orders.getData()) {
+        costs_.append(order.getTotalCost().kopecks());
+        orderDays_.append(order.getOrderDate().date().toJulianDay());
+        statuses_.append(static_cast<quint8>(order.getStatus()));
+        countryIds_.append(order.getTourCountrySymbol().id());
+    }
+}
+
+void OrderColumnStore::clear() {
+    ++generation_;
+    costs_.clear();
+    orderDays_.clear();
+    statuses_.clear();
+    countryIds_.clear();
+}
+
+void OrderColumnStore::filterCost(qint64 minKopecks, qint64 maxKopecks, RowMask& mask) const {
+    maskRange(costs_.constData(), costs_.size(), minKopecks, maxKopecks, mask.data());
+}
+
+void OrderColumnStore::filterOrderDay(qint64 firstDay, qint64 lastDay, RowMask& mask) const {
+    maskRange(orderDays_.constData(), orderDays_.size(), firstDay, lastDay, mask.data());
+}
+
+void OrderColumnStore::filterStatus(OrderStatus status, RowMask& mask) const {
+    maskEquals(statuses_.constData(), statuses_.size(), static_cast<quint8>(status), mask.data());
+}
+
+void OrderColumnStore::filterUnpaid(RowMask& mask) const {
+    maskRange(statuses_.constData(), statuses_.size(),
+              static_cast<quint8>(OrderStatus::Processing),
+              static_cast<quint8>(OrderStatus::Confirmed), mask.data());
+}
+
+qint64 OrderColumnStore::totalCost(const RowMask& mask) const {
+    return maskedSum(costs_.constData(), mask.constData(), costs_.size());
+}
@@ -0,0 +1,91 @@
+#include "containers/facetcounter.h"
+
+void FacetCounter::reset(int rowCount) {
+    facets_.clear();
+    base_ = RowMask(rowCount, 0);
+    misses_ = QVector<quint8>(rowCount, 0);
+    matching_ = 0;
+}
+
+int FacetCounter::addFacet(const QVector<quint32>& values) {
+    if (facets_.size() >= MaxFacets || values.size() != base_.size()) {
+        return -1;
+    }
+
+    Facet facet;
+    facet.values = values;
+    facets_.append(facet);
+
+    int index = facets_.size() - 1;
+    for (int row = 0; row < base_.size(); ++row) {
+        if (base_[row] && misses_[row] == 0) {
+            ++facets_[index].counts[values[row]];
+        }
+    }
+    return index;
+}
+
+void FacetCounter::applyRow(int row, quint8 misses, int delta) {
+    for (int f = 0; f < facets_.size(); ++f) {
+        quint8 others = misses & static_cast<quint8>(~(1u << f));
+        if (others == 0) {
+            facets_[f].counts[facets_[f].values[row]] += delta;
+        }
+    }
+    if (misses == 0) {
+        matching_ += delta;
+    }
+}
+
+void FacetCounter::setBaseMask(const RowMask& mask) {
+    for (int row = 0; row < base_.size(); ++row) {
+        quint8 next = row < mask.size() && mask[row] ? 1 : 0;
+        if (next == base_[row]) {
+            continue;
+        }
+        applyRow(row, misses_[row], next ? 1 : -1);
+        base_[row] = next;
+    }
+}
+
+void FacetCounter::select(int facet, const QSet<quint32>& values) {
+    Facet& target = facets_[facet];
+    if (target.selected == values) {
+        return;
+    }
+    target.selected = values;
+
+    quint8 bit = static_cast<quint8>(1u << facet);
+    for (int row = 0; row < base_.size(); ++row) {
+        bool miss = !values.isEmpty() && !values.contains(target.values[row]);
+        quint8 next = miss ? (misses_[row] | bit) : (misses_[row] & static_cast<quint8>(~bit));
+        if (next == misses_[row]) {
+            continue;
+        }
+        if (base_[row]) {
+            applyRow(row, misses_[row], -1);
+            applyRow(row, next, 1);
+        }
+        misses_[row] = next;
+    }
+}
+
+int FacetCounter::count(int facet, quint32 value) const {
+    return facets_[facet].counts.value(value, 0);
+}
+
+int FacetCounter::total(int facet) const {
+    int sum = 0;
+    for (int value : facets_[facet].counts) {
+        sum += value;
+    }
+    return sum;
+}
+
+RowMask FacetCounter::matchingMask() const {
+    RowMask mask(base_.size(), 0);
+    for (int row = 0; row < base_.size(); ++row) {
+        mask[row] = static_cast<quint8>(base_[row] & (misses_[row] == 0));
+    }
+    return mask;
+}
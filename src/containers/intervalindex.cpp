@@ -0,0 +1,83 @@
+#include "containers/intervalindex.h"
+#include <algorithm>
+#include <limits>
+
+void IntervalIndex::build(QVector<Interval> intervals) {
+    std::sort(intervals.begin(), intervals.end(), [](const Interval& lhs, const Interval& rhs) {
+        return lhs.start < rhs.start || (lhs.start == rhs.start && lhs.id < rhs.id);
+    });
+    intervals_ = std::move(intervals);
+    maxEnd_ = QVector<qint64>(intervals_.size(), 0);
+    buildMaxEnd(0, intervals_.size());
+}
+
+void IntervalIndex::clear() {
+    intervals_.clear();
+    maxEnd_.clear();
+}
+
+qint64 IntervalIndex::buildMaxEnd(int low, int high) {
+    if (low >= high) {
+        return std::numeric_limits<qint64>::min();
+    }
+    int mid = low + (high - low) / 2;
+    qint64 result = std::max({intervals_[mid].end, buildMaxEnd(low, mid), buildMaxEnd(mid + 1, high)});
+    maxEnd_[mid] = result;
+    return result;
+}
+
+void IntervalIndex::collect(int low, int high, qint64 startMax, qint64 endMin, QVector<int>& result) const {
+    if (low >= high) {
+        return;
+    }
+    int mid = low + (high - low) / 2;
+    if (maxEnd_[mid] < endMin) {
+        return;
+    }
+
+    collect(low, mid, startMax, endMin, result);
+
+    const Interval& interval = intervals_[mid];
+    if (interval.start > startMax) {
+        return;
+    }
+    if (interval.end >= endMin) {
+        result.append(interval.id);
+    }
+
+    collect(mid + 1, high, startMax, endMin, result);
+}
+
+QVector<int> IntervalIndex::overlapping(qint64 first, qint64 last) const {
+    QVector<int> result;
+    collect(0, intervals_.size(), last, first, result);
+    return result;
+}
+
+QVector<int> IntervalIndex::containing(qint64 first, qint64 last) const {
+    QVector<int> result;
+    collect(0, intervals_.size(), first, last, result);
+    return result;
+}
+
+QVector<int> IntervalIndex::within(qint64 first, qint64 last) const {
+    QVector<int> result;
+    auto begin = std::lower_bound(intervals_.cbegin(), intervals_.cend(), first,
+        [](const Interval& interval, qint64 value) { return interval.start < value; });
+    for (auto it = begin; it != intervals_.cend() && it->start <= last; ++it) {
+        if (it->end <= last) {
+            result.append(it->id);
+        }
+    }
+    return result;
+}
+
+QVector<int> IntervalIndex::startingIn(qint64 first, qint64 last) const {
+    QVector<int> result;
+    auto begin = std::lower_bound(intervals_.cbegin(), intervals_.cend(), first,
+        [](const Interval& interval, qint64 value) { return interval.start < value; });
+    for (auto it = begin; it != intervals_.cend() && it->start <= last; ++it) {
+        result.append(it->id);
+    }
+    return result;
+}
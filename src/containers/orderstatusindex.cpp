@@ -0,0 +1,60 @@
+#include "containers/orderstatusindex.h"
+
+void OrderStatusIndex::rebuild(const DataContainer<Order>& orders) {
+    clear();
+    statusById_.reserve(orders.size());
+    for (const auto& order : orders.getData()) {
+        insert(order.getId(), order.getStatus());
+    }
+}
+
+void OrderStatusIndex::clear() {
+    for (auto& ids : idsByStatus_) {
+        ids.clear();
+    }
+    statusById_.clear();
+}
+
+void OrderStatusIndex::insert(int orderId, OrderStatus status) {
+    auto it = statusById_.find(orderId);
+    if (it != statusById_.end()) {
+        idsByStatus_[index(it.value())].remove(orderId);
+        it.value() = status;
+    } else {
+        statusById_.insert(orderId, status);
+    }
+    idsByStatus_[index(status)].insert(orderId);
+}
+
+void OrderStatusIndex::remove(int orderId) {
+    auto it = statusById_.find(orderId);
+    if (it == statusById_.end()) {
+        return;
+    }
+    idsByStatus_[index(it.value())].remove(orderId);
+    statusById_.erase(it);
+}
+
+void OrderStatusIndex::update(int orderId, OrderStatus status) {
+    insert(orderId, status);
+}
+
+int OrderStatusIndex::unpaidCount() const {
+    int total = 0;
+    for (OrderStatus status : OrderStatusInfo::all()) {
+        if (OrderStatusInfo::isUnpaid(status)) {
+            total += count(status);
+        }
+    }
+    return total;
+}
+
+QSet<int> OrderStatusIndex::unpaidIds() const {
+    QSet<int> result;
+    for (OrderStatus status : OrderStatusInfo::all()) {
+        if (OrderStatusInfo::isUnpaid(status)) {
+            result.unite(ids(status));
+        }
+    }
+    return result;
+}
@@ -0,0 +1,78 @@
+#include "containers/scheduleindex.h"
+
+void ScheduleIndex::rebuild(const DataContainer<TransportCompany>& companies) {
+    clear();
+
+    QVector<IntervalIndex::Interval> intervals;
+    byCompany_.resize(companies.size());
+
+    int companyIndex = 0;
+    for (const auto& company : companies.getData()) {
+        QVector<IntervalIndex::Interval> companyIntervals;
+        const QVector<TransportSchedule> schedules = company.getSchedules();
+
+        for (int i = 0; i < schedules.size(); ++i) {
+            const TransportSchedule& schedule = schedules[i];
+            int id = refs_.size();
+            refs_.append(ScheduleRef{companyIndex, i});
+
+            if (!schedule.departureDate.isValid()) {
+                undated_.append(id);
+                continue;
+            }
+
+            QDate arrival = schedule.arrivalDate.isValid() && schedule.arrivalDate >= schedule.departureDate
+                ? schedule.arrivalDate : schedule.departureDate;
+            IntervalIndex::Interval interval{IntervalIndex::dayOf(schedule.departureDate),
+                                             IntervalIndex::dayOf(arrival), id};
+            intervals.append(interval);
+            companyIntervals.append(interval);
+        }
+
+        byCompany_[companyIndex].build(companyIntervals);
+        ++companyIndex;
+    }
+
+    all_.build(intervals);
+}
+
+void ScheduleIndex::clear() {
+    refs_.clear();
+    undated_.clear();
+    all_.clear();
+    byCompany_.clear();
+}
+
+QVector<ScheduleRef> ScheduleIndex::resolve(const QVector<int>& ids) const {
+    QVector<ScheduleRef> result;
+    result.reserve(ids.size());
+    for (int id : ids) {
+        result.append(refs_[id]);
+    }
+    return result;
+}
+
+QVector<ScheduleRef> ScheduleIndex::overlapping(const QDate& first, const QDate& last) const {
+    return resolve(all_.overlapping(IntervalIndex::dayOf(first), IntervalIndex::dayOf(last)));
+}
+
+QVector<ScheduleRef> ScheduleIndex::containing(const QDate& first, const QDate& last) const {
+    return resolve(all_.containing(IntervalIndex::dayOf(first), IntervalIndex::dayOf(last)));
+}
+
+QVector<ScheduleRef> ScheduleIndex::departingBefore(const QDate& date, int days) const {
+    qint64 day = IntervalIndex::dayOf(date);
+    return resolve(all_.startingIn(day - days, day));
+}
+
+QVector<ScheduleRef> ScheduleIndex::departingBefore(int companyIndex, const QDate& date, int days) const {
+    if (companyIndex < 0 || companyIndex >= byCompany_.size()) {
+        return {};
+    }
+    qint64 day = IntervalIndex::dayOf(date);
+    return resolve(byCompany_[companyIndex].startingIn(day - days, day));
+}
+
+QVector<ScheduleRef> ScheduleIndex::undated() const {
+    return resolve(undated_);
+}
@@ -0,0 +1,192 @@
+#include "containers/toursearchindex.h"
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+template<typename T>
+QVector<int> sortedOrder(const QVector<T>& values) {
+    QVector<int> order(values.size());
+    std::iota(order.begin(), order.end(), 0);
+    const T* data = values.constData();
+    std::sort(order.begin(), order.end(), [data](int lhs, int rhs) {
+        return data[lhs] < data[rhs] || (data[lhs] == data[rhs] && lhs < rhs);
+    });
+    return order;
+}
+
+}
+
+void TourSearchIndex::rebuild(const TourColumnStore& columns) {
+    columns_ = &columns;
+    generation_ = columns.generation();
+    byCost_ = sortedOrder(columns.costs());
+    byDuration_ = sortedOrder(columns.durations());
+    byStartDay_ = sortedOrder(columns.startDays());
+
+    QVector<IntervalIndex::Interval> intervals;
+    intervals.reserve(columns.size());
+    for (int row = 0; row < columns.size(); ++row) {
+        intervals.append(IntervalIndex::Interval{columns.startDays()[row], columns.endDays()[row], row});
+    }
+    dates_.build(intervals);
+    valid_ = true;
+}
+
+void TourSearchIndex::invalidate() {
+    valid_ = false;
+    byCost_.clear();
+    byDuration_.clear();
+    byStartDay_.clear();
+    dates_.clear();
+}
+
+bool TourSearchIndex::isValidFor(const TourColumnStore& columns) const {
+    return valid_ && columns_ == &columns && generation_ == columns.generation();
+}
+
+template<typename T>
+TourSearchIndex::Slice TourSearchIndex::rangeSlice(const QVector<int>& order, const QVector<T>& values,
+                                                   T low, T high) {
+    const T* data = values.constData();
+    Slice slice;
+    slice.begin = std::lower_bound(order.constBegin(), order.constEnd(), low,
+        [data](int row, T value) { return data[row] < value; });
+    slice.end = std::upper_bound(slice.begin, order.constEnd(), high,
+        [data](T value, int row) { return value < data[row]; });
+    return slice;
+}
+
+TourSearchIndex::Slice TourSearchIndex::driverSlice(const TourQuery& query, bool& sortedByCost) const {
+    Slice cost = rangeSlice(byCost_, columns_->costs(), query.minCost, query.maxCost);
+    Slice duration = rangeSlice(byDuration_, columns_->durations(), query.minDuration, query.maxDuration);
+    Slice start = rangeSlice(byStartDay_, columns_->startDays(), query.firstStartDay, query.lastStartDay);
+
+    sortedByCost = true;
+    Slice best = cost;
+    if (duration.size() < best.size()) {
+        best = duration;
+        sortedByCost = false;
+    }
+    if (start.size() < best.size()) {
+        best = start;
+        sortedByCost = false;
+    }
+    return best;
+}
+
+QVector<int> TourSearchIndex::dateCandidates(const TourQuery& query) const {
+    if (query.dateMatch == TourQuery::DateMatch::Overlaps) {
+        return dates_.overlapping(query.firstDay, query.lastDay);
+    }
+    return dates_.within(query.firstDay, query.lastDay);
+}
+
+bool TourSearchIndex::matches(int row, const TourQuery& query) const {
+    qint64 cost = columns_->costs()[row];
+    qint32 duration = columns_->durations()[row];
+    qint64 startDay = columns_->startDays()[row];
+
+    if (cost < query.minCost || cost > query.maxCost) {
+        return false;
+    }
+    if (duration < query.minDuration || duration > query.maxDuration) {
+        return false;
+    }
+    if (startDay < query.firstStartDay || startDay > query.lastStartDay) {
+        return false;
+    }
+    if (query.dateMatch != TourQuery::DateMatch::Any) {
+        qint64 endDay = columns_->endDays()[row];
+        bool inRange = query.dateMatch == TourQuery::DateMatch::Overlaps
+            ? startDay <= query.lastDay && endDay >= query.firstDay
+            : startDay >= query.firstDay && endDay <= query.lastDay;
+        if (!inRange) {
+            return false;
+        }
+    }
+    if (query.filterCountries) {
+        bool listed = query.countryIds.contains(columns_->countryIds()[row]);
+        if (listed == query.excludeCountries) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TourSearchIndex::sortTopK(QVector<int>& rows, int limit) const {
+    const qint64* costs = columns_->costs().constData();
+    auto byCost = [costs](int lhs, int rhs) {
+        return costs[lhs] < costs[rhs] || (costs[lhs] == costs[rhs] && lhs < rhs);
+    };
+
+    if (limit > 0 && limit < rows.size()) {
+        std::partial_sort(rows.begin(), rows.begin() + limit, rows.end(), byCost);
+        rows.resize(limit);
+    } else {
+        std::sort(rows.begin(), rows.end(), byCost);
+    }
+}
+
+QVector<int> TourSearchIndex::query(const TourQuery& query) const {
+    QVector<int> rows;
+    if (!valid_ || !columns_) {
+        return rows;
+    }
+
+    bool sortedByCost = false;
+    Slice driver = driverSlice(query, sortedByCost);
+    if (query.filterCountries && !query.excludeCountries && query.countryIds.isEmpty()) {
+        return rows;
+    }
+
+    QVector<int> dateHits;
+    if (query.dateMatch != TourQuery::DateMatch::Any) {
+        dateHits = dateCandidates(query);
+        if (dateHits.size() < driver.size()) {
+            driver.begin = dateHits.constData();
+            driver.end = dateHits.constData() + dateHits.size();
+            sortedByCost = false;
+        }
+    }
+
+    rows.reserve(query.limit > 0 ? std::min(query.limit, driver.size()) : driver.size());
+    for (const int* it = driver.begin; it != driver.end; ++it) {
+        if (!matches(*it, query)) {
+            continue;
+        }
+        rows.append(*it);
+        if (sortedByCost && query.limit > 0 && rows.size() == query.limit) {
+            break;
+        }
+    }
+
+    if (!sortedByCost) {
+        sortTopK(rows, query.limit);
+    }
+    return rows;
+}
+
+int TourSearchIndex::count(const TourQuery& query) const {
+    if (!valid_ || !columns_) {
+        return 0;
+    }
+
+    bool sortedByCost = false;
+    Slice driver = driverSlice(query, sortedByCost);
+
+    QVector<int> dateHits;
+    if (query.dateMatch != TourQuery::DateMatch::Any) {
+        dateHits = dateCandidates(query);
+        if (dateHits.size() < driver.size()) {
+            driver.begin = dateHits.constData();
+            driver.end = dateHits.constData() + dateHits.size();
+        }
+    }
+
+    int total = 0;
+    for (const int* it = driver.begin; it != driver.end; ++it) {
+        total += matches(*it, query) ? 1 : 0;
+    }
+    return total;
+}
@@ -1,6 +1,8 @@
 #include "dialogs/booktourcostcalculator.h"
+#include "utils/tourpricing.h"
 #include <QComboBox>
 #include <QDateEdit>
+#include <QVariant>
 
 BookTourCostCalculator::BookTourCostCalculator(DataContainer<Hotel>* hotels,
                                               DataContainer<TransportCompany>* companies,
@@ -18,33 +20,34 @@ int BookTourCostCalculator::calculateNights() const {
     return uiElements_.startDateEdit->date().daysTo(uiElements_.endDateEdit->date());
 }
 
-double BookTourCostCalculator::calculateTransportCost() const {
+Money BookTourCostCalculator::calculateTransportCost() const {
     if (!companies_ || uiElements_.transportCombo->currentIndex() < 0 || 
         uiElements_.scheduleCombo->currentIndex() < 0) {
-        return 0.0;
+        return Money();
     }
     
     TransportCompany* company = companies_->get(uiElements_.transportCombo->currentIndex());
-    if (!company || uiElements_.scheduleCombo->currentIndex() >= company->getScheduleCount()) {
-        return 0.0;
+    QVariant scheduleData = uiElements_.scheduleCombo->currentData();
+    if (!company || !scheduleData.isValid()) {
+        return Money();
     }
     
-    TransportSchedule* schedule = company->getSchedule(uiElements_.scheduleCombo->currentIndex());
-    return schedule ? schedule->price : 0.0;
+    TransportSchedule* schedule = company->getSchedule(scheduleData.toInt());
+    return schedule ? schedule->price : Money();
 }
 
-double BookTourCostCalculator::calculateHotelCost() const {
+Money BookTourCostCalculator::calculateHotelCost() const {
     int nights = calculateNights();
     if (!hotels_ || uiElements_.hotelCombo->currentIndex() < 0 || 
         uiElements_.roomCombo->currentIndex() < 0 || nights <= 0) {
-        return 0.0;
+        return Money();
     }
     
-    QString selectedCountry = uiElements_.countryCombo->currentText();
+    Symbol selectedCountry(uiElements_.countryCombo->currentText());
     int hotelIndex = 0;
     
     for (const auto& hotel : hotels_->getData()) {
-        if (hotel.getCountry() != selectedCountry) {
+        if (hotel.getCountrySymbol() != selectedCountry) {
             continue;
         }
         
@@ -53,55 +56,23 @@ double BookTourCostCalculator::calculateHotelCost() const {
             continue;
         }
         
-        double starMultiplier = getStarMultiplier(hotel.getStars());
-        
-        if (uiElements_.roomCombo->currentIndex() >= hotel.getRoomCount()) {
-            break;
-        }
-        
-        const Room* room = hotel.getRoom(uiElements_.roomCombo->currentIndex());
-        if (!room) {
-            break;
-        }
-        
-        double basePrice = room->getPricePerNight();
-        return basePrice * starMultiplier * nights;
+        return TourPricing::hotelCost(hotel, uiElements_.roomCombo->currentIndex(), nights);
     }
     
-    return 0.0;
+    return Money();
 }
 
 double BookTourCostCalculator::getStarMultiplier(int stars) const {
-    switch (stars) {
-        case 5: return 1.5;
-        case 4: return 1.2;
-        case 3: return 1.0;
-        case 2: return 0.8;
-        case 1: return 0.6;
-        default: return 1.0;
-    }
+    return TourPricing::starMultiplier(stars);
 }
 
 double BookTourCostCalculator::getCountryMultiplier(const QString& country) const {
-    if (country.contains("Франция") || country.contains("Италия") || 
-        country.contains("Испания")) {
-        return 1.1;
-    }
-    if (country.contains("Египет") || country.contains("Турция")) {
-        return 0.9;
-    }
-    return 1.0;
+    return TourPricing::countryMultiplier(country);
 }
 
-double BookTourCostCalculator::calculateTotalCost() const {
-    double transportCost = calculateTransportCost();
-    double hotelCost = calculateHotelCost();
-    double baseTotal = transportCost + hotelCost;
-    
-    QString country = uiElements_.countryCombo->currentText();
-    double countryMultiplier = getCountryMultiplier(country);
-    
-    return baseTotal * countryMultiplier;
+Money BookTourCostCalculator::calculateTotalCost() const {
+    return TourPricing::totalCost(calculateTransportCost(), calculateHotelCost(),
+                                  uiElements_.countryCombo->currentText());
 }
 
 
@@ -2,6 +2,7 @@
 #include "ui_booktourdialog.h"
 #include "dialogs/booktourcostcalculator.h"
 #include "dialogs/toursetuphelper.h"
+#include "utils/tracer.h"
 #include <QMessageBox>
 #include <QDate>
 #include <QSet>
@@ -38,6 +39,11 @@ BookTourDialog::BookTourDialog(QWidget *parent,
     
     updateToursCombo();
     
+    if (companies_) {
+        routePlanner_.rebuild(*companies_);
+    }
+    updateOriginCombo();
+    
     ui->startDateEdit->setDate(QDate::currentDate());
     ui->endDateEdit->setDate(QDate::currentDate().addDays(7));
     
@@ -59,7 +65,10 @@ BookTourDialog::BookTourDialog(QWidget *parent,
             ui->endDateEdit->setDate(ui->startDateEdit->date().addDays(1));
         }
         onDatesChanged();
+        updateRoute();
     });
+    connect(ui->originCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &BookTourDialog::updateRoute);
     connect(ui->endDateEdit, &QDateEdit::dateChanged, this, &BookTourDialog::onDatesChanged);
     
     connect(ui->tourCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
@@ -82,9 +91,56 @@ void BookTourDialog::onCountryChanged() {
     if (ui->transportCombo->currentIndex() >= 0) {
         onTransportChanged();
     }
+    updateRoute();
     calculateCost();
 }
 
+void BookTourDialog::updateOriginCombo() {
+    ui->originCombo->blockSignals(true);
+    ui->originCombo->clear();
+    for (Symbol city : routePlanner_.departureCities()) {
+        ui->originCombo->addItem(city.toString(), city.id());
+    }
+    int homeIndex = ui->originCombo->findText(QString::fromUtf8(DefaultOriginCity));
+    if (homeIndex >= 0) {
+        ui->originCombo->setCurrentIndex(homeIndex);
+    }
+    ui->originCombo->blockSignals(false);
+}
+
+void BookTourDialog::updateRoute() {
+    TRACE_SCOPE("BookTourDialog::updateRoute", "dialog");
+    if (ui->originCombo->currentIndex() < 0 || ui->countryCombo->currentIndex() < 0) {
+        ui->routeLabel->clear();
+        return;
+    }
+    
+    QString selectedCountry = ui->countryCombo->currentText();
+    RouteRequest request;
+    request.origin = Symbol::fromId(ui->originCombo->currentData().toUInt());
+    request.destinations = collectCitiesInCountry(selectedCountry);
+    QString capital = findCountryCapital(selectedCountry);
+    if (!capital.isEmpty()) {
+        request.destinations.insert(Symbol(capital));
+    }
+    request.latestArrival = ui->startDateEdit->date();
+    request.earliestDeparture = request.latestArrival.addDays(-TourSetupHelper::ScheduleWindowDays);
+    request.maxTransfers = MaxRouteTransfers;
+    
+    Route route = routePlanner_.findRoute(request);
+    if (route.isEmpty()) {
+        ui->routeLabel->setText("Маршрут не найден");
+        return;
+    }
+    
+    ui->routeLabel->setText(QString("%1, пересадок: %2, %3 – %4, %5")
+        .arg(route.toString())
+        .arg(route.transfers())
+        .arg(route.departure().toString("dd.MM"))
+        .arg(route.arrival().toString("dd.MM"))
+        .arg(route.totalPrice.toDisplayString()));
+}
+
 QString BookTourDialog::findCountryCapital(const QString& selectedCountry) const {
     if (!countries_) {
         return "";
@@ -98,15 +154,16 @@ QString BookTourDialog::findCountryCapital(const QString& selectedCountry) const
     return "";
 }
 
-QSet<QString> BookTourDialog::collectCitiesInCountry(const QString& selectedCountry) const {
-    QSet<QString> cities;
+QSet<Symbol> BookTourDialog::collectCitiesInCountry(const QString& selectedCountry) const {
+    QSet<Symbol> cities;
     
     if (!hotels_) {
         return cities;
     }
     
+    Symbol countrySymbol(selectedCountry);
     for (const auto& hotel : hotels_->getData()) {
-        if (hotel.getCountry() != selectedCountry) {
+        if (hotel.getCountrySymbol() != countrySymbol) {
             continue;
         }
         
@@ -117,9 +174,9 @@ QSet<QString> BookTourDialog::collectCitiesInCountry(const QString& selectedCoun
         
         QString city = address.split(',').first().trimmed();
         if (!city.isEmpty()) {
-            cities.insert(city);
+            cities.insert(Symbol(city));
         }
-        cities.insert(address);
+        cities.insert(Symbol(address));
     }
     
     return cities;
@@ -145,12 +202,14 @@ TransportCompany* BookTourDialog::findSelectedTransportCompany() const {
     return nullptr;
 }
 
-void BookTourDialog::populateScheduleCombo(TransportCompany* company, const QSet<QString>& citiesInCountry, const QString& capital) const {
+void BookTourDialog::populateScheduleCombo(TransportCompany* company, const QSet<Symbol>& citiesInCountry, const QString& capital) const {
+    TRACE_SCOPE("BookTourDialog::populateScheduleCombo", "dialog");
     if (!company) {
         return;
     }
     
-    for (int i = 0; i < company->getScheduleCount(); ++i) {
+    QVector<int> order = tourSetupHelper_->orderSchedulesForStart(company, ui->startDateEdit->date());
+    for (int i : order) {
         TransportSchedule* schedule = company->getSchedule(i);
         if (!schedule) {
             continue;
@@ -158,9 +217,7 @@ void BookTourDialog::populateScheduleCombo(TransportCompany* company, const QSet
         
         bool shouldInclude = true;
         if (!citiesInCountry.isEmpty()) {
-            QString arrivalCity = schedule->arrivalCity;
-            shouldInclude = citiesInCountry.contains(arrivalCity) || 
-                           (!capital.isEmpty() && arrivalCity.contains(capital, Qt::CaseInsensitive));
+            shouldInclude = tourSetupHelper_->arrivesIn(schedule->arrivalCity, citiesInCountry, capital);
         }
         
         if (!shouldInclude) {
@@ -168,10 +225,10 @@ void BookTourDialog::populateScheduleCombo(TransportCompany* company, const QSet
         }
         
         QString scheduleInfo = QString("%1 → %2, %3, %4 руб")
-            .arg(schedule->departureCity)
-            .arg(schedule->arrivalCity)
+            .arg(schedule->departureCity.toString())
+            .arg(schedule->arrivalCity.toString())
             .arg(schedule->departureDate.toString("dd.MM.yyyy"))
-            .arg(schedule->price, 0, 'f', 2);
+            .arg(schedule->price.toString());
         ui->scheduleCombo->addItem(scheduleInfo, i);
     }
 }
@@ -184,7 +241,7 @@ void BookTourDialog::onTransportChanged() {
         return;
     }
     
-    QSet<QString> citiesInCountry;
+    QSet<Symbol> citiesInCountry;
     QString capital = "";
     
     if (countries_ && ui->countryCombo->currentIndex() >= 0) {
@@ -193,7 +250,7 @@ void BookTourDialog::onTransportChanged() {
         citiesInCountry = collectCitiesInCountry(selectedCountry);
         
         if (!capital.isEmpty()) {
-            citiesInCountry.insert(capital);
+            citiesInCountry.insert(Symbol(capital));
         }
     }
     
@@ -213,6 +270,7 @@ void BookTourDialog::onDatesChanged() {
 }
 
 void BookTourDialog::updateToursCombo() {
+    TRACE_SCOPE("BookTourDialog::updateToursCombo", "dialog");
     ui->tourCombo->clear();
     
     if (!tours_) return;
@@ -223,7 +281,7 @@ void BookTourDialog::updateToursCombo() {
             .arg(tour.getCountry())
             .arg(tour.getStartDate().toString("dd.MM.yyyy"))
             .arg(tour.getEndDate().toString("dd.MM.yyyy"))
-            .arg(tour.calculateCost(), 0, 'f', 2);
+            .arg(tour.calculateCost().toString());
         ui->tourCombo->addItem(tourInfo);
     }
 }
@@ -241,6 +299,7 @@ void BookTourDialog::updateUIForMode() {
 }
 
 void BookTourDialog::updateTransportCombo() {
+    TRACE_SCOPE("BookTourDialog::updateTransportCombo", "dialog");
     ui->transportCombo->clear();
     ui->scheduleCombo->clear();
     
@@ -257,19 +316,17 @@ void BookTourDialog::updateTransportCombo() {
     
     QString selectedCountry = ui->countryCombo->currentText();
     QString capital = findCountryCapital(selectedCountry);
-    QSet<QString> citiesInCountry = collectCitiesInCountry(selectedCountry);
+    QSet<Symbol> citiesInCountry = collectCitiesInCountry(selectedCountry);
     
     if (!capital.isEmpty()) {
-        citiesInCountry.insert(capital);
+        citiesInCountry.insert(Symbol(capital));
     }
     
     for (const auto& company : companies_->getData()) {
         if (company.getScheduleCount() > 0) {
             bool hasRelevantSchedule = false;
             for (const auto& schedule : company.getSchedules()) {
-                QString arrivalCity = schedule.arrivalCity;
-                if (citiesInCountry.contains(arrivalCity) || 
-                    (!capital.isEmpty() && arrivalCity.contains(capital, Qt::CaseInsensitive))) {
+                if (tourSetupHelper_->arrivesIn(schedule.arrivalCity, citiesInCountry, capital)) {
                     hasRelevantSchedule = true;
                     break;
                 }
@@ -283,14 +340,15 @@ void BookTourDialog::updateTransportCombo() {
 }
 
 void BookTourDialog::updateHotelsCombo() {
+    TRACE_SCOPE("BookTourDialog::updateHotelsCombo", "dialog");
     ui->hotelCombo->clear();
     ui->roomCombo->clear();
     
     if (!hotels_ || ui->countryCombo->currentIndex() < 0) return;
     
-    QString selectedCountry = ui->countryCombo->currentText();
+    Symbol selectedCountry(ui->countryCombo->currentText());
     for (const auto& hotel : hotels_->getData()) {
-        if (hotel.getCountry() == selectedCountry) {
+        if (hotel.getCountrySymbol() == selectedCountry) {
             QString hotelInfo = QString("%1 (%2 звезд)")
                 .arg(hotel.getName())
                 .arg(hotel.getStars());
@@ -300,14 +358,15 @@ void BookTourDialog::updateHotelsCombo() {
 }
 
 void BookTourDialog::updateRoomsCombo() {
+    TRACE_SCOPE("BookTourDialog::updateRoomsCombo", "dialog");
     ui->roomCombo->clear();
     
     if (!hotels_ || ui->hotelCombo->currentIndex() < 0) return;
     
-    QString selectedCountry = ui->countryCombo->currentText();
+    Symbol selectedCountry(ui->countryCombo->currentText());
     int hotelIndex = 0;
     for (const auto& hotel : hotels_->getData()) {
-        if (hotel.getCountry() == selectedCountry) {
+        if (hotel.getCountrySymbol() == selectedCountry) {
             if (hotelIndex == ui->hotelCombo->currentIndex()) {
                 for (int i = 0; i < hotel.getRoomCount(); ++i) {
                     const Room* room = hotel.getRoom(i);
@@ -315,7 +374,7 @@ void BookTourDialog::updateRoomsCombo() {
                         QString roomInfo = QString("%1 (%2, %3 руб/ночь)")
                             .arg(room->getName())
                             .arg(Room::roomTypeToString(room->getRoomType()))
-                            .arg(room->getPricePerNight(), 0, 'f', 2);
+                            .arg(room->getPricePerNight().toString());
                         ui->roomCombo->addItem(roomInfo, i);
                     }
                 }
@@ -328,6 +387,7 @@ void BookTourDialog::updateRoomsCombo() {
 
 
 void BookTourDialog::calculateCost() {
+    TRACE_SCOPE("BookTourDialog::calculateCost", "dialog");
     if (ui->selectTourRadio->isChecked()) {
         calculateCostForSelectMode();
     } else {
@@ -336,7 +396,7 @@ void BookTourDialog::calculateCost() {
 }
 
 void BookTourDialog::calculateCostForSelectMode() {
-    double totalCost = 0.0;
+    Money totalCost;
     
     if (tours_ && ui->tourCombo->currentIndex() >= 0) {
         Tour* tour = tours_->get(ui->tourCombo->currentIndex());
@@ -345,32 +405,32 @@ void BookTourDialog::calculateCostForSelectMode() {
         }
     }
     
-    QString costText = totalCost > 0 
+    QString costText = totalCost.isPositive() 
         ? QString("<b style='font-size: 14pt; color: #2196F3;'>%1 руб</b>")
-            .arg(totalCost, 0, 'f', 2)
+            .arg(totalCost.toString())
         : "<span style='color: #999;'>0.00 руб</span>";
     
     ui->costValueLabelSelect->setText(costText);
 }
 
 void BookTourDialog::calculateCostForCreateMode() {
-    double totalCost = costCalculator_->calculateTotalCost();
-    double transportCost = costCalculator_->calculateTransportCost();
-    double hotelCost = costCalculator_->calculateHotelCost();
+    Money totalCost = costCalculator_->calculateTotalCost();
+    Money transportCost = costCalculator_->calculateTransportCost();
+    Money hotelCost = costCalculator_->calculateHotelCost();
     
     QString costText = QString("<b style='font-size: 14pt; color: #2196F3;'>%1 руб</b>")
-        .arg(totalCost, 0, 'f', 2);
+        .arg(totalCost.toString());
     
-    if (transportCost > 0 || hotelCost > 0) {
+    if (transportCost.isPositive() || hotelCost.isPositive()) {
         costText += QString("<br><span style='font-size: 10pt; color: #666;'>");
-        if (transportCost > 0) {
+        if (transportCost.isPositive()) {
             costText += QString("Транспорт: %1 руб<br>")
-                .arg(transportCost, 0, 'f', 2);
+                .arg(transportCost.toString());
         }
-        if (hotelCost > 0) {
+        if (hotelCost.isPositive()) {
             int nights = costCalculator_->calculateNights();
             costText += QString("Отель (%1 ночей, с учетом звезд): %2 руб<br>")
-                .arg(nights).arg(hotelCost, 0, 'f', 2);
+                .arg(nights).arg(hotelCost.toString());
         }
         
         QString country = ui->countryCombo->currentText();
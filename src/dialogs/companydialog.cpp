@@ -95,14 +95,14 @@ void CompanyDialog::updateSchedulesTable() {
     
     int row = 0;
     for (const auto& schedule : schedules_) {
-        ui->schedulesTable->setItem(row, 0, new QTableWidgetItem(schedule.departureCity));
-        ui->schedulesTable->setItem(row, 1, new QTableWidgetItem(schedule.arrivalCity));
+        ui->schedulesTable->setItem(row, 0, new QTableWidgetItem(schedule.departureCity.toString()));
+        ui->schedulesTable->setItem(row, 1, new QTableWidgetItem(schedule.arrivalCity.toString()));
         ui->schedulesTable->setItem(row, 2, 
             new QTableWidgetItem(schedule.departureDate.toString("yyyy-MM-dd")));
         ui->schedulesTable->setItem(row, 3, 
             new QTableWidgetItem(schedule.arrivalDate.toString("yyyy-MM-dd")));
         ui->schedulesTable->setItem(row, 4, 
-            new QTableWidgetItem(QString::number(schedule.price, 'f', 2)));
+            new QTableWidgetItem(schedule.price.toString()));
         ui->schedulesTable->setItem(row, 5, 
             new QTableWidgetItem(QString::number(schedule.availableSeats)));
         ++row;
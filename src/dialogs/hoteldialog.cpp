@@ -110,7 +110,7 @@ void HotelDialog::updateRoomsTable() {
         ui->roomsTable->setItem(row, 1, 
             new QTableWidgetItem(Room::roomTypeToString(room.getRoomType())));
         ui->roomsTable->setItem(row, 2, 
-            new QTableWidgetItem(QString::number(room.getPricePerNight(), 'f', 2)));
+            new QTableWidgetItem(room.getPricePerNight().toString()));
         ui->roomsTable->setItem(row, 3, 
             new QTableWidgetItem(QString::number(room.getCapacity())));
         ++row;
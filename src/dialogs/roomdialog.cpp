@@ -14,7 +14,7 @@ RoomDialog::RoomDialog(QWidget *parent, Room* room)
     if (room_) {
         ui->nameEdit->setText(room_->getName());
         ui->typeCombo->setCurrentText(Room::roomTypeToString(room_->getRoomType()));
-        ui->priceSpin->setValue(room_->getPricePerNight());
+        ui->priceSpin->setValue(room_->getPricePerNight().toDouble());
         ui->capacitySpin->setValue(room_->getCapacity());
     }
     
@@ -28,7 +28,7 @@ Room RoomDialog::getRoom() const {
     Room room(
         ui->nameEdit->text(),
         Room::stringToRoomType(ui->typeCombo->currentText()),
-        ui->priceSpin->value(),
+        Money::fromDouble(ui->priceSpin->value()),
         ui->capacitySpin->value()
     );
     return room;
@@ -14,11 +14,11 @@ ScheduleDialog::ScheduleDialog(QWidget *parent, TransportSchedule* schedule)
     ui->arrivalDateEdit->setDate(QDate::currentDate().addDays(1));
     
     if (schedule_) {
-        ui->departureCityEdit->setText(schedule_->departureCity);
-        ui->arrivalCityEdit->setText(schedule_->arrivalCity);
+        ui->departureCityEdit->setText(schedule_->departureCity.toString());
+        ui->arrivalCityEdit->setText(schedule_->arrivalCity.toString());
         ui->departureDateEdit->setDate(schedule_->departureDate);
         ui->arrivalDateEdit->setDate(schedule_->arrivalDate);
-        ui->priceSpin->setValue(schedule_->price);
+        ui->priceSpin->setValue(schedule_->price.toDouble());
         ui->seatsSpin->setValue(schedule_->availableSeats);
     }
     
@@ -36,11 +36,11 @@ ScheduleDialog::~ScheduleDialog() = default;
 
 TransportSchedule ScheduleDialog::getSchedule() const {
     TransportSchedule schedule;
-    schedule.departureCity = ui->departureCityEdit->text();
-    schedule.arrivalCity = ui->arrivalCityEdit->text();
+    schedule.departureCity = Symbol(ui->departureCityEdit->text());
+    schedule.arrivalCity = Symbol(ui->arrivalCityEdit->text());
     schedule.departureDate = ui->departureDateEdit->date();
     schedule.arrivalDate = ui->arrivalDateEdit->date();
-    schedule.price = ui->priceSpin->value();
+    schedule.price = Money::fromDouble(ui->priceSpin->value());
     schedule.availableSeats = ui->seatsSpin->value();
     return schedule;
 }
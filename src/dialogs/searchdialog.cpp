@@ -1,20 +1,28 @@
 #include "dialogs/searchdialog.h"
 #include "ui_searchdialog.h"
 #include "utils/numericsortitem.h"
+#include "utils/symboltable.h"
+#include "utils/fuzzymatcher.h"
 #include <algorithm>
 #include <QTableWidgetItem>
 #include <iterator>
 
-SearchDialog::SearchDialog(QWidget *parent, DataContainer<Tour>* tours)
+SearchDialog::SearchDialog(QWidget *parent, DataContainer<Tour>* tours,
+                           const TourColumnStore* columns, TourSearchIndex* index)
     : QDialog(parent)
     , ui(std::make_unique<Ui::SearchDialog>())
     , tours_(tours)
+    , columns_(columns)
+    , index_(index)
 {
     ui->setupUi(this);
     
     ui->countryFilterCombo->setCurrentIndex(0);
     ui->costFilterCombo->setCurrentIndex(0);
     ui->durationFilterCombo->setCurrentIndex(0);
+    ui->dateFilterCombo->setCurrentIndex(0);
+    ui->dateFromEdit->setDate(QDate::currentDate());
+    ui->dateToEdit->setDate(QDate::currentDate().addDays(30));
     
     connect(ui->searchButton, &QPushButton::clicked, this, &SearchDialog::search);
     connect(ui->resultsTable, &QTableWidget::itemDoubleClicked, 
@@ -25,95 +33,136 @@ SearchDialog::SearchDialog(QWidget *parent, DataContainer<Tour>* tours)
 
 SearchDialog::~SearchDialog() = default;
 
+void SearchDialog::ensureIndex() {
+    if (!columns_ || columns_->size() != tours_->size()) {
+        localColumns_.rebuild(*tours_);
+        columns_ = &localColumns_;
+    }
+    
+    if (!index_) {
+        index_ = &localIndex_;
+    }
+    
+    if (!index_->isValidFor(*columns_)) {
+        index_->rebuild(*columns_);
+    }
+}
+
 void SearchDialog::search() {
     if (!tours_) return;
     
+    ensureIndex();
+    
     QString countryFilter = ui->countryEdit->text().trimmed();
-    double maxCost = ui->maxCostSpin->value();
+    Money maxCost = Money::fromDouble(ui->maxCostSpin->value());
     int minDuration = ui->minDurationSpin->value();
     
     int countryFilterState = ui->countryFilterCombo->currentIndex();
     int costFilterState = ui->costFilterCombo->currentIndex();
     int durationFilterState = ui->durationFilterCombo->currentIndex();
     
-    QVector<Tour> results;
-    
-    std::copy_if(tours_->getData().begin(), tours_->getData().end(),
-                 std::back_inserter(results),
-                 [this, countryFilter, maxCost, minDuration, countryFilterState, costFilterState, durationFilterState](const Tour& tour) {
-        return matchesTourFilter(tour, countryFilter, maxCost, minDuration,
-                                countryFilterState, costFilterState, durationFilterState);
-    });
+    TourQuery query = buildQuery(countryFilter, maxCost, minDuration,
+                                 countryFilterState, costFilterState, durationFilterState);
+    applyDateFilter(query);
     
-    std::sort(results.begin(), results.end(),
-              [](const Tour& a, const Tour& b) {
-        return a.calculateCost() < b.calculateCost();
-    });
+    QVector<int> rows = index_->query(query);
+    int totalMatches = rows.size() < ResultLimit ? static_cast<int>(rows.size()) : index_->count(query);
     
-    updateResultsTable(results);
+    updateResultsTable(rows, totalMatches);
 }
 
-bool SearchDialog::matchesTourFilter(const Tour& tour, const QString& countryFilter, double maxCost,
-                                     int minDuration, int countryFilterState, int costFilterState,
-                                     int durationFilterState) const {
-    if (countryFilterState == 1) {
-        if (countryFilter.isEmpty() || 
-            !tour.getCountry().contains(countryFilter, Qt::CaseInsensitive)) {
-            return false;
-        }
-    } else if (countryFilterState == 2) {
-        if (!countryFilter.isEmpty() && 
-            tour.getCountry().contains(countryFilter, Qt::CaseInsensitive)) {
-            return false;
-        }
+void SearchDialog::applyDateFilter(TourQuery& query) const {
+    int dateFilterState = ui->dateFilterCombo->currentIndex();
+    if (dateFilterState == 0) {
+        return;
+    }
+    
+    QDate from = ui->dateFromEdit->date();
+    QDate to = ui->dateToEdit->date();
+    if (to < from) {
+        std::swap(from, to);
     }
     
+    query.dateMatch = dateFilterState == 1 ? TourQuery::DateMatch::Overlaps : TourQuery::DateMatch::Within;
+    query.firstDay = IntervalIndex::dayOf(from);
+    query.lastDay = IntervalIndex::dayOf(to);
+}
+
+TourQuery SearchDialog::buildQuery(const QString& countryFilter, const Money& maxCost, int minDuration,
+                                   int countryFilterState, int costFilterState,
+                                   int durationFilterState) const {
+    TourQuery query;
+    query.limit = ResultLimit;
+    
     if (costFilterState == 1) {
-        if (tour.calculateCost() > maxCost) {
-            return false;
-        }
+        query.maxCost = maxCost.kopecks();
     } else if (costFilterState == 2) {
-        if (tour.calculateCost() <= maxCost) {
-            return false;
-        }
+        query.minCost = maxCost.kopecks() + 1;
     }
     
     if (durationFilterState == 1) {
-        if (tour.getDuration() < minDuration) {
-            return false;
-        }
+        query.minDuration = minDuration;
     } else if (durationFilterState == 2) {
-        if (tour.getDuration() >= minDuration) {
-            return false;
+        query.maxDuration = minDuration - 1;
+    }
+    
+    if (countryFilterState == 1 || (countryFilterState == 2 && !countryFilter.isEmpty())) {
+        query.filterCountries = true;
+        query.excludeCountries = countryFilterState == 2;
+        
+        if (!countryFilter.isEmpty()) {
+            QSet<quint32> seen;
+            for (quint32 countryId : columns_->countryIds()) {
+                if (seen.contains(countryId)) {
+                    continue;
+                }
+                seen.insert(countryId);
+                QString country = Symbol::fromId(countryId).toString();
+                if (country.contains(countryFilter, Qt::CaseInsensitive) ||
+                    FuzzyMatcher::matches(country, countryFilter)) {
+                    query.countryIds.insert(countryId);
+                }
+            }
         }
     }
     
-    return true;
+    return query;
 }
 
-void SearchDialog::updateResultsTable(const QVector<Tour>& results) {
+void SearchDialog::updateResultsTable(const QVector<int>& rows, int totalMatches) {
     ui->resultsTable->setSortingEnabled(false);
     
-    ui->resultsTable->setRowCount(results.size());
+    ui->resultsTable->setRowCount(rows.size());
     
     int row = 0;
-    for (const auto& tour : results) {
-        ui->resultsTable->setItem(row, 0, new QTableWidgetItem(tour.getName()));
-        ui->resultsTable->setItem(row, 1, new QTableWidgetItem(tour.getCountry()));
+    for (int index : rows) {
+        const Tour* tour = tours_->get(index);
+        if (!tour) {
+            continue;
+        }
+        
+        ui->resultsTable->setItem(row, 0, new QTableWidgetItem(tour->getName()));
+        ui->resultsTable->setItem(row, 1, new QTableWidgetItem(tour->getCountry()));
         ui->resultsTable->setItem(row, 2, 
-            new QTableWidgetItem(tour.getStartDate().toString("yyyy-MM-dd")));
+            new QTableWidgetItem(tour->getStartDate().toString("yyyy-MM-dd")));
         ui->resultsTable->setItem(row, 3, 
-            new QTableWidgetItem(tour.getEndDate().toString("yyyy-MM-dd")));
+            new QTableWidgetItem(tour->getEndDate().toString("yyyy-MM-dd")));
         
-        double cost = tour.calculateCost();
-        NumericSortItem* costItem = new NumericSortItem(QString::number(cost, 'f', 2) + " руб", cost);
+        NumericSortItem* costItem = new NumericSortItem(Money(columns_->costs()[index]));
         costItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
         ui->resultsTable->setItem(row, 4, costItem);
         ++row;
     }
     
+    ui->resultsTable->setRowCount(row);
     ui->resultsTable->setSortingEnabled(true);
     ui->resultsTable->sortItems(4, Qt::AscendingOrder);
+    
+    if (totalMatches > row) {
+        ui->resultsLabel->setText(QString("Результаты поиска: показано %1 из %2").arg(row).arg(totalMatches));
+    } else {
+        ui->resultsLabel->setText(QString("Результаты поиска: %1").arg(totalMatches));
+    }
 }
 
 void SearchDialog::onResultSelected() {
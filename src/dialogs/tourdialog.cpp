@@ -1,5 +1,6 @@
 #include "dialogs/tourdialog.h"
 #include "ui_tourdialog.h"
+#include "utils/tracer.h"
 #include <QMessageBox>
 #include <QDate>
 #include <QSet>
@@ -87,11 +88,11 @@ TransportCompany* TourDialog::findSelectedTransportCompany() const {
     }
     
     QString selectedCountry = ui->countryCombo->currentText();
-    QSet<QString> citiesInCountry = tourSetupHelper_->collectCitiesInCountry(selectedCountry);
+    QSet<Symbol> citiesInCountry = tourSetupHelper_->collectCitiesInCountry(selectedCountry);
     QString capital = tourSetupHelper_->findCountryCapital(selectedCountry);
     
     if (!capital.isEmpty()) {
-        citiesInCountry.insert(capital);
+        citiesInCountry.insert(Symbol(capital));
     }
     
     int comboIndex = 0;
@@ -104,9 +105,7 @@ TransportCompany* TourDialog::findSelectedTransportCompany() const {
         bool hasRelevantSchedule = citiesInCountry.isEmpty();
         if (!hasRelevantSchedule) {
             for (const auto& schedule : comp->getSchedules()) {
-                QString arrivalCity = schedule.arrivalCity;
-                if (citiesInCountry.contains(arrivalCity) || 
-                    (!capital.isEmpty() && arrivalCity.contains(capital, Qt::CaseInsensitive))) {
+                if (tourSetupHelper_->arrivesIn(schedule.arrivalCity, citiesInCountry, capital)) {
                     hasRelevantSchedule = true;
                     break;
                 }
@@ -125,42 +124,42 @@ TransportCompany* TourDialog::findSelectedTransportCompany() const {
     return nullptr;
 }
 
-double TourDialog::calculateTransportCost() const {
+Money TourDialog::calculateTransportCost() const {
     if (!companies_ || ui->transportCombo->currentIndex() < 0 || 
         ui->scheduleCombo->currentIndex() < 0) {
-        return 0.0;
+        return Money();
     }
     
     TransportCompany* company = findSelectedTransportCompany();
     if (!company) {
-        return 0.0;
+        return Money();
     }
     
     QVariant scheduleData = ui->scheduleCombo->itemData(ui->scheduleCombo->currentIndex());
     if (!scheduleData.isValid() || !scheduleData.canConvert<int>()) {
-        return 0.0;
+        return Money();
     }
     
     int scheduleIndex = scheduleData.toInt();
     if (scheduleIndex < 0 || scheduleIndex >= company->getScheduleCount()) {
-        return 0.0;
+        return Money();
     }
     
     TransportSchedule* schedule = company->getSchedule(scheduleIndex);
-    return schedule ? schedule->price : 0.0;
+    return schedule ? schedule->price : Money();
 }
 
-double TourDialog::calculateHotelCost() const {
+Money TourDialog::calculateHotelCost() const {
     if (!hotels_ || ui->hotelCombo->currentIndex() < 0 || 
         ui->roomCombo->currentIndex() < 0) {
-        return 0.0;
+        return Money();
     }
     
-    QString selectedCountry = ui->countryCombo->currentText();
+    Symbol selectedCountry(ui->countryCombo->currentText());
     int hotelIndex = 0;
     
     for (const auto& hotel : hotels_->getData()) {
-        if (hotel.getCountry() != selectedCountry) {
+        if (hotel.getCountrySymbol() != selectedCountry) {
             continue;
         }
         
@@ -192,28 +191,29 @@ double TourDialog::calculateHotelCost() const {
         break;
     }
     
-    return 0.0;
+    return Money();
 }
 
 void TourDialog::calculateCost() {
+    TRACE_SCOPE("TourDialog::calculateCost", "dialog");
     Tour tempTour = getTour();
-    double totalCost = tempTour.calculateCost();
-    double transportCost = calculateTransportCost();
-    double hotelCost = calculateHotelCost();
+    Money totalCost = tempTour.calculateCost();
+    Money transportCost = calculateTransportCost();
+    Money hotelCost = calculateHotelCost();
     int nights = tempTour.getDuration();
     
     QString costText = QString("<b style='font-size: 16pt; color: #0066cc;'>%1 руб</b>")
-        .arg(totalCost, 0, 'f', 2);
+        .arg(totalCost.toString());
     
-    if (transportCost > 0 || hotelCost > 0) {
+    if (transportCost.isPositive() || hotelCost.isPositive()) {
         costText += QString("<br><span style='font-size: 10pt; color: #666;'>");
-        if (transportCost > 0) {
+        if (transportCost.isPositive()) {
             costText += QString("Транспорт: %1 руб<br>")
-                .arg(transportCost, 0, 'f', 2);
+                .arg(transportCost.toString());
         }
-        if (hotelCost > 0) {
+        if (hotelCost.isPositive()) {
             costText += QString("Отель (%1 ночей): %2 руб")
-                .arg(nights).arg(hotelCost, 0, 'f', 2);
+                .arg(nights).arg(hotelCost.toString());
         }
         costText += "</span>";
     }
@@ -227,9 +227,10 @@ Hotel TourDialog::getSelectedHotel(const QString& country) const {
         return Hotel();
     }
     
+    Symbol countrySymbol(country);
     int hotelIndex = 0;
     for (const auto& hotel : hotels_->getData()) {
-        if (hotel.getCountry() != country) {
+        if (hotel.getCountrySymbol() != countrySymbol) {
             continue;
         }
         
@@ -371,14 +372,15 @@ void TourDialog::onTransportChanged() {
 }
 
 void TourDialog::updateHotelsCombo() {
+    TRACE_SCOPE("TourDialog::updateHotelsCombo", "dialog");
     ui->hotelCombo->clear();
     ui->roomCombo->clear();
     
     if (!hotels_ || ui->countryCombo->currentIndex() < 0) return;
     
-    QString selectedCountry = ui->countryCombo->currentText();
+    Symbol selectedCountry(ui->countryCombo->currentText());
     for (const auto& hotel : hotels_->getData()) {
-        if (hotel.getCountry() == selectedCountry) {
+        if (hotel.getCountrySymbol() == selectedCountry) {
             ui->hotelCombo->addItem(hotel.getName());
         }
     }
@@ -392,14 +394,15 @@ void TourDialog::updateHotelsCombo() {
 }
 
 void TourDialog::updateRoomsCombo() {
+    TRACE_SCOPE("TourDialog::updateRoomsCombo", "dialog");
     ui->roomCombo->clear();
     
     if (!hotels_ || ui->hotelCombo->currentIndex() < 0) return;
     
-    QString selectedCountry = ui->countryCombo->currentText();
+    Symbol selectedCountry(ui->countryCombo->currentText());
     int hotelIndex = 0;
     for (const auto& hotel : hotels_->getData()) {
-        if (hotel.getCountry() == selectedCountry) {
+        if (hotel.getCountrySymbol() == selectedCountry) {
             if (hotelIndex == ui->hotelCombo->currentIndex()) {
                 for (int i = 0; i < hotel.getRoomCount(); ++i) {
                     const Room* room = hotel.getRoom(i);
@@ -407,7 +410,7 @@ void TourDialog::updateRoomsCombo() {
                         QString roomInfo = QString("%1 (%2, %3 руб/ночь)")
                             .arg(room->getName())
                             .arg(Room::roomTypeToString(room->getRoomType()))
-                            .arg(room->getPricePerNight(), 0, 'f', 2);
+                            .arg(room->getPricePerNight().toString());
                         ui->roomCombo->addItem(roomInfo, i);
                     }
                 }
@@ -419,16 +422,14 @@ void TourDialog::updateRoomsCombo() {
 }
 
 bool TourDialog::hasRelevantScheduleForCountry(const TransportCompany& company, 
-                                                const QSet<QString>& citiesInCountry, 
+                                                const QSet<Symbol>& citiesInCountry, 
                                                 const QString& capital) const {
     if (citiesInCountry.isEmpty()) {
         return true;
     }
     
     for (const auto& schedule : company.getSchedules()) {
-        QString arrivalCity = schedule.arrivalCity;
-        if (citiesInCountry.contains(arrivalCity) || 
-            (!capital.isEmpty() && arrivalCity.contains(capital, Qt::CaseInsensitive))) {
+        if (tourSetupHelper_->arrivesIn(schedule.arrivalCity, citiesInCountry, capital)) {
             return true;
         }
     }
@@ -436,6 +437,7 @@ bool TourDialog::hasRelevantScheduleForCountry(const TransportCompany& company,
 }
 
 void TourDialog::updateTransportCombo() {
+    TRACE_SCOPE("TourDialog::updateTransportCombo", "dialog");
     ui->transportCombo->clear();
     
     if (!companies_) {
@@ -451,10 +453,10 @@ void TourDialog::updateTransportCombo() {
     
     QString selectedCountry = ui->countryCombo->currentText();
     QString capital = tourSetupHelper_->findCountryCapital(selectedCountry);
-    QSet<QString> citiesInCountry = tourSetupHelper_->collectCitiesInCountry(selectedCountry);
+    QSet<Symbol> citiesInCountry = tourSetupHelper_->collectCitiesInCountry(selectedCountry);
     
     if (!capital.isEmpty()) {
-        citiesInCountry.insert(capital);
+        citiesInCountry.insert(Symbol(capital));
     }
     
     for (const auto& company : companies_->getData()) {
@@ -465,13 +467,15 @@ void TourDialog::updateTransportCombo() {
 }
 
 void TourDialog::populateScheduleCombo(TransportCompany* company, 
-                                       const QSet<QString>& citiesInCountry, 
+                                       const QSet<Symbol>& citiesInCountry, 
                                        const QString& capital) const {
+    TRACE_SCOPE("TourDialog::populateScheduleCombo", "dialog");
     if (!company) {
         return;
     }
     
-    for (int i = 0; i < company->getScheduleCount(); ++i) {
+    QVector<int> order = tourSetupHelper_->orderSchedulesForStart(company, ui->startDateEdit->date());
+    for (int i : order) {
         TransportSchedule* schedule = company->getSchedule(i);
         if (!schedule) {
             continue;
@@ -479,9 +483,7 @@ void TourDialog::populateScheduleCombo(TransportCompany* company,
         
         bool shouldInclude = citiesInCountry.isEmpty();
         if (!shouldInclude) {
-            QString arrivalCity = schedule->arrivalCity;
-            shouldInclude = citiesInCountry.contains(arrivalCity) || 
-                           (!capital.isEmpty() && arrivalCity.contains(capital, Qt::CaseInsensitive));
+            shouldInclude = tourSetupHelper_->arrivesIn(schedule->arrivalCity, citiesInCountry, capital);
         }
         
         if (!shouldInclude) {
@@ -489,15 +491,16 @@ void TourDialog::populateScheduleCombo(TransportCompany* company,
         }
         
         QString scheduleInfo = QString("%1 → %2, %3, %4 руб")
-            .arg(schedule->departureCity)
-            .arg(schedule->arrivalCity)
+            .arg(schedule->departureCity.toString())
+            .arg(schedule->arrivalCity.toString())
             .arg(schedule->departureDate.toString("dd.MM.yyyy"))
-            .arg(schedule->price, 0, 'f', 2);
+            .arg(schedule->price.toString());
         ui->scheduleCombo->addItem(scheduleInfo, i);
     }
 }
 
 void TourDialog::updateSchedulesCombo() {
+    TRACE_SCOPE("TourDialog::updateSchedulesCombo", "dialog");
     ui->scheduleCombo->clear();
     
     if (!companies_ || ui->transportCombo->currentIndex() < 0) {
@@ -505,7 +508,7 @@ void TourDialog::updateSchedulesCombo() {
     }
     
     QString selectedCountry = ui->countryCombo->currentText();
-    QSet<QString> citiesInCountry;
+    QSet<Symbol> citiesInCountry;
     QString capital = "";
     
     if (countries_ && ui->countryCombo->currentIndex() >= 0) {
@@ -513,7 +516,7 @@ void TourDialog::updateSchedulesCombo() {
         citiesInCountry = tourSetupHelper_->collectCitiesInCountry(selectedCountry);
         
         if (!capital.isEmpty()) {
-            citiesInCountry.insert(capital);
+            citiesInCountry.insert(Symbol(capital));
         }
     }
     
@@ -1,4 +1,5 @@
 #include "dialogs/toursetuphelper.h"
+#include "utils/tourlinker.h"
 #include <QComboBox>
 #include <QLineEdit>
 #include <QSet>
@@ -13,6 +14,64 @@ TourSetupHelper::TourSetupHelper(DataContainer<Country>* countries,
     , companies_(companies)
     , tours_(tours)
 {
+    if (companies_) {
+        scheduleIndex_.rebuild(*companies_);
+    }
+    buildCityIndex();
+}
+
+void TourSetupHelper::buildCityIndex() {
+    TourLinker::buildCityIndex(cityIndex_, countries_, hotels_, companies_);
+}
+
+bool TourSetupHelper::arrivesIn(Symbol arrivalCity, const QSet<Symbol>& cities, const QString& capital) const {
+    if (cities.contains(arrivalCity)) {
+        return true;
+    }
+    if (!capital.isEmpty() && arrivalCity.toString().contains(capital, Qt::CaseInsensitive)) {
+        return true;
+    }
+    
+    for (Symbol similar : cityIndex_.similarTo(arrivalCity)) {
+        if (cities.contains(similar)) {
+            return true;
+        }
+    }
+    return !capital.isEmpty() &&
+           FuzzyMatcher::matchesNormalized(cityIndex_.normalized(arrivalCity), cityIndex_.normalized(Symbol(capital)));
+}
+
+QVector<int> TourSetupHelper::orderSchedulesForStart(TransportCompany* company, const QDate& startDate) const {
+    QVector<int> order;
+    if (!company) {
+        return order;
+    }
+    
+    QVector<bool> listed(company->getScheduleCount(), false);
+    int companyIndex = -1;
+    for (int i = 0; companies_ && i < companies_->size(); ++i) {
+        if (companies_->get(i) == company) {
+            companyIndex = i;
+            break;
+        }
+    }
+    
+    if (startDate.isValid() && companyIndex >= 0) {
+        QVector<ScheduleRef> recent = scheduleIndex_.departingBefore(companyIndex, startDate, ScheduleWindowDays);
+        for (auto it = recent.crbegin(); it != recent.crend(); ++it) {
+            if (it->scheduleIndex < listed.size() && !listed[it->scheduleIndex]) {
+                listed[it->scheduleIndex] = true;
+                order.append(it->scheduleIndex);
+            }
+        }
+    }
+    
+    for (int i = 0; i < listed.size(); ++i) {
+        if (!listed[i]) {
+            order.append(i);
+        }
+    }
+    return order;
 }
 
 bool TourSetupHelper::findExistingTour(const Tour& tour, int& tourIndex) const {
@@ -24,7 +83,7 @@ bool TourSetupHelper::findExistingTour(const Tour& tour, int& tourIndex) const {
         Tour* existingTour = tours_->get(i);
         if (existingTour && 
             existingTour->getName() == tour.getName() &&
-            existingTour->getCountry() == tour.getCountry() &&
+            existingTour->getCountrySymbol() == tour.getCountrySymbol() &&
             existingTour->getStartDate() == tour.getStartDate() &&
             existingTour->getEndDate() == tour.getEndDate()) {
             tourIndex = i;
@@ -47,15 +106,16 @@ QString TourSetupHelper::findCountryCapital(const QString& selectedCountry) cons
     return "";
 }
 
-QSet<QString> TourSetupHelper::collectCitiesInCountry(const QString& selectedCountry) const {
-    QSet<QString> cities;
+QSet<Symbol> TourSetupHelper::collectCitiesInCountry(const QString& selectedCountry) const {
+    QSet<Symbol> cities;
     
     if (!hotels_) {
         return cities;
     }
     
+    Symbol countrySymbol(selectedCountry);
     for (const auto& hotel : hotels_->getData()) {
-        if (hotel.getCountry() != selectedCountry) {
+        if (hotel.getCountrySymbol() != countrySymbol) {
             continue;
         }
         
@@ -66,9 +126,9 @@ QSet<QString> TourSetupHelper::collectCitiesInCountry(const QString& selectedCou
         
         QString city = address.split(',').first().trimmed();
         if (!city.isEmpty()) {
-            cities.insert(city);
+            cities.insert(Symbol(city));
         }
-        cities.insert(address);
+        cities.insert(Symbol(address));
     }
     
     return cities;
@@ -81,11 +141,11 @@ TransportCompany* TourSetupHelper::findSelectedTransportCompany(QComboBox* count
     }
     
     QString selectedCountry = countryCombo->currentText();
-    QSet<QString> citiesInCountry = collectCitiesInCountry(selectedCountry);
+    QSet<Symbol> citiesInCountry = collectCitiesInCountry(selectedCountry);
     QString capital = findCountryCapital(selectedCountry);
     
     if (!capital.isEmpty()) {
-        citiesInCountry.insert(capital);
+        citiesInCountry.insert(Symbol(capital));
     }
     
     int comboIndex = 0;
@@ -98,9 +158,7 @@ TransportCompany* TourSetupHelper::findSelectedTransportCompany(QComboBox* count
         bool hasRelevantSchedule = citiesInCountry.isEmpty();
         if (!hasRelevantSchedule) {
             for (const auto& schedule : comp->getSchedules()) {
-                QString arrivalCity = schedule.arrivalCity;
-                if (citiesInCountry.contains(arrivalCity) || 
-                    (!capital.isEmpty() && arrivalCity.contains(capital, Qt::CaseInsensitive))) {
+                if (arrivesIn(schedule.arrivalCity, citiesInCountry, capital)) {
                     hasRelevantSchedule = true;
                     break;
                 }
@@ -192,11 +250,11 @@ void TourSetupHelper::setupHotelAndRoom(const Tour& tour,
         return;
     }
     
-    QString selectedCountry = countryCombo->currentText();
+    Symbol selectedCountry(countryCombo->currentText());
     int comboHotelIndex = 0;
     
     for (const auto& h : hotels_->getData()) {
-        if (h.getCountry() != selectedCountry) {
+        if (h.getCountrySymbol() != selectedCountry) {
             continue;
         }
         
@@ -247,9 +305,10 @@ Hotel TourSetupHelper::getSelectedHotel(const QString& country,
         return Hotel();
     }
     
+    Symbol countrySymbol(country);
     int hotelIndex = 0;
     for (const auto& hotel : hotels_->getData()) {
-        if (hotel.getCountry() != country) {
+        if (hotel.getCountrySymbol() != countrySymbol) {
             continue;
         }
         
@@ -291,12 +350,12 @@ void TourSetupHelper::setupTourTransport(Tour& tour,
     
     tour.setTransportCompany(*company);
     
-    if (scheduleCombo->currentIndex() < 0 || 
-        scheduleCombo->currentIndex() >= company->getScheduleCount()) {
+    QVariant scheduleData = scheduleCombo->currentData();
+    if (!scheduleData.isValid()) {
         return;
     }
     
-    TransportSchedule* schedule = company->getSchedule(scheduleCombo->currentIndex());
+    TransportSchedule* schedule = company->getSchedule(scheduleData.toInt());
     if (schedule) {
         tour.setTransportSchedule(*schedule);
     }
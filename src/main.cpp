@@ -1,4 +1,5 @@
 #include "mainwindow.h"
+#include "utils/tracer.h"
 
 #include <QApplication>
 #include <QLocale>
@@ -18,9 +19,18 @@ int main(int argc, char *argv[])
         }
     }
 
+    const QString tracePath = qEnvironmentVariable("TOURIST_AGENCY_TRACE");
+    if (!tracePath.isEmpty()) {
+        Tracer::instance().setEnabled(true);
+    }
+
     MainWindow window;
     window.show();
     
-    return app.exec();
+    int result = app.exec();
+    if (!tracePath.isEmpty()) {
+        Tracer::instance().exportToFile(tracePath);
+    }
+    return result;
 }
 
@@ -7,7 +7,13 @@
 #include "dialogs/searchdialog.h"
 #include "dialogs/booktourdialog.h"
 #include "utils/numericsortitem.h"
+#include "utils/blockchecksums.h"
 #include "utils/filemanager.h"
+#include "utils/orderarchive.h"
+#include "utils/perfcounters.h"
+#include "utils/tracer.h"
+#include <QFileDialog>
+#include <QMenu>
 #include <QHeaderView>
 #include <QAbstractItemView>
 #include <QMessageBox>
@@ -50,8 +56,11 @@
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(std::make_unique<Ui::MainWindow>())
+    , tourLinker_(&countries_, &hotels_, &transportCompanies_, &tours_, &orders_)
     , networkManager_(new QNetworkAccessManager(this))
     , currencyTimer_(new QTimer(this))
+    , diagnosticsDock_(new DiagnosticsDock(&countries_, &hotels_, &transportCompanies_, &tours_, &orders_, this))
+    , idleRefreshTimer_(new QTimer(this))
     , tableManager_(new TableManager())
     , filterManager_(new FilterManager())
     , filterComboUpdater_(new FilterComboUpdater())
@@ -72,6 +81,8 @@ MainWindow::MainWindow(QWidget *parent)
 }
 
 MainWindow::~MainWindow() {
+    waitForSnapshotThread();
+    
     for (Action* action : actions_) {
         delete action;
     }
@@ -85,6 +96,10 @@ MainWindow::~MainWindow() {
 void MainWindow::setupUI() {
     connect(ui->tabWidget, &QTabWidget::currentChanged, this, &MainWindow::onTabChanged);
     
+    idleRefreshTimer_->setSingleShot(true);
+    idleRefreshTimer_->setInterval(0);
+    connect(idleRefreshTimer_, &QTimer::timeout, this, &MainWindow::refreshNextStaleView);
+    
     QWidget* currencyCornerWidget = new QWidget(this);
     QHBoxLayout* currencyLayout = new QHBoxLayout(currencyCornerWidget);
     currencyLayout->setContentsMargins(0, 0, 10, 0);
@@ -179,6 +194,104 @@ void MainWindow::setupMenuBar() {
     connect(ui->actionAddOrder, &QAction::triggered, this, &MainWindow::addOrder);
     connect(ui->actionDeleteOrder, &QAction::triggered, this, &MainWindow::deleteOrder);
     
+    QMenu* archiveMenu = menuBar()->addMenu("Архив");
+    connect(archiveMenu->addAction("Загрузить заказы прошлых лет"), &QAction::triggered,
+            this, &MainWindow::loadOrderArchive);
+    archiveMenu->addSeparator();
+    connect(archiveMenu->addAction("Переместить завершённые заказы в архив"), &QAction::triggered,
+            this, &MainWindow::archiveFinishedOrders);
+    connect(archiveMenu->addAction("Найти в архиве..."), &QAction::triggered,
+            this, &MainWindow::searchOrderArchive);
+    
+    QMenu* diagnosticsMenu = menuBar()->addMenu("Диагностика");
+    addDockWidget(Qt::RightDockWidgetArea, diagnosticsDock_);
+    diagnosticsDock_->hide();
+    QAction* countersAction = diagnosticsDock_->toggleViewAction();
+    countersAction->setText("Счётчики производительности");
+    diagnosticsMenu->addAction(countersAction);
+    diagnosticsMenu->addSeparator();
+    QAction* tracingAction = diagnosticsMenu->addAction("Включить трассировку");
+    tracingAction->setCheckable(true);
+    tracingAction->setChecked(Tracer::instance().isEnabled());
+    connect(tracingAction, &QAction::toggled, this, &MainWindow::setTracingEnabled);
+    connect(diagnosticsMenu->addAction("Сохранить трассировку..."), &QAction::triggered,
+            this, &MainWindow::exportTrace);
+    connect(diagnosticsMenu->addAction("Очистить трассировку"), &QAction::triggered,
+            this, &MainWindow::clearTrace);
+    diagnosticsMenu->addSeparator();
+    connect(diagnosticsMenu->addAction("Проверить целостность файлов данных"), &QAction::triggered,
+            this, &MainWindow::verifyDataFiles);
+}
+
+void MainWindow::setTracingEnabled(bool enabled) {
+    Tracer::instance().setEnabled(enabled);
+    statusBar()->showMessage(enabled ? "Трассировка включена" : "Трассировка выключена", 3000);
+}
+
+void MainWindow::verifyDataFiles() {
+    QString dataPath = QDir(findDataDirectory()).absolutePath();
+    QVector<BlockChecksums::Report> reports;
+    try {
+        reports = BlockChecksums::verifyDirectory(dataPath);
+    } catch (const FileException& e) {
+        QMessageBox::critical(this, "Ошибка", QString("Не удалось проверить файлы данных: %1").arg(e.what()));
+        return;
+    }
+
+    QDir dir(dataPath);
+    QStringList problems;
+    QStringList edited;
+    for (BlockChecksums::Report report : reports) {
+        if (report.status == BlockChecksums::Status::Unchecked || report.changedAfterSeal) {
+            edited << report.filename;
+        }
+        if (report.status != BlockChecksums::Status::Ok) {
+            report.filename = dir.relativeFilePath(report.filename);
+            problems << report.describe();
+        }
+    }
+    if (problems.isEmpty()) {
+        statusBar()->showMessage(QString("Файлы данных не повреждены: %1").arg(reports.size()), 3000);
+        return;
+    }
+    if (edited.isEmpty()) {
+        QMessageBox::warning(this, "Проверка файлов данных", problems.join("\n"));
+        return;
+    }
+    if (QMessageBox::question(this, "Проверка файлов данных",
+            QString("%1\n\nФайлы без контрольных сумм или изменённые после сохранения: %2.\n"
+                    "Если изменения сделаны намеренно, пересчитать для них контрольные суммы?")
+                .arg(problems.join("\n")).arg(edited.size())) != QMessageBox::Yes) {
+        return;
+    }
+    for (const QString& filename : edited) {
+        if (!BlockChecksums::seal(filename)) {
+            QMessageBox::warning(this, "Предупреждение",
+                                 "Не удалось записать контрольные суммы: " + BlockChecksums::pathFor(filename));
+            return;
+        }
+    }
+    statusBar()->showMessage(QString("Контрольные суммы пересчитаны: %1").arg(edited.size()), 3000);
+}
+
+void MainWindow::exportTrace() {
+    QString filename = QFileDialog::getSaveFileName(this, "Сохранить трассировку",
+                                                    "trace.json", "Chrome Trace (*.json)");
+    if (filename.isEmpty()) {
+        return;
+    }
+
+    Tracer& tracer = Tracer::instance();
+    if (!tracer.exportToFile(filename)) {
+        QMessageBox::warning(this, "Предупреждение", "Не удалось сохранить трассировку: " + filename);
+        return;
+    }
+    statusBar()->showMessage(QString("Трассировка сохранена: %1 событий").arg(tracer.eventCount()), 5000);
+}
+
+void MainWindow::clearTrace() {
+    Tracer::instance().clear();
+    statusBar()->showMessage("Трассировка очищена", 3000);
 }
 
 void MainWindow::setupStatusBar() {
@@ -629,6 +742,8 @@ QWidget* MainWindow::createActionButtons(int dataIndex, const QString& type) {
 }
 
 void MainWindow::updateCountriesTable() {
+    TRACE_SCOPE("MainWindow::updateCountriesTable", "ui");
+    PerfTimer perfTimer(PerfCounters::TableRefresh);
     ui->countriesTable->setUpdatesEnabled(false);
     
     ui->countriesTable->setSortingEnabled(false);
@@ -646,6 +761,7 @@ void MainWindow::updateCountriesTable() {
         ui->countriesTable->setItem(row, 0, nameItem);
         
         QTableWidgetItem* continentItem = new QTableWidgetItem(country.getContinent());
+        continentItem->setData(SymbolTable::SymbolRole, country.getContinentSymbol().id());
         continentItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
         ui->countriesTable->setItem(row, 1, continentItem);
         
@@ -654,6 +770,7 @@ void MainWindow::updateCountriesTable() {
         ui->countriesTable->setItem(row, 2, capitalItem);
         
         QTableWidgetItem* currencyItem = new QTableWidgetItem(country.getCurrency());
+        currencyItem->setData(SymbolTable::SymbolRole, country.getCurrencySymbol().id());
         currencyItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
         ui->countriesTable->setItem(row, 3, currencyItem);
         
@@ -670,11 +787,13 @@ void MainWindow::updateCountriesTable() {
     filterComboUpdater_->updateCountriesFilterCombo(ui->filterCountryCombo,
                                                      ui->filterCountryCurrencyCombo,
                                                      countries_);
-    filterManager_->applyCountriesFilters(ui->countriesTable, ui->searchCountryEdit,
-                                         ui->filterCountryCombo, ui->filterCountryCurrencyCombo);
+    rebuildCountryFacets();
+    applyCountriesFilters();
 }
 
 void MainWindow::updateHotelsTable() {
+    TRACE_SCOPE("MainWindow::updateHotelsTable", "ui");
+    PerfTimer perfTimer(PerfCounters::TableRefresh);
     ui->hotelsTable->setUpdatesEnabled(false);
     
     ui->hotelsTable->setSortingEnabled(false);
@@ -692,6 +811,7 @@ void MainWindow::updateHotelsTable() {
         ui->hotelsTable->setItem(row, 0, nameItem);
         
         QTableWidgetItem* countryItem = new QTableWidgetItem(hotel.getCountry());
+        countryItem->setData(SymbolTable::SymbolRole, hotel.getCountrySymbol().id());
         countryItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
         ui->hotelsTable->setItem(row, 1, countryItem);
         
@@ -717,10 +837,13 @@ void MainWindow::updateHotelsTable() {
     
     ui->hotelsTable->setUpdatesEnabled(true);
     
+    rebuildHotelFacets();
     applyHotelsFilters();
 }
 
 void MainWindow::updateTransportCompaniesTable() {
+    TRACE_SCOPE("MainWindow::updateTransportCompaniesTable", "ui");
+    PerfTimer perfTimer(PerfCounters::TableRefresh);
     ui->transportTable->setUpdatesEnabled(false);
     
     ui->transportTable->setSortingEnabled(false);
@@ -745,7 +868,7 @@ void MainWindow::updateTransportCompaniesTable() {
         int scheduleCount = company.getScheduleCount();
         NumericSortItem* scheduleCountItem = new NumericSortItem(
             QString::number(scheduleCount), 
-            static_cast<double>(scheduleCount)
+            scheduleCount
         );
         scheduleCountItem->setTextAlignment(Qt::AlignCenter | Qt::AlignVCenter);
         ui->transportTable->setItem(row, 2, scheduleCountItem);
@@ -790,10 +913,13 @@ void MainWindow::updateTransportCompaniesTable() {
     
     ui->transportTable->setUpdatesEnabled(true);
     
+    rebuildTransportFacets();
     applyTransportFilters();
 }
 
 void MainWindow::updateToursTable() {
+    TRACE_SCOPE("MainWindow::updateToursTable", "ui");
+    PerfTimer perfTimer(PerfCounters::TableRefresh);
     ui->toursTable->setUpdatesEnabled(false);
     
     ui->toursTable->setSortingEnabled(false);
@@ -825,6 +951,7 @@ void MainWindow::updateToursTable() {
         ui->toursTable->setItem(row, 0, nameItem);
         
         QTableWidgetItem* countryItem = new QTableWidgetItem(tour.getCountry());
+        countryItem->setData(SymbolTable::SymbolRole, tour.getCountrySymbol().id());
         countryItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
         ui->toursTable->setItem(row, 1, countryItem);
         
@@ -841,8 +968,7 @@ void MainWindow::updateToursTable() {
         endDateItem->setTextAlignment(Qt::AlignCenter | Qt::AlignVCenter);
         ui->toursTable->setItem(row, 3, endDateItem);
         
-        double cost = tour.calculateCost();
-        NumericSortItem* costItem = new NumericSortItem(QString::number(cost, 'f', 2) + " руб", cost);
+        NumericSortItem* costItem = new NumericSortItem(tour.calculateCost());
         costItem->setTextAlignment(Qt::AlignCenter | Qt::AlignVCenter);
         ui->toursTable->setItem(row, 4, costItem);
         
@@ -860,6 +986,8 @@ void MainWindow::updateToursTable() {
 }
 
 void MainWindow::updateOrdersTable() {
+    TRACE_SCOPE("MainWindow::updateOrdersTable", "ui");
+    PerfTimer perfTimer(PerfCounters::TableRefresh);
     ui->ordersTable->setUpdatesEnabled(false);
     
     ui->ordersTable->setSortingEnabled(false);
@@ -868,7 +996,7 @@ void MainWindow::updateOrdersTable() {
     
     int validOrderCount = 0;
     for (const auto& order : orders_.getData()) {
-        if (!order.getTour().getName().isEmpty() && 
+        if (!order.getTourName().isEmpty() && 
             !order.getClientName().isEmpty() && 
             !order.getClientPhone().isEmpty()) {
             validOrderCount++;
@@ -880,7 +1008,7 @@ void MainWindow::updateOrdersTable() {
     int row = 0;
     int dataIndex = 0;
     for (const auto& order : orders_.getData()) {
-        if (order.getTour().getName().isEmpty() || 
+        if (order.getTourName().isEmpty() || 
             order.getClientName().isEmpty() || 
             order.getClientPhone().isEmpty()) {
             ++dataIndex;
@@ -889,7 +1017,7 @@ void MainWindow::updateOrdersTable() {
         
         ui->ordersTable->setRowHidden(row, false);
         
-        QTableWidgetItem* tourItem = new QTableWidgetItem(order.getTour().getName());
+        QTableWidgetItem* tourItem = new QTableWidgetItem(order.getTourName());
         tourItem->setData(Qt::UserRole, dataIndex);
         tourItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
         ui->ordersTable->setItem(row, 0, tourItem);
@@ -906,12 +1034,12 @@ void MainWindow::updateOrdersTable() {
         emailItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
         ui->ordersTable->setItem(row, 3, emailItem);
         
-        double cost = order.getTotalCost();
-        NumericSortItem* costItem = new NumericSortItem(QString::number(cost, 'f', 2) + " руб", cost);
+        NumericSortItem* costItem = new NumericSortItem(order.getTotalCost());
         costItem->setTextAlignment(Qt::AlignCenter | Qt::AlignVCenter);
         ui->ordersTable->setItem(row, 4, costItem);
         
-        QTableWidgetItem* statusItem = new QTableWidgetItem(order.getStatus());
+        QTableWidgetItem* statusItem = new QTableWidgetItem(order.getStatusText());
+        statusItem->setData(OrderStatusInfo::StatusRole, static_cast<int>(order.getStatus()));
         statusItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
         ui->ordersTable->setItem(row, 5, statusItem);
         
@@ -925,6 +1053,7 @@ void MainWindow::updateOrdersTable() {
     
     ui->ordersTable->setUpdatesEnabled(true);
     
+    updateOrderStatusCounts();
     applyOrdersFilters();
 }
 
@@ -935,6 +1064,8 @@ int MainWindow::getSelectedRow(QTableWidget* table) const {
 }
 
 int MainWindow::getSelectedTourIndex() const {
+    if (isViewStale(ToursView)) return -1;
+    
     QList<QTableWidgetItem*> items = ui->toursTable->selectedItems();
     if (items.isEmpty()) return -1;
     
@@ -951,6 +1082,8 @@ int MainWindow::getSelectedTourIndex() const {
 }
 
 int MainWindow::getSelectedOrderIndex() const {
+    if (isViewStale(OrdersView)) return -1;
+    
     QList<QTableWidgetItem*> items = ui->ordersTable->selectedItems();
     if (items.isEmpty()) return -1;
     
@@ -967,6 +1100,8 @@ int MainWindow::getSelectedOrderIndex() const {
 }
 
 int MainWindow::getSelectedCountryIndex() const {
+    if (isViewStale(CountriesView)) return -1;
+    
     QList<QTableWidgetItem*> items = ui->countriesTable->selectedItems();
     if (items.isEmpty()) return -1;
     
@@ -983,6 +1118,8 @@ int MainWindow::getSelectedCountryIndex() const {
 }
 
 int MainWindow::getSelectedHotelIndex() const {
+    if (isViewStale(HotelsView)) return -1;
+    
     QList<QTableWidgetItem*> items = ui->hotelsTable->selectedItems();
     if (items.isEmpty()) return -1;
     
@@ -999,6 +1136,8 @@ int MainWindow::getSelectedHotelIndex() const {
 }
 
 int MainWindow::getSelectedTransportIndex() const {
+    if (isViewStale(TransportView)) return -1;
+    
     QList<QTableWidgetItem*> items = ui->transportTable->selectedItems();
     if (items.isEmpty()) return -1;
     
@@ -1019,8 +1158,10 @@ void MainWindow::addCountry() {
     if (dialog.exec() == QDialog::Accepted) {
         Country country = dialog.getCountry();
         countries_.add(country);
-        updateCountriesTable();
-        updateCountriesFilterCombo();
+        if (!deferIfHidden(CountriesView, StaleAll)) {
+            updateCountriesTable();
+            updateCountriesFilterCombo();
+        }
         statusBar()->showMessage("Страна добавлена", 2000);
     }
 }
@@ -1047,9 +1188,11 @@ void MainWindow::editCountry() {
     if (dialog.exec() == QDialog::Accepted) {
         Country newCountry = dialog.getCountry();
         *country = newCountry;
-        updateCountriesTable();
-        updateCountriesFilterCombo();
-        applyCountriesFilters();
+        if (!deferIfHidden(CountriesView, StaleAll)) {
+            updateCountriesTable();
+            updateCountriesFilterCombo();
+            applyCountriesFilters();
+        }
         statusBar()->showMessage("Страна обновлена", 2000);
     }
 }
@@ -1075,9 +1218,11 @@ void MainWindow::deleteCountry() {
     if (QMessageBox::question(this, "Подтверждение", 
         "Вы уверены, что хотите удалить эту страну?") == QMessageBox::Yes) {
         countries_.remove(dataIndex);
-        updateCountriesTable();
-        updateCountriesFilterCombo();
-        applyCountriesFilters();
+        if (!deferIfHidden(CountriesView, StaleAll)) {
+            updateCountriesTable();
+            updateCountriesFilterCombo();
+            applyCountriesFilters();
+        }
         statusBar()->showMessage("Страна удалена", 2000);
     }
 }
@@ -1122,8 +1267,10 @@ void MainWindow::addHotel() {
     if (dialog.exec() == QDialog::Accepted) {
         Hotel hotel = dialog.getHotel();
         hotels_.add(hotel);
-        updateHotelsTable();
-        updateHotelsFilterCombos();
+        if (!deferIfHidden(HotelsView, StaleAll)) {
+            updateHotelsTable();
+            updateHotelsFilterCombos();
+        }
         statusBar()->showMessage("Отель добавлен", 2000);
     }
 }
@@ -1150,9 +1297,11 @@ void MainWindow::editHotel() {
     if (dialog.exec() == QDialog::Accepted) {
         Hotel newHotel = dialog.getHotel();
         *hotel = newHotel;
-        updateHotelsTable();
-        updateHotelsFilterCombos();
-        applyHotelsFilters();
+        if (!deferIfHidden(HotelsView, StaleAll)) {
+            updateHotelsTable();
+            updateHotelsFilterCombos();
+            applyHotelsFilters();
+        }
         statusBar()->showMessage("Отель обновлен", 2000);
     }
 }
@@ -1178,9 +1327,11 @@ void MainWindow::deleteHotel() {
     if (QMessageBox::question(this, "Подтверждение", 
         "Вы уверены, что хотите удалить этот отель?") == QMessageBox::Yes) {
         hotels_.remove(dataIndex);
-        updateHotelsTable();
-        updateHotelsFilterCombos();
-        applyHotelsFilters();
+        if (!deferIfHidden(HotelsView, StaleAll)) {
+            updateHotelsTable();
+            updateHotelsFilterCombos();
+            applyHotelsFilters();
+        }
         statusBar()->showMessage("Отель удален", 2000);
     }
 }
@@ -1211,7 +1362,7 @@ void MainWindow::showHotelInfo() {
             roomsInfo += QString("  %1. Тип: %2, Стоимость: %3 руб/ночь\n")
                         .arg(roomNum++)
                         .arg(room.getType())
-                        .arg(room.getPricePerNight(), 0, 'f', 2);
+                        .arg(room.getPricePerNight().toString());
         }
     } else {
         roomsInfo = "\nНомера: нет";
@@ -1242,8 +1393,10 @@ void MainWindow::addTransportCompany() {
     if (dialog.exec() == QDialog::Accepted) {
         TransportCompany company = dialog.getCompany();
         transportCompanies_.add(company);
-        updateTransportCompaniesTable();
-        applyTransportFilters();
+        if (!deferIfHidden(TransportView)) {
+            updateTransportCompaniesTable();
+            applyTransportFilters();
+        }
         statusBar()->showMessage("Транспортная компания добавлена", 2000);
     }
 }
@@ -1270,8 +1423,10 @@ void MainWindow::editTransportCompany() {
     if (dialog.exec() == QDialog::Accepted) {
         TransportCompany newCompany = dialog.getCompany();
         *company = newCompany;
-        updateTransportCompaniesTable();
-        applyTransportFilters();
+        if (!deferIfHidden(TransportView)) {
+            updateTransportCompaniesTable();
+            applyTransportFilters();
+        }
         statusBar()->showMessage("Компания обновлена", 2000);
     }
 }
@@ -1297,8 +1452,10 @@ void MainWindow::deleteTransportCompany() {
     if (QMessageBox::question(this, "Подтверждение", 
         "Вы уверены, что хотите удалить эту компанию?") == QMessageBox::Yes) {
         transportCompanies_.remove(dataIndex);
-        updateTransportCompaniesTable();
-        applyTransportFilters();
+        if (!deferIfHidden(TransportView)) {
+            updateTransportCompaniesTable();
+            applyTransportFilters();
+        }
         statusBar()->showMessage("Компания удалена", 2000);
     }
 }
@@ -1328,9 +1485,9 @@ void MainWindow::showTransportCompanyInfo() {
         for (const auto& schedule : company->getSchedules()) {
             schedulesInfo += QString("  %1. Отправление: %2 (%3) -> Прибытие: %4 (%5)\n")
                         .arg(scheduleNum++)
-                        .arg(schedule.departureCity)
+                        .arg(schedule.departureCity.toString())
                         .arg(schedule.departureDate.toString("yyyy-MM-dd"))
-                        .arg(schedule.arrivalCity)
+                        .arg(schedule.arrivalCity.toString())
                         .arg(schedule.arrivalDate.toString("yyyy-MM-dd"));
         }
     } else {
@@ -1358,9 +1515,12 @@ void MainWindow::addTour() {
     if (dialog.exec() == QDialog::Accepted) {
         Tour tour = dialog.getTour();
         tours_.add(tour);
-        updateToursTable();
-        updateToursFilterCombo();
-        applyToursFilters();
+        tourDataChanged();
+        if (!deferIfHidden(ToursView, StaleAll)) {
+            updateToursTable();
+            updateToursFilterCombo();
+            applyToursFilters();
+        }
         statusBar()->showMessage("Тур добавлен", 2000);
     }
 }
@@ -1397,10 +1557,12 @@ void MainWindow::editTour() {
         }
         
         *tour = newTour;
-        updateToursTable();
-        updateToursFilterCombo();
         linkToursWithHotelsAndTransport();
-        applyToursFilters();
+        if (!deferIfHidden(ToursView, StaleAll)) {
+            updateToursTable();
+            updateToursFilterCombo();
+            applyToursFilters();
+        }
         statusBar()->showMessage("Тур обновлен", 2000);
     }
 }
@@ -1426,10 +1588,12 @@ void MainWindow::deleteTour() {
     if (QMessageBox::question(this, "Подтверждение", 
         "Вы уверены, что хотите удалить этот тур?") == QMessageBox::Yes) {
         tours_.remove(dataIndex);
-        updateToursTable();
-        updateToursFilterCombo();
         linkToursWithHotelsAndTransport();
-        applyToursFilters();
+        if (!deferIfHidden(ToursView, StaleAll)) {
+            updateToursTable();
+            updateToursFilterCombo();
+            applyToursFilters();
+        }
         statusBar()->showMessage("Тур удален", 2000);
     }
 }
@@ -1466,7 +1630,7 @@ void MainWindow::showTourInfo() {
                    .arg(tour->getEndDate().isValid() ? tour->getEndDate().toString("yyyy-MM-dd") : "не указана")
                    .arg(tour->getHotel().getName().isEmpty() ? "не выбран" : tour->getHotel().getName())
                    .arg(tour->getTransportCompany().getName().isEmpty() ? "не выбран" : tour->getTransportCompany().getName())
-                   .arg(tour->calculateCost(), 0, 'f', 2);
+                   .arg(tour->calculateCost().toString());
     
     QMessageBox::information(this, "Информация о туре", info);
 }
@@ -1476,7 +1640,10 @@ void MainWindow::refreshTours() {
 }
 
 void MainWindow::searchTours() {
-    SearchDialog dialog(this, &tours_);
+    if (tourColumns_.size() != tours_.size()) {
+        tourDataChanged();
+    }
+    SearchDialog dialog(this, &tours_, &tourColumns_, &tourSearchIndex_);
     dialog.exec();
 }
 
@@ -1497,9 +1664,14 @@ void MainWindow::addOrder() {
     BookTourDialog dialog(this, &countries_, &hotels_, &transportCompanies_, &tours_);
     if (dialog.exec() == QDialog::Accepted) {
         Order order = dialog.getOrder();
+        order.setId(OrderIdAllocator::instance().allocate());
         orders_.add(order);
-        updateOrdersTable();
-        applyOrdersFilters();
+        orderStatusIndex_.insert(order.getId(), order.getStatus());
+        orderDataChanged();
+        if (!deferIfHidden(OrdersView)) {
+            updateOrdersTable();
+            applyOrdersFilters();
+        }
         statusBar()->showMessage("Заказ создан", 2000);
     }
 }
@@ -1522,20 +1694,39 @@ void MainWindow::processOrder() {
     Order* order = orders_.get(dataIndex);
     if (!order) return;
     
-    QString currentStatus = order->getStatus();
+    OrderStatus currentStatus = order->getStatus();
+    QVector<OrderStatus> transitions = OrderStatusInfo::allowedTransitions(currentStatus);
+    if (transitions.isEmpty()) {
+        QMessageBox::information(this, "Информация",
+            QString("Статус заказа #%1 ('%2') изменить нельзя").arg(order->getId()).arg(order->getStatusText()));
+        return;
+    }
     
-    QStringList statuses = {"В обработке", "Подтвержден", "Оплачен", "Завершен", "Отменен"};
+    QStringList statuses;
+    for (OrderStatus status : transitions) {
+        statuses << OrderStatusInfo::toString(status);
+    }
     
     bool ok;
-    QString newStatus = QInputDialog::getItem(this, "Изменение статуса заказа",
+    QString newStatusText = QInputDialog::getItem(this, "Изменение статуса заказа",
         QString("Выберите новый статус для заказа #%1\nТекущий статус: %2")
-            .arg(order->getId()).arg(currentStatus),
-        statuses, statuses.indexOf(currentStatus), false, &ok);
+            .arg(order->getId()).arg(order->getStatusText()),
+        statuses, 0, false, &ok);
     
-    if (ok && !newStatus.isEmpty() && newStatus != currentStatus) {
-        order->setStatus(newStatus);
-        updateOrdersTable();
-        applyOrdersFilters();
+    if (ok && !newStatusText.isEmpty()) {
+        OrderStatus newStatus = transitions.at(statuses.indexOf(newStatusText));
+        try {
+            order->transitionTo(newStatus);
+        } catch (const OrderStatusException& e) {
+            QMessageBox::warning(this, "Ошибка", e.what());
+            return;
+        }
+        orderStatusIndex_.update(order->getId(), newStatus);
+        orderDataChanged();
+        if (!deferIfHidden(OrdersView)) {
+            updateOrdersTable();
+            applyOrdersFilters();
+        }
         
         try {
             QString dataPath = "data";
@@ -1564,12 +1755,14 @@ void MainWindow::processOrder() {
                 QDir().mkpath(dataPath);
             }
             
-            fileManager_.saveOrders(orders_, dataPath + "/orders.txt");
+            saveOrderStatus(QDir(dataPath).absolutePath(), *order, !OrderStatusInfo::isFinal(currentStatus));
         } catch (const FileException& e) {
-            qWarning() << "Failed to auto-save orders after status change:" << e.what();
+            QMessageBox::warning(this, "Ошибка",
+                                 QString("Статус заказа изменен, но не сохранен: %1").arg(e.what()));
+            return;
         }
         
-        statusBar()->showMessage(QString("Статус заказа #%1 изменен на '%2' (сохранено)").arg(order->getId()).arg(newStatus), 2000);
+        statusBar()->showMessage(QString("Статус заказа #%1 изменен на '%2' (сохранено)").arg(order->getId()).arg(newStatusText), 2000);
     }
 }
 
@@ -1593,7 +1786,13 @@ void MainWindow::editOrder() {
     
     BookTourDialog dialog(this, &countries_, &hotels_, &transportCompanies_, &tours_);
     
-    dialog.setOrder(*order);
+    try {
+        dialog.setOrder(*order);
+    } catch (const FileException& e) {
+        QMessageBox::critical(this, "Ошибка",
+                              QString("Не удалось прочитать данные заказа: %1").arg(e.what()));
+        return;
+    }
     
     if (dialog.exec() == QDialog::Accepted) {
         Order newOrder = dialog.getOrder();
@@ -1603,8 +1802,10 @@ void MainWindow::editOrder() {
         order->setClientPhone(newOrder.getClientPhone());
         
         linkOrdersToursWithHotelsAndTransport();
-        updateOrdersTable();
-        applyOrdersFilters();
+        if (!deferIfHidden(OrdersView)) {
+            updateOrdersTable();
+            applyOrdersFilters();
+        }
         statusBar()->showMessage("Заказ обновлен", 2000);
     }
 }
@@ -1629,9 +1830,13 @@ void MainWindow::deleteOrder() {
     
     if (QMessageBox::question(this, "Подтверждение", 
         "Вы уверены, что хотите удалить этот заказ?") == QMessageBox::Yes) {
+        orderStatusIndex_.remove(order->getId());
         orders_.remove(dataIndex);
-        updateOrdersTable();
-        applyOrdersFilters();
+        orderDataChanged();
+        if (!deferIfHidden(OrdersView)) {
+            updateOrdersTable();
+            applyOrdersFilters();
+        }
         statusBar()->showMessage("Заказ удален", 2000);
     }
 }
@@ -1663,12 +1868,12 @@ void MainWindow::showOrderInfo() {
                           "Стоимость: %6 руб\n"
                           "Статус: %7")
                    .arg(order->getId())
-                   .arg(order->getTour().getName())
-                   .arg(order->getTour().getCountry())
+                   .arg(order->getTourName())
+                   .arg(order->getTourCountry())
                    .arg(order->getClientName())
                    .arg(order->getClientPhone())
-                   .arg(order->getTotalCost(), 0, 'f', 2)
-                   .arg(order->getStatus());
+                   .arg(order->getTotalCost().toString())
+                   .arg(order->getStatusText());
     
     QMessageBox::information(this, "Информация о заказе", info);
 }
@@ -1709,13 +1914,11 @@ void MainWindow::saveData() {
         
         QString absoluteDataPath = QDir(dataPath).absolutePath();
         
-        QString ordersSavePath = absoluteDataPath + "/orders.txt";
-        
         fileManager_.saveCountries(countries_, absoluteDataPath + "/countries.txt");
         fileManager_.saveHotels(hotels_, absoluteDataPath + "/hotels.txt");
         fileManager_.saveTransportCompanies(transportCompanies_, absoluteDataPath + "/transport_companies.txt");
         fileManager_.saveTours(tours_, absoluteDataPath + "/tours.txt");
-        fileManager_.saveOrders(orders_, ordersSavePath);
+        saveOrdersTo(absoluteDataPath);
         
         statusBar()->showMessage("Данные сохранены", 2000);
         QMessageBox::information(this, "Успех", 
@@ -1789,7 +1992,8 @@ QStringList MainWindow::checkRequiredFiles(const QString& dataPath) {
         dataPath + "/hotels.txt",
         dataPath + "/transport_companies.txt",
         dataPath + "/tours.txt",
-        dataPath + "/orders.txt"
+        OrderPartitions::existIn(dataPath) ? OrderPartitions::directoryIn(dataPath) + "/partitions.txt"
+                                           : dataPath + "/orders.txt"
     };
     
     for (const QString& file : requiredFiles) {
@@ -1822,10 +2026,170 @@ void MainWindow::clearAllData() {
     transportCompanies_.clear();
     tours_.clear();
     orders_.clear();
+    orderStatusIndex_.clear();
+    tourDataChanged();
+    orderDataChanged();
+}
+
+void MainWindow::openOrderPartitions(const QString& dataPath) {
+    orderPartitions_ = OrderPartitions(OrderPartitions::existIn(dataPath) ? dataPath : QString());
+    if (orderPartitions_.isActive()) {
+        orderPartitions_.readCatalog();
+    }
+}
+
+void MainWindow::saveOrderStatus(const QString& dataPath, const Order& order, bool wasOpen) {
+    bool partitioned = orderPartitions_.isActive() &&
+                       orderPartitions_.directory() == OrderPartitions::directoryIn(dataPath);
+    QString filename = partitioned ? orderPartitions_.filePathFor(order) : dataPath + "/orders.txt";
+    if (!filename.isEmpty() && QFile::exists(filename)) {
+        try {
+            RecordIndex index = fileManager_.openIndex(filename);
+            fileManager_.updateOrder(filename, index, order, orders_);
+            if (partitioned && wasOpen && !OrderPartitions::isOpen(order)) {
+                orderPartitions_.orderClosed(order);
+            }
+            return;
+        } catch (const FileException& e) {
+            qWarning() << "Cannot update order" << order.getId() << "in place, saving all orders:" << e.what();
+        }
+    }
+    saveOrdersTo(dataPath);
+}
+
+void MainWindow::saveOrdersTo(const QString& dataPath) {
+    if (orderPartitions_.isActive() && orderPartitions_.directory() == OrderPartitions::directoryIn(dataPath)) {
+        orderPartitions_.save(fileManager_, orders_);
+    } else {
+        fileManager_.saveOrders(orders_, dataPath + "/orders.txt");
+    }
+}
+
+void MainWindow::loadOrderArchive() {
+    if (!orderPartitions_.isActive() || orderPartitions_.loadedCount() == orderPartitions_.partitions().size()) {
+        statusBar()->showMessage("Все заказы уже загружены", 2000);
+        return;
+    }
+    
+    try {
+        int added = orderPartitions_.loadAll(fileManager_, orders_);
+        linkOrdersToursWithHotelsAndTransport();
+        reloadOrdersView();
+        statusBar()->showMessage(QString("Загружено заказов прошлых лет: %1").arg(added), 3000);
+    } catch (const FileException& e) {
+        QMessageBox::critical(this, "Ошибка",
+                              QString("Не удалось загрузить заказы прошлых лет: %1").arg(e.what()));
+    }
+}
+
+void MainWindow::archiveFinishedOrders() {
+    int archivable = std::count_if(orders_.getData().cbegin(), orders_.getData().cend(),
+                                   [](const Order& order) { return OrderArchive::isArchivable(order); });
+    QVector<int> coldPartitions;
+    if (orderPartitions_.isActive()) {
+        const QVector<OrderPartitions::Partition>& partitions = orderPartitions_.partitions();
+        for (int row = 0; row < partitions.size(); ++row) {
+            if (!partitions[row].loaded && partitions[row].openCount == 0) {
+                coldPartitions.append(row);
+                archivable += partitions[row].orderCount;
+            }
+        }
+    }
+    if (archivable == 0) {
+        statusBar()->showMessage("Нет завершённых или отменённых заказов", 2000);
+        return;
+    }
+    if (QMessageBox::question(this, "Архив",
+            QString("Переместить в архив завершённые и отменённые заказы (%1)?").arg(archivable))
+            != QMessageBox::Yes) {
+        return;
+    }
+    
+    try {
+        QString dataPath = QDir(findDataDirectory()).absolutePath();
+        orderPartitions_.load(fileManager_, orders_, coldPartitions);
+        OrderArchive archive(dataPath);
+        archive.open();
+        int moved = archive.archive(orders_);
+        saveOrdersTo(dataPath);
+        reloadOrdersView();
+        statusBar()->showMessage(QString("Перемещено в архив заказов: %1").arg(moved), 3000);
+    } catch (const FileException& e) {
+        QMessageBox::critical(this, "Ошибка",
+                              QString("Не удалось переместить заказы в архив: %1").arg(e.what()));
+    }
+}
+
+void MainWindow::searchOrderArchive() {
+    bool ok = false;
+    QString text = QInputDialog::getText(this, "Поиск в архиве",
+                                         "Номер заказа, клиент, телефон, email или тур:",
+                                         QLineEdit::Normal, QString(), &ok).trimmed();
+    if (!ok) {
+        return;
+    }
+    
+    try {
+        QString dataPath = QDir(findDataDirectory()).absolutePath();
+        OrderArchive archive(dataPath);
+        archive.open();
+        
+        OrderArchive::Query query;
+        bool isId = false;
+        int orderId = text.toInt(&isId);
+        if (isId) {
+            query.id = orderId;
+        } else {
+            query.text = text;
+        }
+        DataContainer<Order> found = archive.search(query);
+        if (found.isEmpty()) {
+            QMessageBox::information(this, "Поиск в архиве", "В архиве ничего не найдено");
+            return;
+        }
+        
+        const int shown = 20;
+        QStringList lines;
+        QVector<int> ids;
+        for (const auto& order : found.getData()) {
+            if (lines.size() < shown) {
+                lines << order.toString();
+            }
+            ids.append(order.getId());
+        }
+        if (found.size() > shown) {
+            lines << QString("... и ещё %1").arg(found.size() - shown);
+        }
+        if (QMessageBox::question(this, "Поиск в архиве",
+                QString("Найдено заказов: %1\n\n%2\n\nВернуть их в рабочие заказы?")
+                    .arg(found.size()).arg(lines.join("\n"))) != QMessageBox::Yes) {
+            return;
+        }
+        
+        int restored = archive.restore(ids, orders_);
+        saveOrdersTo(dataPath);
+        linkOrdersToursWithHotelsAndTransport();
+        reloadOrdersView();
+        statusBar()->showMessage(QString("Восстановлено заказов из архива: %1").arg(restored), 3000);
+    } catch (const FileException& e) {
+        QMessageBox::critical(this, "Ошибка",
+                              QString("Не удалось выполнить поиск в архиве: %1").arg(e.what()));
+    }
+}
+
+void MainWindow::reloadOrdersView() {
+    orderStatusIndex_.rebuild(orders_);
+    orderDataChanged();
+    if (!deferIfHidden(OrdersView, StaleAll)) {
+        updateOrdersTable();
+        updateOrdersFilterCombo();
+        applyOrdersFilters();
+    }
 }
 
 MainWindow::LoadResult MainWindow::loadAllDataFiles(const QString& dataPath) {
     LoadResult result;
+    fileManager_.takeChecksumWarnings();
     
     try {
         fileManager_.loadCountries(countries_, dataPath + "/countries.txt");
@@ -1858,30 +2222,66 @@ MainWindow::LoadResult MainWindow::loadAllDataFiles(const QString& dataPath) {
     }
     
     try {
-        QString ordersPath = dataPath + "/orders.txt";
-        QString absoluteOrdersPath = QDir(ordersPath).absolutePath();
-        fileManager_.loadOrders(orders_, absoluteOrdersPath);
+        if (orderPartitions_.isActive()) {
+            orderPartitions_.loadRecent(fileManager_, orders_);
+        } else {
+            QString ordersPath = dataPath + "/orders.txt";
+            QString absoluteOrdersPath = QDir(ordersPath).absolutePath();
+            fileManager_.loadOrders(orders_, absoluteOrdersPath);
+        }
         result.orders = orders_.size();
         linkOrdersToursWithHotelsAndTransport();
+        orderStatusIndex_.rebuild(orders_);
     } catch (const FileException& e) {
         result.errors << QString("Заказы: %1").arg(e.what());
     }
     
+    result.errors = fileManager_.takeChecksumWarnings() + result.errors;
     return result;
 }
 
-void MainWindow::showLoadResults(const LoadResult& result, const QString& dataPath) {
-    updateCountriesTable();
-    updateHotelsTable();
-    updateTransportCompaniesTable();
-    updateToursTable();
-    updateOrdersTable();
+bool MainWindow::loadSnapshot(const SnapshotCache& snapshot, LoadResult& result) {
+    waitForSnapshotThread();
+    if (!snapshot.load(countries_, hotels_, transportCompanies_, tours_, orders_)) {
+        return false;
+    }
     
-    updateCountriesFilterCombo();
-    updateHotelsFilterCombos();
-    updateTransportFilterCombo();
-    updateToursFilterCombo();
-    updateOrdersFilterCombo();
+    orderPartitions_.markLoaded(orders_);
+    linkOrdersToursWithHotelsAndTransport();
+    orderStatusIndex_.rebuild(orders_);
+    result.countries = countries_.size();
+    result.hotels = hotels_.size();
+    result.companies = transportCompanies_.size();
+    result.tours = tours_.size();
+    result.orders = orders_.size();
+    return true;
+}
+
+void MainWindow::saveSnapshotInBackground(const SnapshotCache& snapshot, const QByteArray& fingerprint) {
+    waitForSnapshotThread();
+    
+    snapshotThread_ = QThread::create([snapshot, fingerprint, countries = countries_, hotels = hotels_,
+                                       companies = transportCompanies_, tours = tours_, orders = orders_]() {
+        if (!snapshot.save(fingerprint, countries, hotels, companies, tours, orders)) {
+            snapshot.remove();
+        }
+    });
+    connect(snapshotThread_, &QThread::finished, snapshotThread_, &QObject::deleteLater);
+    snapshotThread_->start(QThread::LowPriority);
+}
+
+void MainWindow::waitForSnapshotThread() {
+    if (snapshotThread_) {
+        snapshotThread_->wait();
+    }
+}
+
+void MainWindow::showLoadResults(const LoadResult& result, const QString& dataPath) {
+    tourDataChanged();
+    orderDataChanged();
+    staleViews_.fill(StaleAll);
+    refreshView(viewForTab(ui->tabWidget->currentIndex()));
+    idleRefreshTimer_->start();
     
     int totalItems = result.countries + result.hotels + result.companies + result.tours + result.orders;
     
@@ -1934,7 +2334,17 @@ void MainWindow::loadData() {
         }
         
         clearAllData();
-        LoadResult result = loadAllDataFiles(dataPath);
+        openOrderPartitions(dataPath);
+        SnapshotCache snapshot(SnapshotCache::defaultCachePath(dataPath), SnapshotCache::sourceFilesIn(dataPath));
+        LoadResult result;
+        if (!loadSnapshot(snapshot, result)) {
+            QByteArray fingerprint = snapshot.fingerprint();
+            clearAllData();
+            result = loadAllDataFiles(dataPath);
+            if (result.errors.isEmpty()) {
+                saveSnapshotInBackground(snapshot, fingerprint);
+            }
+        }
         showLoadResults(result, dataPath);
     } catch (const FileException& e) {
         QMessageBox::critical(this, "Ошибка загрузки", 
@@ -1943,40 +2353,111 @@ void MainWindow::loadData() {
     }
 }
 
-void MainWindow::onTabChanged([[maybe_unused]] int index) {
+void MainWindow::onTabChanged(int index) {
+    View view = viewForTab(index);
+    if (view != ViewCount && isViewStale(view)) {
+        refreshView(view);
+    }
+}
+
+MainWindow::View MainWindow::viewForTab(int index) const {
+    QWidget* page = ui->tabWidget->widget(index);
+    if (page == ui->countriesTab) return CountriesView;
+    if (page == ui->hotelsTab) return HotelsView;
+    if (page == ui->transportTab) return TransportView;
+    if (page == ui->toursTab) return ToursView;
+    if (page == ui->ordersTab) return OrdersView;
+    return ViewCount;
+}
+
+bool MainWindow::isViewVisible(View view) const {
+    return viewForTab(ui->tabWidget->currentIndex()) == view;
+}
+
+bool MainWindow::deferIfHidden(View view, int parts) {
+    if (isViewVisible(view)) {
+        return false;
+    }
+    staleViews_[view] |= parts;
+    idleRefreshTimer_->start();
+    return true;
+}
+
+void MainWindow::refreshView(View view) {
+    if (view == ViewCount) {
+        return;
+    }
+    int parts = staleViews_[view];
+    staleViews_[view] = 0;
+    
+    switch (view) {
+    case CountriesView:
+        if (parts & StaleTable) updateCountriesTable();
+        if (parts & StaleFilters) updateCountriesFilterCombo();
+        break;
+    case HotelsView:
+        if (parts & StaleTable) updateHotelsTable();
+        if (parts & StaleFilters) updateHotelsFilterCombos();
+        break;
+    case TransportView:
+        if (parts & StaleTable) updateTransportCompaniesTable();
+        if (parts & StaleFilters) updateTransportFilterCombo();
+        break;
+    case ToursView:
+        if (parts & StaleTable) updateToursTable();
+        if (parts & StaleFilters) updateToursFilterCombo();
+        break;
+    case OrdersView:
+        if (parts & StaleTable) updateOrdersTable();
+        if (parts & StaleFilters) updateOrdersFilterCombo();
+        break;
+    case ViewCount:
+        break;
+    }
+}
+
+void MainWindow::refreshNextStaleView() {
+    for (int view = 0; view < ViewCount; ++view) {
+        if (isViewStale(static_cast<View>(view))) {
+            refreshView(static_cast<View>(view));
+            break;
+        }
+    }
+    for (int view = 0; view < ViewCount; ++view) {
+        if (isViewStale(static_cast<View>(view))) {
+            idleRefreshTimer_->start();
+            break;
+        }
+    }
 }
 
 void MainWindow::updateCountriesFilterCombo() {
     ui->filterCountryCombo->clear();
     ui->filterCountryCombo->addItem("Все");
     
-    QSet<QString> continents;
+    QMap<QString, Symbol> continents;
     for (const auto& country : countries_.getData()) {
         if (!country.getContinent().isEmpty()) {
-            continents.insert(country.getContinent());
+            continents.insert(country.getContinent(), country.getContinentSymbol());
         }
     }
     
-    QStringList sortedContinents = continents.values();
-    sortedContinents.sort();
-    for (const QString& continent : sortedContinents) {
-        ui->filterCountryCombo->addItem(continent);
+    for (auto it = continents.cbegin(); it != continents.cend(); ++it) {
+        FilterComboUpdater::addFacetItem(ui->filterCountryCombo, it.key(), it.value().id());
     }
     
     ui->filterCountryCurrencyCombo->clear();
     ui->filterCountryCurrencyCombo->addItem("Все");
     
-    QSet<QString> currencies;
+    QMap<QString, Symbol> currencies;
     for (const auto& country : countries_.getData()) {
         if (!country.getCurrency().isEmpty()) {
-            currencies.insert(country.getCurrency());
+            currencies.insert(country.getCurrency(), country.getCurrencySymbol());
         }
     }
     
-    QStringList sortedCurrencies = currencies.values();
-    sortedCurrencies.sort();
-    for (const QString& currency : sortedCurrencies) {
-        ui->filterCountryCurrencyCombo->addItem(currency);
+    for (auto it = currencies.cbegin(); it != currencies.cend(); ++it) {
+        FilterComboUpdater::addFacetItem(ui->filterCountryCurrencyCombo, it.key(), it.value().id());
     }
 }
 
@@ -1984,17 +2465,15 @@ void MainWindow::updateHotelsFilterCombos() {
     ui->filterHotelCountryCombo->clear();
     ui->filterHotelCountryCombo->addItem("Все");
     
-    QSet<QString> countries;
+    QMap<QString, Symbol> countries;
     for (const auto& hotel : hotels_.getData()) {
         if (!hotel.getCountry().isEmpty()) {
-            countries.insert(hotel.getCountry());
+            countries.insert(hotel.getCountry(), hotel.getCountrySymbol());
         }
     }
     
-    QStringList sortedCountries = countries.values();
-    sortedCountries.sort();
-    for (const QString& country : sortedCountries) {
-        ui->filterHotelCountryCombo->addItem(country);
+    for (auto it = countries.cbegin(); it != countries.cend(); ++it) {
+        FilterComboUpdater::addFacetItem(ui->filterHotelCountryCombo, it.key(), it.value().id());
     }
     
     ui->filterHotelStarsCombo->clear();
@@ -2008,7 +2487,8 @@ void MainWindow::updateHotelsFilterCombos() {
     QList<int> sortedStars = stars.values();
     std::sort(sortedStars.begin(), sortedStars.end());
     for (int star : sortedStars) {
-        ui->filterHotelStarsCombo->addItem(QString::number(star));
+        FilterComboUpdater::addFacetItem(ui->filterHotelStarsCombo, QString::number(star),
+                                         static_cast<quint32>(star));
     }
 }
 
@@ -2016,18 +2496,17 @@ void MainWindow::updateTransportFilterCombo() {
     ui->filterTransportTypeCombo->clear();
     ui->filterTransportTypeCombo->addItem("Все");
     
-    QSet<QString> transportTypes;
+    QMap<QString, int> transportTypes;
     for (const auto& company : transportCompanies_.getData()) {
         QString typeStr = TransportCompany::transportTypeToString(company.getTransportType());
         if (!typeStr.isEmpty()) {
-            transportTypes.insert(typeStr);
+            transportTypes.insert(typeStr, static_cast<int>(company.getTransportType()));
         }
     }
     
-    QStringList sortedTypes = transportTypes.values();
-    sortedTypes.sort();
-    for (const QString& type : sortedTypes) {
-        ui->filterTransportTypeCombo->addItem(type);
+    for (auto it = transportTypes.cbegin(); it != transportTypes.cend(); ++it) {
+        FilterComboUpdater::addFacetItem(ui->filterTransportTypeCombo, it.key(),
+                                         static_cast<quint32>(it.value()));
     }
 }
 
@@ -2035,28 +2514,64 @@ void MainWindow::updateToursFilterCombo() {
     ui->filterTourCountryCombo->clear();
     ui->filterTourCountryCombo->addItem("Все");
     
-    QSet<QString> countries;
+    QMap<QString, Symbol> countries;
     for (const auto& tour : tours_.getData()) {
         if (!tour.getCountry().isEmpty()) {
-            countries.insert(tour.getCountry());
+            countries.insert(tour.getCountry(), tour.getCountrySymbol());
         }
     }
     
-    QStringList sortedCountries = countries.values();
-    sortedCountries.sort();
-    for (const QString& country : sortedCountries) {
-        ui->filterTourCountryCombo->addItem(country);
+    for (auto it = countries.cbegin(); it != countries.cend(); ++it) {
+        FilterComboUpdater::addFacetItem(ui->filterTourCountryCombo, it.key(), it.value().id());
     }
 }
 
 void MainWindow::updateOrdersFilterCombo() {
     ui->filterOrderStatusCombo->clear();
     ui->filterOrderStatusCombo->addItem("Все");
-    ui->filterOrderStatusCombo->addItem("В обработке");
-    ui->filterOrderStatusCombo->addItem("Подтвержден");
-    ui->filterOrderStatusCombo->addItem("Оплачен");
-    ui->filterOrderStatusCombo->addItem("Завершен");
-    ui->filterOrderStatusCombo->addItem("Отменен");
+    FilterComboUpdater::addFacetItem(ui->filterOrderStatusCombo, "Неоплаченные", UnpaidStatusFilter);
+    for (OrderStatus status : OrderStatusInfo::all()) {
+        FilterComboUpdater::addFacetItem(ui->filterOrderStatusCombo, OrderStatusInfo::toString(status),
+                                         static_cast<int>(status));
+    }
+    updateOrderStatusCounts();
+}
+
+void MainWindow::updateOrderStatusCounts() {
+    QComboBox* combo = ui->filterOrderStatusCombo;
+    for (int i = 0; i < combo->count(); ++i) {
+        QVariant data = combo->itemData(i);
+        int count = orderStatusIndex_.size();
+        if (data.isValid()) {
+            int code = data.toInt();
+            count = code == UnpaidStatusFilter ? orderStatusIndex_.unpaidCount()
+                                               : orderStatusIndex_.count(static_cast<OrderStatus>(code));
+        }
+        RowMask mask = orderColumns_.allRows();
+        if (data.isValid()) {
+            applyOrderStatusFilter(data.toInt(), mask);
+        }
+        Money total(orderColumns_.totalCost(mask));
+        combo->setItemData(i, QString("Заказов: %1, сумма: %2").arg(count).arg(total.toDisplayString()), Qt::ToolTipRole);
+    }
+}
+
+void MainWindow::applyOrderStatusFilter(int filterCode, RowMask& mask) const {
+    if (filterCode == UnpaidStatusFilter) {
+        orderColumns_.filterUnpaid(mask);
+    } else {
+        orderColumns_.filterStatus(static_cast<OrderStatus>(filterCode), mask);
+    }
+}
+
+bool MainWindow::isRowInMask(QTableWidget* table, int row, const RowMask& mask) const {
+    QTableWidgetItem* item = table->item(row, 0);
+    if (!item) {
+        return false;
+    }
+    
+    int dataIndex = item->data(Qt::UserRole).toInt();
+    return dataIndex >= 0 && dataIndex < mask.size() && mask[dataIndex];
 }
 
 bool MainWindow::matchesSearchInTable(QTableWidget* table, int row, const QString& searchText, int excludeColumn) const {
@@ -2083,296 +2598,247 @@ bool MainWindow::matchesSearchInTable(QTableWidget* table, int row, const QStrin
     return false;
 }
 
-double MainWindow::extractCostFromTableItem(QTableWidget* table, int row, int column) const {
-    QTableWidgetItem* costItem = table->item(row, column);
-    if (!costItem) {
-        return 0.0;
+void MainWindow::rebuildCountryFacets() {
+    QVector<quint32> continents;
+    QVector<quint32> currencies;
+    continents.reserve(countries_.size());
+    currencies.reserve(countries_.size());
+    for (const auto& country : countries_.getData()) {
+        continents.append(country.getContinentSymbol().id());
+        currencies.append(country.getCurrencySymbol().id());
     }
     
-    QVariant sortData = costItem->data(Qt::UserRole);
-    if (sortData.isValid()) {
-        return sortData.toDouble();
+    countryFacets_.reset(countries_.size());
+    countryFacets_.addFacet(continents);
+    countryFacets_.addFacet(currencies);
+}
+
+void MainWindow::rebuildHotelFacets() {
+    QVector<quint32> countries;
+    QVector<quint32> stars;
+    countries.reserve(hotels_.size());
+    stars.reserve(hotels_.size());
+    for (const auto& hotel : hotels_.getData()) {
+        countries.append(hotel.getCountrySymbol().id());
+        stars.append(static_cast<quint32>(hotel.getStars()));
     }
     
-    QString costText = costItem->text();
-    costText.remove(" руб");
-    return costText.toDouble();
+    hotelFacets_.reset(hotels_.size());
+    hotelFacets_.addFacet(countries);
+    hotelFacets_.addFacet(stars);
 }
 
-void MainWindow::applyCountriesFilters() {
-    QString searchText = ui->searchCountryEdit->text().toLower();
-    QString filterContinent = ui->filterCountryCombo->currentText();
-    QString filterCurrency = ui->filterCountryCurrencyCombo->currentText();
+void MainWindow::rebuildTransportFacets() {
+    QVector<quint32> types;
+    types.reserve(transportCompanies_.size());
+    for (const auto& company : transportCompanies_.getData()) {
+        types.append(static_cast<quint32>(company.getTransportType()));
+    }
     
-    for (int row = 0; row < ui->countriesTable->rowCount(); ++row) {
-        bool visible = matchesSearchInTable(ui->countriesTable, row, searchText);
-        
-        if (visible && filterContinent != "Все") {
-            QTableWidgetItem* continentItem = ui->countriesTable->item(row, 1);
-            if (!continentItem || continentItem->text() != filterContinent) {
-                visible = false;
-            }
+    transportFacets_.reset(transportCompanies_.size());
+    transportFacets_.addFacet(types);
+}
+
+void MainWindow::rebuildTourFacets() {
+    tourFacets_.reset(tourColumns_.size());
+    tourFacets_.addFacet(tourColumns_.countryIds());
+}
+
+void MainWindow::tourDataChanged() {
+    tourColumns_.rebuild(tours_);
+    tourSearchIndex_.invalidate();
+    rebuildTourFacets();
+}
+
+void MainWindow::orderDataChanged() {
+    orderColumns_.rebuild(orders_);
+    rebuildOrderFacets();
+}
+
+void MainWindow::rebuildOrderFacets() {
+    QVector<quint32> statuses;
+    statuses.reserve(orderColumns_.size());
+    for (quint8 status : orderColumns_.statuses()) {
+        statuses.append(status);
+    }
+    
+    orderFacets_.reset(orderColumns_.size());
+    orderFacets_.addFacet(statuses);
+}
+
+RowMask MainWindow::searchMask(QTableWidget* table, int rowCount, const QString& searchText,
+                               int excludeColumn) const {
+    if (searchText.isEmpty()) {
+        return RowMask(rowCount, 1);
+    }
+    
+    RowMask mask(rowCount, 0);
+    for (int row = 0; row < table->rowCount(); ++row) {
+        QTableWidgetItem* item = table->item(row, 0);
+        if (!item) {
+            continue;
         }
-        
-        if (visible && filterCurrency != "Все") {
-            QTableWidgetItem* currencyItem = ui->countriesTable->item(row, 3);
-            if (!currencyItem || currencyItem->text() != filterCurrency) {
-                visible = false;
-            }
+        int dataIndex = item->data(Qt::UserRole).toInt();
+        if (dataIndex >= 0 && dataIndex < rowCount) {
+            mask[dataIndex] = matchesSearchInTable(table, row, searchText, excludeColumn) ? 1 : 0;
         }
-        
-        ui->countriesTable->setRowHidden(row, !visible);
+    }
+    return mask;
+}
+
+void MainWindow::selectFacet(FacetCounter& facets, int facet, const QVariant& key) {
+    if (key.isValid()) {
+        facets.select(facet, key.toUInt());
+    } else {
+        facets.clearSelection(facet);
     }
 }
 
+void MainWindow::applyFacetVisibility(QTableWidget* table, const FacetCounter& facets) {
+    RowMask visible = facets.matchingMask();
+    for (int row = 0; row < table->rowCount(); ++row) {
+        table->setRowHidden(row, !isRowInMask(table, row, visible));
+    }
+}
+
+void MainWindow::updateFacetLabels(QComboBox* combo, const FacetCounter& facets, int facet) {
+    FilterComboUpdater::updateFacetCounts(combo, [&facets, facet](const QVariant& key) {
+        return key.isValid() ? facets.count(facet, key.toUInt()) : facets.total(facet);
+    });
+}
+
+void MainWindow::applyCountriesFilters() {
+    if (countryFacets_.rowCount() != countries_.size()) {
+        rebuildCountryFacets();
+    }
+    
+    QString searchText = ui->searchCountryEdit->text().toLower();
+    
+    selectFacet(countryFacets_, ContinentFacet, ui->filterCountryCombo->currentData());
+    selectFacet(countryFacets_, CurrencyFacet, ui->filterCountryCurrencyCombo->currentData());
+    countryFacets_.setBaseMask(searchMask(ui->countriesTable, countries_.size(), searchText));
+    
+    applyFacetVisibility(ui->countriesTable, countryFacets_);
+    updateFacetLabels(ui->filterCountryCombo, countryFacets_, ContinentFacet);
+    updateFacetLabels(ui->filterCountryCurrencyCombo, countryFacets_, CurrencyFacet);
+}
+
 void MainWindow::applyHotelsFilters() {
+    if (hotelFacets_.rowCount() != hotels_.size()) {
+        rebuildHotelFacets();
+    }
+    
     QString searchText = ui->searchHotelEdit->text().toLower();
-    QString filterCountry = ui->filterHotelCountryCombo->currentText();
-    QString filterStars = ui->filterHotelStarsCombo->currentText();
     
-    for (int row = 0; row < ui->hotelsTable->rowCount(); ++row) {
-        bool visible = matchesSearchInTable(ui->hotelsTable, row, searchText);
-        
-        if (visible && filterCountry != "Все") {
-            QTableWidgetItem* countryItem = ui->hotelsTable->item(row, 1);
-            if (!countryItem || countryItem->text() != filterCountry) {
-                visible = false;
-            }
-        }
-        
-        if (visible && filterStars != "Все") {
-            QTableWidgetItem* starsItem = ui->hotelsTable->item(row, 2);
-            if (!starsItem || starsItem->text() != filterStars) {
-                visible = false;
-            }
-        }
-        
-        ui->hotelsTable->setRowHidden(row, !visible);
-    }
+    selectFacet(hotelFacets_, HotelCountryFacet, ui->filterHotelCountryCombo->currentData());
+    selectFacet(hotelFacets_, StarsFacet, ui->filterHotelStarsCombo->currentData());
+    hotelFacets_.setBaseMask(searchMask(ui->hotelsTable, hotels_.size(), searchText));
+    
+    applyFacetVisibility(ui->hotelsTable, hotelFacets_);
+    updateFacetLabels(ui->filterHotelCountryCombo, hotelFacets_, HotelCountryFacet);
+    updateFacetLabels(ui->filterHotelStarsCombo, hotelFacets_, StarsFacet);
 }
 
 void MainWindow::applyTransportFilters() {
+    if (transportFacets_.rowCount() != transportCompanies_.size()) {
+        rebuildTransportFacets();
+    }
+    
     QString searchText = ui->searchTransportEdit->text().toLower();
-    QString filterType = ui->filterTransportTypeCombo->currentText();
     
-    for (int row = 0; row < ui->transportTable->rowCount(); ++row) {
-        bool visible = matchesSearchInTable(ui->transportTable, row, searchText);
-        
-        if (visible && filterType != "Все") {
-            QTableWidgetItem* typeItem = ui->transportTable->item(row, 1);
-            if (!typeItem || typeItem->text() != filterType) {
-                visible = false;
-            }
-        }
-        
-        ui->transportTable->setRowHidden(row, !visible);
-    }
+    selectFacet(transportFacets_, TransportTypeFacet, ui->filterTransportTypeCombo->currentData());
+    transportFacets_.setBaseMask(searchMask(ui->transportTable, transportCompanies_.size(), searchText));
+    
+    applyFacetVisibility(ui->transportTable, transportFacets_);
+    updateFacetLabels(ui->filterTransportTypeCombo, transportFacets_, TransportTypeFacet);
 }
 
 void MainWindow::applyToursFilters() {
+    if (tourFacets_.rowCount() != tourColumns_.size()) {
+        rebuildTourFacets();
+    }
+    
     QString searchText = ui->searchTourEdit->text().toLower();
-    QString filterCountry = ui->filterTourCountryCombo->currentText();
     QString minPriceText = ui->filterTourMinPriceEdit->text();
     QString maxPriceText = ui->filterTourMaxPriceEdit->text();
     
-    bool hasMinPrice = !minPriceText.isEmpty();
-    bool hasMaxPrice = !maxPriceText.isEmpty();
-    double minPrice = hasMinPrice ? minPriceText.toDouble() : 0.0;
-    double maxPrice = hasMaxPrice ? maxPriceText.toDouble() : std::numeric_limits<double>::max();
+    Money minPrice;
+    Money maxPrice(std::numeric_limits<qint64>::max());
+    bool hasMinPrice = Money::tryParse(minPriceText, minPrice);
+    bool hasMaxPrice = Money::tryParse(maxPriceText, maxPrice);
     
-    for (int row = 0; row < ui->toursTable->rowCount(); ++row) {
-        bool visible = matchesSearchInTable(ui->toursTable, row, searchText);
-        
-        if (visible && filterCountry != "Все") {
-            QTableWidgetItem* countryItem = ui->toursTable->item(row, 1);
-            if (!countryItem || countryItem->text() != filterCountry) {
-                visible = false;
-            }
-        }
-        
-        if (visible && (hasMinPrice || hasMaxPrice)) {
-            double cost = extractCostFromTableItem(ui->toursTable, row, 4);
-            if (cost < minPrice || cost > maxPrice) {
-                visible = false;
-            }
-        }
-        
-        ui->toursTable->setRowHidden(row, !visible);
+    RowMask mask = searchMask(ui->toursTable, tourColumns_.size(), searchText);
+    if (hasMinPrice || hasMaxPrice) {
+        tourColumns_.filterCost(minPrice.kopecks(), maxPrice.kopecks(), mask);
     }
+    
+    selectFacet(tourFacets_, TourCountryFacet, ui->filterTourCountryCombo->currentData());
+    tourFacets_.setBaseMask(mask);
+    
+    applyFacetVisibility(ui->toursTable, tourFacets_);
+    updateFacetLabels(ui->filterTourCountryCombo, tourFacets_, TourCountryFacet);
 }
 
 void MainWindow::applyOrdersFilters() {
+    if (orderFacets_.rowCount() != orderColumns_.size()) {
+        rebuildOrderFacets();
+    }
+    
     QString searchText = ui->searchOrderEdit->text().toLower();
-    QString filterStatus = ui->filterOrderStatusCombo->currentText();
+    QVariant filterStatus = ui->filterOrderStatusCombo->currentData();
     QString minCostText = ui->filterOrderMinCostEdit->text();
     QString maxCostText = ui->filterOrderMaxCostEdit->text();
     
-    bool hasMinCost = !minCostText.isEmpty();
-    bool hasMaxCost = !maxCostText.isEmpty();
-    double minCost = hasMinCost ? minCostText.toDouble() : 0.0;
-    double maxCost = hasMaxCost ? maxCostText.toDouble() : std::numeric_limits<double>::max();
+    Money minCost;
+    Money maxCost(std::numeric_limits<qint64>::max());
+    bool hasMinCost = Money::tryParse(minCostText, minCost);
+    bool hasMaxCost = Money::tryParse(maxCostText, maxCost);
     
     int actionsColumn = ui->ordersTable->columnCount() - 1;
-    for (int row = 0; row < ui->ordersTable->rowCount(); ++row) {
-        bool visible = matchesSearchInTable(ui->ordersTable, row, searchText, actionsColumn);
-        
-        if (visible && filterStatus != "Все") {
-            QTableWidgetItem* statusItem = ui->ordersTable->item(row, 5);
-            if (!statusItem || statusItem->text() != filterStatus) {
-                visible = false;
-            }
-        }
-        
-        if (visible && (hasMinCost || hasMaxCost)) {
-            double cost = extractCostFromTableItem(ui->ordersTable, row, 4);
-            if (cost < minCost || cost > maxCost) {
-                visible = false;
-            }
-        }
-        
-        ui->ordersTable->setRowHidden(row, !visible);
-    }
-}
-
-QString MainWindow::findCountryCapital(const QString& countryName) const {
-    for (const auto& country : countries_.getData()) {
-        if (country.getName() == countryName) {
-            return country.getCapital();
-        }
-    }
-    return "";
-}
-
-QSet<QString> MainWindow::collectTargetCities(const QString& tourCountry, const QString& capital) const {
-    QSet<QString> targetCities;
-    
-    if (!capital.isEmpty()) {
-        targetCities.insert(capital);
+    RowMask mask = searchMask(ui->ordersTable, orderColumns_.size(), searchText, actionsColumn);
+    if (hasMinCost || hasMaxCost) {
+        orderColumns_.filterCost(minCost.kopecks(), maxCost.kopecks(), mask);
     }
     
-    for (const auto& hotel : hotels_.getData()) {
-        if (hotel.getCountry() != tourCountry || hotel.getRoomCount() == 0) {
-            continue;
-        }
-        
-        QString address = hotel.getAddress();
-        if (address.isEmpty()) {
-            continue;
-        }
-        
-        QString city = address.split(',').first().trimmed();
-        if (!city.isEmpty()) {
-            targetCities.insert(city);
-        }
-    }
-    
-    return targetCities;
-}
-
-Hotel* MainWindow::findHotelForTour(const QString& tourCountry) {
-    for (auto& hotel : hotels_.getData()) {
-        if (hotel.getCountry() == tourCountry && hotel.getRoomCount() > 0) {
-            return &hotel;
-        }
-    }
-    return nullptr;
-}
-
-bool MainWindow::matchesCity(const QString& arrivalCity, const QSet<QString>& targetCities, 
-                            const QString& capital, const QString& tourCountry) const {
-    QString arrivalCityLower = arrivalCity.toLower();
-    
-    if (!targetCities.isEmpty()) {
-        for (const QString& targetCity : targetCities) {
-            QString targetCityLower = targetCity.toLower();
-            if (arrivalCity == targetCity || 
-                arrivalCityLower == targetCityLower ||
-                arrivalCityLower.contains(targetCityLower) ||
-                targetCityLower.contains(arrivalCityLower)) {
-                return true;
+    if (filterStatus.isValid() && filterStatus.toInt() == UnpaidStatusFilter) {
+        QSet<quint32> unpaid;
+        for (OrderStatus status : OrderStatusInfo::all()) {
+            if (OrderStatusInfo::isUnpaid(status)) {
+                unpaid.insert(static_cast<quint32>(status));
             }
         }
+        orderFacets_.select(OrderStatusFacet, unpaid);
+    } else {
+        selectFacet(orderFacets_, OrderStatusFacet, filterStatus);
     }
+    orderFacets_.setBaseMask(mask);
     
-    if (!capital.isEmpty()) {
-        QString capitalLower = capital.toLower();
-        if (arrivalCityLower == capitalLower ||
-            arrivalCityLower.contains(capitalLower) || 
-            capitalLower.contains(arrivalCityLower)) {
-            return true;
+    applyFacetVisibility(ui->ordersTable, orderFacets_);
+    FilterComboUpdater::updateFacetCounts(ui->filterOrderStatusCombo, [this](const QVariant& key) {
+        if (!key.isValid()) {
+            return orderFacets_.total(OrderStatusFacet);
         }
-    }
-    
-    if (tourCountry == "ОАЭ") {
-        if (arrivalCityLower.contains("дубай") || arrivalCityLower.contains("абу-даби") || 
-            arrivalCityLower.contains("abu dhabi") || arrivalCityLower.contains("dubai")) {
-            return true;
+        if (key.toInt() != UnpaidStatusFilter) {
+            return orderFacets_.count(OrderStatusFacet, key.toUInt());
         }
-    }
-    
-    return false;
-}
-
-bool MainWindow::findTransportForTour(Tour& tour, const QSet<QString>& targetCities, 
-                                       const QString& capital, const QDate& tourStartDate) {
-    for (auto& company : transportCompanies_.getData()) {
-        for (int i = 0; i < company.getScheduleCount(); ++i) {
-            TransportSchedule* schedule = company.getSchedule(i);
-            if (!schedule) {
-                continue;
-            }
-            
-            QString arrivalCity = schedule->arrivalCity;
-            QDate scheduleDepartureDate = schedule->departureDate;
-            
-            if (!matchesCity(arrivalCity, targetCities, capital, tour.getCountry())) {
-                continue;
-            }
-            
-            bool dateMatches = !tourStartDate.isValid() || 
-                              !scheduleDepartureDate.isValid() ||
-                              scheduleDepartureDate <= tourStartDate;
-            
-            if (dateMatches || !tourStartDate.isValid()) {
-                tour.setTransportCompany(company);
-                tour.setTransportSchedule(*schedule);
-                return true;
+        int unpaid = 0;
+        for (OrderStatus status : OrderStatusInfo::all()) {
+            if (OrderStatusInfo::isUnpaid(status)) {
+                unpaid += orderFacets_.count(OrderStatusFacet, static_cast<quint32>(status));
             }
         }
-    }
-    return false;
+        return unpaid;
+    });
 }
 
 void MainWindow::linkToursWithHotelsAndTransport() {
-    for (auto& tour : tours_.getData()) {
-        QString tourCountry = tour.getCountry();
-        QDate tourStartDate = tour.getStartDate();
-        
-        QString capital = findCountryCapital(tourCountry);
-        QSet<QString> targetCities = collectTargetCities(tourCountry, capital);
-        
-        Hotel* selectedHotel = findHotelForTour(tourCountry);
-        if (selectedHotel) {
-            tour.setHotel(*selectedHotel);
-        }
-        
-        findTransportForTour(tour, targetCities, capital, tourStartDate);
-    }
+    tourLinker_.linkTours();
+    tourDataChanged();
 }
 
 void MainWindow::linkOrdersToursWithHotelsAndTransport() {
-    for (auto& order : orders_.getData()) {
-        Tour tourInOrder = order.getTour();
-        QString tourName = tourInOrder.getName();
-        QString tourCountry = tourInOrder.getCountry();
-        
-        for (const auto& fullTour : tours_.getData()) {
-            if (fullTour.getName() == tourName && fullTour.getCountry() == tourCountry) {
-                order.setTour(fullTour);
-                break;
-            }
-        }
-    }
+    tourLinker_.linkOrders();
+    orderDataChanged();
 }
 
 void MainWindow::onCountriesHeaderClicked(int logicalIndex) {
@@ -2595,28 +3061,32 @@ void MainWindow::initializeActions() {
     actions_["refreshCountries"] = new RefreshCountriesAction();
     
     connect(actions_["addCountry"], &Action::executed, this, [this]() {
-        updateCountriesTable();
-        filterComboUpdater_->updateCountriesFilterCombo(ui->filterCountryCombo,
-                                                         ui->filterCountryCurrencyCombo,
-                                                         countries_);
+        if (!deferIfHidden(CountriesView, StaleAll)) {
+            updateCountriesTable();
+            filterComboUpdater_->updateCountriesFilterCombo(ui->filterCountryCombo,
+                                                             ui->filterCountryCurrencyCombo,
+                                                             countries_);
+        }
         statusBar()->showMessage("Страна добавлена", 2000);
     });
     connect(actions_["editCountry"], &Action::executed, this, [this]() {
-        updateCountriesTable();
-        filterComboUpdater_->updateCountriesFilterCombo(ui->filterCountryCombo,
-                                                         ui->filterCountryCurrencyCombo,
-                                                         countries_);
-        filterManager_->applyCountriesFilters(ui->countriesTable, ui->searchCountryEdit,
-                                              ui->filterCountryCombo, ui->filterCountryCurrencyCombo);
+        if (!deferIfHidden(CountriesView, StaleAll)) {
+            updateCountriesTable();
+            filterComboUpdater_->updateCountriesFilterCombo(ui->filterCountryCombo,
+                                                             ui->filterCountryCurrencyCombo,
+                                                             countries_);
+            applyCountriesFilters();
+        }
         statusBar()->showMessage("Страна обновлена", 2000);
     });
     connect(actions_["deleteCountry"], &Action::executed, this, [this]() {
-        updateCountriesTable();
-        filterComboUpdater_->updateCountriesFilterCombo(ui->filterCountryCombo,
-                                                         ui->filterCountryCurrencyCombo,
-                                                         countries_);
-        filterManager_->applyCountriesFilters(ui->countriesTable, ui->searchCountryEdit,
-                                              ui->filterCountryCombo, ui->filterCountryCurrencyCombo);
+        if (!deferIfHidden(CountriesView, StaleAll)) {
+            updateCountriesTable();
+            filterComboUpdater_->updateCountriesFilterCombo(ui->filterCountryCombo,
+                                                             ui->filterCountryCurrencyCombo,
+                                                             countries_);
+            applyCountriesFilters();
+        }
         statusBar()->showMessage("Страна удалена", 2000);
     });
     connect(actions_["refreshCountries"], &Action::executed, this, [this]() {
@@ -0,0 +1,190 @@
+#include "mainwindow/diagnosticsdock.h"
+#include "utils/perfcounters.h"
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QFontDatabase>
+#include <QHeaderView>
+#include <QPlainTextEdit>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QTimer>
+#include <QVBoxLayout>
+
+DiagnosticsDock::DiagnosticsDock(const DataContainer<Country>* countries,
+                                 const DataContainer<Hotel>* hotels,
+                                 const DataContainer<TransportCompany>* companies,
+                                 const DataContainer<Tour>* tours,
+                                 const DataContainer<Order>* orders,
+                                 QWidget* parent)
+    : QDockWidget("Диагностика", parent)
+    , countries_(countries)
+    , hotels_(hotels)
+    , companies_(companies)
+    , tours_(tours)
+    , orders_(orders)
+    , metricsTable_(new QTableWidget(PerfCounters::MetricCount, 5))
+    , containersTable_(new QTableWidget(5, 3))
+    , refreshTimer_(new QTimer(this))
+{
+    setObjectName("diagnosticsDock");
+
+    auto prepareTable = [](QTableWidget* table, const QStringList& headers) {
+        table->setHorizontalHeaderLabels(headers);
+        table->verticalHeader()->setVisible(false);
+        table->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+        table->horizontalHeader()->setStretchLastSection(true);
+        table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        table->setSelectionMode(QAbstractItemView::NoSelection);
+        table->setFocusPolicy(Qt::NoFocus);
+        for (int row = 0; row < table->rowCount(); ++row) {
+            for (int column = 0; column < table->columnCount(); ++column) {
+                QTableWidgetItem* item = new QTableWidgetItem;
+                item->setTextAlignment(column == 0 ? Qt::AlignLeft | Qt::AlignVCenter
+                                                   : Qt::AlignRight | Qt::AlignVCenter);
+                table->setItem(row, column, item);
+            }
+        }
+    };
+
+    prepareTable(metricsTable_, {"Операция", "Последняя", "p50", "p99", "Вызовов"});
+    for (int metric = 0; metric < PerfCounters::MetricCount; ++metric) {
+        metricsTable_->item(metric, 0)->setText(
+            PerfCounters::metricName(static_cast<PerfCounters::Metric>(metric)));
+    }
+
+    prepareTable(containersTable_, {"Контейнер", "Записей", "Память (≈)"});
+    const QStringList containerNames = {"Страны", "Отели", "Транспорт", "Туры", "Заказы"};
+    for (int row = 0; row < containerNames.size(); ++row) {
+        containersTable_->item(row, 0)->setText(containerNames[row]);
+    }
+
+    QPushButton* resetButton = new QPushButton("Сбросить счётчики");
+    connect(resetButton, &QPushButton::clicked, this, [this]() {
+        PerfCounters::instance().reset();
+        refresh();
+    });
+
+    QPushButton* memoryButton = new QPushButton("Отчёт о памяти...");
+    connect(memoryButton, &QPushButton::clicked, this, &DiagnosticsDock::showMemoryReport);
+
+    QWidget* content = new QWidget;
+    QVBoxLayout* layout = new QVBoxLayout(content);
+    layout->addWidget(metricsTable_, 3);
+    layout->addWidget(containersTable_, 2);
+    layout->addWidget(resetButton);
+    layout->addWidget(memoryButton);
+    setWidget(content);
+
+    refreshTimer_->setInterval(RefreshIntervalMs);
+    connect(refreshTimer_, &QTimer::timeout, this, &DiagnosticsDock::refresh);
+}
+
+void DiagnosticsDock::showEvent(QShowEvent* event) {
+    QDockWidget::showEvent(event);
+    refresh();
+    refreshTimer_->start();
+}
+
+void DiagnosticsDock::hideEvent(QHideEvent* event) {
+    refreshTimer_->stop();
+    QDockWidget::hideEvent(event);
+}
+
+QString DiagnosticsDock::formatDuration(qint64 nanoseconds) {
+    if (nanoseconds <= 0) {
+        return "—";
+    }
+    if (nanoseconds < 1000000) {
+        return QString("%1 мкс").arg(nanoseconds / 1000.0, 0, 'f', 1);
+    }
+    return QString("%1 мс").arg(nanoseconds / 1.0e6, 0, 'f', 2);
+}
+
+QString DiagnosticsDock::formatBytes(qint64 bytes) {
+    if (bytes < 1024) {
+        return QString("%1 Б").arg(bytes);
+    }
+    if (bytes < 1024 * 1024) {
+        return QString("%1 КБ").arg(bytes / 1024.0, 0, 'f', 1);
+    }
+    return QString("%1 МБ").arg(bytes / (1024.0 * 1024.0), 0, 'f', 1);
+}
+
+void DiagnosticsDock::refresh() {
+    refreshMetrics();
+    refreshContainers();
+}
+
+void DiagnosticsDock::refreshMetrics() {
+    const PerfCounters& counters = PerfCounters::instance();
+    for (int metric = 0; metric < PerfCounters::MetricCount; ++metric) {
+        PerfCounters::Snapshot snapshot = counters.snapshot(static_cast<PerfCounters::Metric>(metric));
+        metricsTable_->item(metric, 1)->setText(formatDuration(snapshot.lastNs));
+        metricsTable_->item(metric, 2)->setText(formatDuration(snapshot.p50Ns));
+        metricsTable_->item(metric, 3)->setText(formatDuration(snapshot.p99Ns));
+        metricsTable_->item(metric, 4)->setText(QString::number(snapshot.count));
+    }
+}
+
+void DiagnosticsDock::refreshContainers() {
+    const QVector<int> counts = {
+        countries_ ? countries_->size() : 0,
+        hotels_ ? hotels_->size() : 0,
+        companies_ ? companies_->size() : 0,
+        tours_ ? tours_->size() : 0,
+        orders_ ? orders_->size() : 0
+    };
+    if (counts != measuredCounts_ || !memoryAge_.isValid() || memoryAge_.hasExpired(MemoryRefreshIntervalMs)) {
+        measureMemory();
+    }
+    for (int row = 0; row < counts.size(); ++row) {
+        containersTable_->item(row, 1)->setText(QString::number(counts[row]));
+        containersTable_->item(row, 2)->setText(
+            row < measuredBytes_.size() ? formatBytes(measuredBytes_[row]) : QString("—"));
+    }
+}
+
+void DiagnosticsDock::measureMemory() {
+    if (!countries_ || !hotels_ || !companies_ || !tours_ || !orders_) {
+        return;
+    }
+    applyMemoryReport(MemoryAccounting::measure(*countries_, *hotels_, *companies_, *tours_, *orders_, 0));
+}
+
+void DiagnosticsDock::applyMemoryReport(const MemoryAccounting::Report& report) {
+    measuredCounts_.clear();
+    measuredBytes_.clear();
+    for (const MemoryAccounting::EntityStats& stats : report.entities) {
+        measuredCounts_.append(stats.count);
+        measuredBytes_.append(stats.deepBytes);
+    }
+    memoryAge_.start();
+}
+
+void DiagnosticsDock::showMemoryReport() {
+    if (!countries_ || !hotels_ || !companies_ || !tours_ || !orders_) {
+        return;
+    }
+
+    MemoryAccounting::Report report = MemoryAccounting::measure(*countries_, *hotels_, *companies_,
+                                                                *tours_, *orders_);
+    applyMemoryReport(report);
+    refreshContainers();
+
+    QDialog dialog(this);
+    dialog.setWindowTitle("Отчёт о памяти");
+    dialog.resize(760, 520);
+
+    QPlainTextEdit* text = new QPlainTextEdit(MemoryAccounting::toText(report));
+    text->setReadOnly(true);
+    text->setLineWrapMode(QPlainTextEdit::NoWrap);
+    text->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+    QDialogButtonBox* buttons = new QDialogButtonBox(QDialogButtonBox::Close);
+    connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+
+    QVBoxLayout* layout = new QVBoxLayout(&dialog);
+    layout->addWidget(text);
+    layout->addWidget(buttons);
+    dialog.exec();
+}
@@ -1,45 +1,70 @@
 #include "mainwindow/filtercomboupdater.h"
+#include "utils/symboltable.h"
+#include "utils/tracer.h"
 #include <QComboBox>
 #include <QSet>
+#include <QSignalBlocker>
 
 FilterComboUpdater::FilterComboUpdater() = default;
 
+void FilterComboUpdater::addFacetItem(QComboBox* combo, const QString& label, const QVariant& key) {
+    combo->addItem(label, key);
+    combo->setItemData(combo->count() - 1, label, LabelRole);
+}
+
+void FilterComboUpdater::updateFacetCounts(QComboBox* combo,
+                                            const std::function<int(const QVariant&)>& countFor) {
+    QSignalBlocker blocker(combo);
+    
+    for (int i = 0; i < combo->count(); ++i) {
+        QVariant label = combo->itemData(i, LabelRole);
+        if (!label.isValid()) {
+            label = combo->itemText(i);
+            combo->setItemData(i, label, LabelRole);
+        }
+        
+        int count = countFor(combo->itemData(i));
+        combo->setItemText(i, QString("%1 (%2)").arg(label.toString()).arg(count));
+    }
+}
+
 void FilterComboUpdater::updateCountriesFilterCombo(QComboBox* continentCombo,
                                                      QComboBox* currencyCombo,
                                                      const DataContainer<Country>& countries) {
-    QSet<QString> continents;
-    QSet<QString> currencies;
+    TRACE_SCOPE("FilterComboUpdater::updateCountriesFilterCombo", "filter");
+    QSet<Symbol> continents;
+    QSet<Symbol> currencies;
     
     for (const auto& country : countries.getData()) {
-        if (!country.getContinent().isEmpty()) {
-            continents.insert(country.getContinent());
+        if (!country.getContinentSymbol().isEmpty()) {
+            continents.insert(country.getContinentSymbol());
         }
-        if (!country.getCurrency().isEmpty()) {
-            currencies.insert(country.getCurrency());
+        if (!country.getCurrencySymbol().isEmpty()) {
+            currencies.insert(country.getCurrencySymbol());
         }
     }
     
-    QString currentContinent = continentCombo->currentText();
-    QString currentCurrency = currencyCombo->currentText();
+    QVariant currentContinent = continentCombo->currentData();
+    QVariant currentCurrency = currencyCombo->currentData();
     
     continentCombo->clear();
     continentCombo->addItem("Все");
-    for (const QString& continent : continents) {
-        continentCombo->addItem(continent);
+    for (Symbol continent : continents) {
+        addFacetItem(continentCombo, continent.toString(), continent.id());
     }
     
     currencyCombo->clear();
     currencyCombo->addItem("Все");
-    for (const QString& currency : currencies) {
-        currencyCombo->addItem(currency);
+    for (Symbol currency : currencies) {
+        addFacetItem(currencyCombo, currency.toString(), currency.id());
     }
     
-    int continentIndex = continentCombo->findText(currentContinent);
+    int continentIndex = continentCombo->findData(currentContinent);
     if (continentIndex >= 0) {
         continentCombo->setCurrentIndex(continentIndex);
     }
     
-    int currencyIndex = currencyCombo->findText(currentCurrency);
+    int currencyIndex = currencyCombo->findData(currentCurrency);
     if (currencyIndex >= 0) {
         currencyCombo->setCurrentIndex(currencyIndex);
     }
@@ -48,37 +73,38 @@ void FilterComboUpdater::updateCountriesFilterCombo(QComboBox* continentCombo,
 void FilterComboUpdater::updateHotelsFilterCombos(QComboBox* countryCombo,
                                                    QComboBox* starsCombo,
                                                    const DataContainer<Hotel>& hotels) {
-    QSet<QString> countries;
-    QSet<QString> stars;
+    TRACE_SCOPE("FilterComboUpdater::updateHotelsFilterCombos", "filter");
+    QSet<Symbol> countries;
+    QSet<int> stars;
     
     for (const auto& hotel : hotels.getData()) {
-        if (!hotel.getCountry().isEmpty()) {
-            countries.insert(hotel.getCountry());
+        if (!hotel.getCountrySymbol().isEmpty()) {
+            countries.insert(hotel.getCountrySymbol());
         }
-        stars.insert(QString::number(hotel.getStars()));
+        stars.insert(hotel.getStars());
     }
     
-    QString currentCountry = countryCombo->currentText();
-    QString currentStars = starsCombo->currentText();
+    QVariant currentCountry = countryCombo->currentData();
+    QVariant currentStars = starsCombo->currentData();
     
     countryCombo->clear();
     countryCombo->addItem("Все");
-    for (const QString& country : countries) {
-        countryCombo->addItem(country);
+    for (Symbol country : countries) {
+        addFacetItem(countryCombo, country.toString(), country.id());
     }
     
     starsCombo->clear();
     starsCombo->addItem("Все");
-    for (const QString& star : stars) {
-        starsCombo->addItem(star);
+    for (int star : stars) {
+        addFacetItem(starsCombo, QString::number(star), static_cast<quint32>(star));
     }
     
-    int countryIndex = countryCombo->findText(currentCountry);
+    int countryIndex = countryCombo->findData(currentCountry);
     if (countryIndex >= 0) {
         countryCombo->setCurrentIndex(countryIndex);
     }
     
-    int starsIndex = starsCombo->findText(currentStars);
+    int starsIndex = starsCombo->findData(currentStars);
     if (starsIndex >= 0) {
         starsCombo->setCurrentIndex(starsIndex);
     }
@@ -86,21 +112,24 @@ void FilterComboUpdater::updateHotelsFilterCombos(QComboBox* countryCombo,
 
 void FilterComboUpdater::updateTransportFilterCombo(QComboBox* typeCombo,
                                                       const DataContainer<TransportCompany>& companies) {
-    QSet<QString> types;
+    TRACE_SCOPE("FilterComboUpdater::updateTransportFilterCombo", "filter");
+    QSet<int> types;
     
     for (const auto& company : companies.getData()) {
-        types.insert(TransportCompany::transportTypeToString(company.getTransportType()));
+        types.insert(static_cast<int>(company.getTransportType()));
     }
     
-    QString currentType = typeCombo->currentText();
+    QVariant currentType = typeCombo->currentData();
     
     typeCombo->clear();
     typeCombo->addItem("Все");
-    for (const QString& type : types) {
-        typeCombo->addItem(type);
+    for (int type : types) {
+        addFacetItem(typeCombo,
+                     TransportCompany::transportTypeToString(static_cast<TransportCompany::TransportType>(type)),
+                     static_cast<quint32>(type));
     }
     
-    int typeIndex = typeCombo->findText(currentType);
+    int typeIndex = typeCombo->findData(currentType);
     if (typeIndex >= 0) {
         typeCombo->setCurrentIndex(typeIndex);
     }
@@ -108,38 +137,40 @@ void FilterComboUpdater::updateTransportFilterCombo(QComboBox* typeCombo,
 
 void FilterComboUpdater::updateToursFilterCombo(QComboBox* countryCombo,
                                                  const DataContainer<Tour>& tours) {
-    QSet<QString> countries;
+    TRACE_SCOPE("FilterComboUpdater::updateToursFilterCombo", "filter");
+    QSet<Symbol> countries;
     
     for (const auto& tour : tours.getData()) {
-        if (!tour.getCountry().isEmpty()) {
-            countries.insert(tour.getCountry());
+        if (!tour.getCountrySymbol().isEmpty()) {
+            countries.insert(tour.getCountrySymbol());
         }
     }
     
-    QString currentCountry = countryCombo->currentText();
+    QVariant currentCountry = countryCombo->currentData();
     
     countryCombo->clear();
     countryCombo->addItem("Все");
-    for (const QString& country : countries) {
-        countryCombo->addItem(country);
+    for (Symbol country : countries) {
+        addFacetItem(countryCombo, country.toString(), country.id());
     }
     
-    int countryIndex = countryCombo->findText(currentCountry);
+    int countryIndex = countryCombo->findData(currentCountry);
     if (countryIndex >= 0) {
         countryCombo->setCurrentIndex(countryIndex);
     }
 }
 
 void FilterComboUpdater::updateOrdersFilterCombo(QComboBox* statusCombo) {
-    QString currentStatus = statusCombo->currentText();
+    TRACE_SCOPE("FilterComboUpdater::updateOrdersFilterCombo", "filter");
+    QVariant currentStatus = statusCombo->currentData();
     
     statusCombo->clear();
     statusCombo->addItem("Все");
-    statusCombo->addItem("В обработке");
-    statusCombo->addItem("Подтвержден");
-    statusCombo->addItem("Отменен");
+    for (OrderStatus status : OrderStatusInfo::all()) {
+        addFacetItem(statusCombo, OrderStatusInfo::toString(status), static_cast<int>(status));
+    }
     
-    int statusIndex = statusCombo->findText(currentStatus);
+    int statusIndex = statusCombo->findData(currentStatus);
     if (statusIndex >= 0) {
         statusCombo->setCurrentIndex(statusIndex);
     }
@@ -4,6 +4,9 @@
 #include <QLineEdit>
 #include <QComboBox>
 #include "utils/numericsortitem.h"
+#include "utils/perfcounters.h"
+#include "utils/tracer.h"
+#include <limits>
 
 FilterManager::FilterManager() = default;
 
@@ -24,31 +27,41 @@ bool FilterManager::matchesSearchText(QTableWidget* table, int row, const QStrin
     return false;
 }
 
-double FilterManager::extractCostFromItem(QTableWidgetItem* item) const {
+bool FilterManager::isRowInMask(QTableWidget* table, int row, const RowMask& mask) const {
+    QTableWidgetItem* item = table->item(row, 0);
     if (!item) {
-        return 0.0;
+        return false;
     }
     
-    QVariant sortData = item->data(Qt::UserRole);
-    if (sortData.isValid() && sortData.canConvert<double>()) {
-        return sortData.toDouble();
+    QVariant indexData = item->data(Qt::UserRole);
+    int dataIndex = indexData.isValid() ? indexData.toInt() : row;
+    return dataIndex >= 0 && dataIndex < mask.size() && mask[dataIndex];
+}
+
+bool FilterManager::matchesSymbol(QTableWidgetItem* item, Symbol filter) const {
+    if (!item) {
+        return false;
     }
     
-    QString costText = item->text();
-    costText.remove(" руб");
-    costText = costText.trimmed();
-    bool ok;
-    double cost = costText.toDouble(&ok);
-    return ok ? cost : 0.0;
+    QVariant symbolData = item->data(SymbolTable::SymbolRole);
+    if (symbolData.isValid()) {
+        return symbolData.toUInt() == filter.id();
+    }
+    
+    return item->text() == filter.toString();
 }
 
 void FilterManager::applyCountriesFilters(QTableWidget* table,
                                          QLineEdit* searchEdit,
                                          QComboBox* continentCombo,
                                          QComboBox* currencyCombo) {
+    TRACE_SCOPE("FilterManager::applyCountriesFilters", "filter");
+    PerfTimer perfTimer(PerfCounters::Filter);
     QString searchText = searchEdit->text().trimmed();
-    QString continentFilter = continentCombo->currentText();
-    QString currencyFilter = currencyCombo->currentText();
+    QVariant continentFilter = continentCombo->currentData();
+    Symbol continentSymbol = Symbol::fromId(continentFilter.toUInt());
+    QVariant currencyFilter = currencyCombo->currentData();
+    Symbol currencySymbol = Symbol::fromId(currencyFilter.toUInt());
     
     for (int row = 0; row < table->rowCount(); ++row) {
         bool visible = true;
@@ -57,16 +70,14 @@ void FilterManager::applyCountriesFilters(QTableWidget* table,
             visible = false;
         }
         
-        if (visible && !continentFilter.isEmpty() && continentFilter != "Все") {
-            QTableWidgetItem* item = table->item(row, 1);
-            if (!item || item->text() != continentFilter) {
+        if (visible && continentFilter.isValid()) {
+            if (!matchesSymbol(table->item(row, 1), continentSymbol)) {
                 visible = false;
             }
         }
         
-        if (visible && !currencyFilter.isEmpty() && currencyFilter != "Все") {
-            QTableWidgetItem* item = table->item(row, 3);
-            if (!item || item->text() != currencyFilter) {
+        if (visible && currencyFilter.isValid()) {
+            if (!matchesSymbol(table->item(row, 3), currencySymbol)) {
                 visible = false;
             }
         }
@@ -79,9 +90,12 @@ void FilterManager::applyHotelsFilters(QTableWidget* table,
                                       QLineEdit* searchEdit,
                                       QComboBox* countryCombo,
                                       QComboBox* starsCombo) {
+    TRACE_SCOPE("FilterManager::applyHotelsFilters", "filter");
+    PerfTimer perfTimer(PerfCounters::Filter);
     QString searchText = searchEdit->text().trimmed();
-    QString countryFilter = countryCombo->currentText();
-    QString starsFilter = starsCombo->currentText();
+    QVariant countryFilter = countryCombo->currentData();
+    Symbol countrySymbol = Symbol::fromId(countryFilter.toUInt());
+    QVariant starsFilter = starsCombo->currentData();
     
     for (int row = 0; row < table->rowCount(); ++row) {
         bool visible = true;
@@ -90,16 +104,15 @@ void FilterManager::applyHotelsFilters(QTableWidget* table,
             visible = false;
         }
         
-        if (visible && !countryFilter.isEmpty() && countryFilter != "Все") {
-            QTableWidgetItem* item = table->item(row, 1);
-            if (!item || item->text() != countryFilter) {
+        if (visible && countryFilter.isValid()) {
+            if (!matchesSymbol(table->item(row, 1), countrySymbol)) {
                 visible = false;
             }
         }
         
-        if (visible && !starsFilter.isEmpty() && starsFilter != "Все") {
+        if (visible && starsFilter.isValid()) {
             QTableWidgetItem* item = table->item(row, 2);
-            if (!item || item->text() != starsFilter) {
+            if (!item || item->text().toInt() != starsFilter.toInt()) {
                 visible = false;
             }
         }
@@ -111,8 +124,13 @@ void FilterManager::applyHotelsFilters(QTableWidget* table,
 void FilterManager::applyTransportFilters(QTableWidget* table,
                                           QLineEdit* searchEdit,
                                           QComboBox* typeCombo) {
+    TRACE_SCOPE("FilterManager::applyTransportFilters", "filter");
+    PerfTimer perfTimer(PerfCounters::Filter);
     QString searchText = searchEdit->text().trimmed();
-    QString typeFilter = typeCombo->currentText();
+    QVariant typeFilter = typeCombo->currentData();
+    QString typeText = typeFilter.isValid()
+        ? TransportCompany::transportTypeToString(static_cast<TransportCompany::TransportType>(typeFilter.toInt()))
+        : QString();
     
     for (int row = 0; row < table->rowCount(); ++row) {
         bool visible = true;
@@ -121,9 +139,9 @@ void FilterManager::applyTransportFilters(QTableWidget* table,
             visible = false;
         }
         
-        if (visible && !typeFilter.isEmpty() && typeFilter != "Все") {
+        if (visible && typeFilter.isValid()) {
             QTableWidgetItem* item = table->item(row, 1);
-            if (!item || item->text() != typeFilter) {
+            if (!item || item->text() != typeText) {
                 visible = false;
             }
         }
@@ -133,79 +151,59 @@ void FilterManager::applyTransportFilters(QTableWidget* table,
 }
 
 void FilterManager::applyToursFilters(QTableWidget* table,
+                                      const TourColumnStore& columns,
                                       QLineEdit* searchEdit,
                                       QComboBox* countryCombo,
                                       QLineEdit* minPriceEdit,
                                       QLineEdit* maxPriceEdit) {
+    TRACE_SCOPE("FilterManager::applyToursFilters", "filter");
+    PerfTimer perfTimer(PerfCounters::Filter);
     QString searchText = searchEdit->text().trimmed();
-    QString countryFilter = countryCombo->currentText();
-    bool hasMinPrice = !minPriceEdit->text().trimmed().isEmpty();
-    bool hasMaxPrice = !maxPriceEdit->text().trimmed().isEmpty();
-    double minPrice = hasMinPrice ? minPriceEdit->text().toDouble() : 0.0;
-    double maxPrice = hasMaxPrice ? maxPriceEdit->text().toDouble() : std::numeric_limits<double>::max();
+    QVariant countryFilter = countryCombo->currentData();
+    Money minPrice;
+    Money maxPrice(std::numeric_limits<qint64>::max());
+    bool hasMinPrice = Money::tryParse(minPriceEdit->text(), minPrice);
+    bool hasMaxPrice = Money::tryParse(maxPriceEdit->text(), maxPrice);
+    
+    RowMask mask = columns.allRows();
+    if (countryFilter.isValid()) {
+        columns.filterCountry(countryFilter.toUInt(), mask);
+    }
+    if (hasMinPrice || hasMaxPrice) {
+        columns.filterCost(minPrice.kopecks(), maxPrice.kopecks(), mask);
+    }
     
     for (int row = 0; row < table->rowCount(); ++row) {
-        bool visible = true;
-        
-        if (!matchesSearchText(table, row, searchText)) {
-            visible = false;
-        }
-        
-        if (visible && !countryFilter.isEmpty() && countryFilter != "Все") {
-            QTableWidgetItem* item = table->item(row, 1);
-            if (!item || item->text() != countryFilter) {
-                visible = false;
-            }
-        }
-        
-        if (visible && (hasMinPrice || hasMaxPrice)) {
-            QTableWidgetItem* costItem = table->item(row, 4);
-            double cost = extractCostFromItem(costItem);
-            if (cost < minPrice || cost > maxPrice) {
-                visible = false;
-            }
-        }
-        
+        bool visible = isRowInMask(table, row, mask) && matchesSearchText(table, row, searchText);
         table->setRowHidden(row, !visible);
     }
 }
 
 void FilterManager::applyOrdersFilters(QTableWidget* table,
+                                       const OrderColumnStore& columns,
                                        QLineEdit* searchEdit,
                                        QComboBox* statusCombo,
                                        QLineEdit* minCostEdit,
                                        QLineEdit* maxCostEdit) {
+    TRACE_SCOPE("FilterManager::applyOrdersFilters", "filter");
+    PerfTimer perfTimer(PerfCounters::Filter);
     QString searchText = searchEdit->text().trimmed();
-    QString statusFilter = statusCombo->currentText();
-    bool hasMinCost = !minCostEdit->text().trimmed().isEmpty();
-    bool hasMaxCost = !maxCostEdit->text().trimmed().isEmpty();
-    double minCost = hasMinCost ? minCostEdit->text().toDouble() : 0.0;
-    double maxCost = hasMaxCost ? maxCostEdit->text().toDouble() : std::numeric_limits<double>::max();
+    QVariant statusFilter = statusCombo->currentData();
+    Money minCost;
+    Money maxCost(std::numeric_limits<qint64>::max());
+    bool hasMinCost = Money::tryParse(minCostEdit->text(), minCost);
+    bool hasMaxCost = Money::tryParse(maxCostEdit->text(), maxCost);
+    
+    RowMask mask = columns.allRows();
+    if (statusFilter.isValid()) {
+        columns.filterStatus(static_cast<OrderStatus>(statusFilter.toInt()), mask);
+    }
+    if (hasMinCost || hasMaxCost) {
+        columns.filterCost(minCost.kopecks(), maxCost.kopecks(), mask);
+    }
     
     for (int row = 0; row < table->rowCount(); ++row) {
-        bool visible = true;
-        
-        if (!matchesSearchText(table, row, searchText)) {
-            visible = false;
-        }
-        
-        if (visible && !statusFilter.isEmpty() && statusFilter != "Все") {
-            QTableWidgetItem* item = table->item(row, 5);
-            if (!item || item->text() != statusFilter) {
-                visible = false;
-            }
-        }
-        
-        if (visible && (hasMinCost || hasMaxCost)) {
-            QTableWidgetItem* costItem = table->item(row, 4);
-            double cost = extractCostFromItem(costItem);
-            if (cost < minCost || cost > maxCost) {
-                visible = false;
-            }
-        }
-        
+        bool visible = isRowInMask(table, row, mask) && matchesSearchText(table, row, searchText);
         table->setRowHidden(row, !visible);
     }
 }
-
-
@@ -15,6 +15,7 @@ void TableManager::updateCountriesTable(QTableWidget* table, const DataContainer
         table->setItem(row, 0, nameItem);
         
         QTableWidgetItem* continentItem = new QTableWidgetItem(country.getContinent());
+        continentItem->setData(SymbolTable::SymbolRole, country.getContinentSymbol().id());
         continentItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
         table->setItem(row, 1, continentItem);
         
@@ -23,6 +24,7 @@ void TableManager::updateCountriesTable(QTableWidget* table, const DataContainer
         table->setItem(row, 2, capitalItem);
         
         QTableWidgetItem* currencyItem = new QTableWidgetItem(country.getCurrency());
+        currencyItem->setData(SymbolTable::SymbolRole, country.getCurrencySymbol().id());
         currencyItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
         table->setItem(row, 3, currencyItem);
         ++row;
@@ -39,6 +41,7 @@ void TableManager::updateHotelsTable(QTableWidget* table, const DataContainer<Ho
         table->setItem(row, 0, nameItem);
         
         QTableWidgetItem* countryItem = new QTableWidgetItem(hotel.getCountry());
+        countryItem->setData(SymbolTable::SymbolRole, hotel.getCountrySymbol().id());
         countryItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
         table->setItem(row, 1, countryItem);
         
@@ -83,10 +86,12 @@ void TableManager::updateToursTable(QTableWidget* table, const DataContainer<Tou
     int row = 0;
     for (const auto& tour : tours.getData()) {
         QTableWidgetItem* nameItem = new QTableWidgetItem(tour.getName());
+        nameItem->setData(Qt::UserRole, row);
         nameItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
         table->setItem(row, 0, nameItem);
         
         QTableWidgetItem* countryItem = new QTableWidgetItem(tour.getCountry());
+        countryItem->setData(SymbolTable::SymbolRole, tour.getCountrySymbol().id());
         countryItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
         table->setItem(row, 1, countryItem);
         
@@ -98,8 +103,7 @@ void TableManager::updateToursTable(QTableWidget* table, const DataContainer<Tou
         endDateItem->setTextAlignment(Qt::AlignCenter | Qt::AlignVCenter);
         table->setItem(row, 3, endDateItem);
         
-        double cost = tour.calculateCost();
-        NumericSortItem* costItem = new NumericSortItem(QString::number(cost, 'f', 2) + " руб", cost);
+        NumericSortItem* costItem = new NumericSortItem(tour.calculateCost());
         costItem->setTextAlignment(Qt::AlignCenter | Qt::AlignVCenter);
         table->setItem(row, 4, costItem);
         ++row;
@@ -111,7 +115,8 @@ void TableManager::updateOrdersTable(QTableWidget* table, const DataContainer<Or
     
     int row = 0;
     for (const auto& order : orders.getData()) {
-        QTableWidgetItem* tourItem = new QTableWidgetItem(order.getTour().getName());
+        QTableWidgetItem* tourItem = new QTableWidgetItem(order.getTourName());
+        tourItem->setData(Qt::UserRole, row);
         tourItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
         table->setItem(row, 0, tourItem);
         
@@ -127,12 +132,12 @@ void TableManager::updateOrdersTable(QTableWidget* table, const DataContainer<Or
         emailItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
         table->setItem(row, 3, emailItem);
         
-        double cost = order.getTotalCost();
-        NumericSortItem* costItem = new NumericSortItem(QString::number(cost, 'f', 2) + " руб", cost);
+        NumericSortItem* costItem = new NumericSortItem(order.getTotalCost());
         costItem->setTextAlignment(Qt::AlignCenter | Qt::AlignVCenter);
         table->setItem(row, 4, costItem);
         
-        QTableWidgetItem* statusItem = new QTableWidgetItem(order.getStatus());
+        QTableWidgetItem* statusItem = new QTableWidgetItem(order.getStatusText());
+        statusItem->setData(OrderStatusInfo::StatusRole, static_cast<int>(order.getStatus()));
         statusItem->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
         table->setItem(row, 5, statusItem);
         ++row;
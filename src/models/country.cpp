@@ -2,12 +2,12 @@
 #include <sstream>
 
 Country::Country(const QString& name, const QString& continent)
-    : TouristService(name, 0.0), continent_(continent) {
+    : TouristService(name), continent_(continent) {
 }
 
 QString Country::getDescription() const {
     return QString("Country: %1, Continent: %2, Capital: %3")
-        .arg(getName(), continent_, capital_);
+        .arg(getName(), continent_.toString(), capital_.toString());
 }
 
 Country& Country::operator=(const Country& other) {
@@ -24,9 +24,9 @@ Country& Country::operator=(const Country& other) {
 void Country::writeToFile(std::ofstream& ofs) const {
     ofs << "COUNTRY\n";
     ofs << getName().toStdString() << "\n";
-    ofs << continent_.toStdString() << "\n";
-    ofs << capital_.toStdString() << "\n";
-    ofs << currency_.toStdString() << "\n";
+    ofs << continent_.toString().toStdString() << "\n";
+    ofs << capital_.toString().toStdString() << "\n";
+    ofs << currency_.toString().toStdString() << "\n";
 }
 
 void Country::readFromFile(std::ifstream& ifs) {
@@ -43,7 +43,7 @@ void Country::readFromFile(std::ifstream& ifs) {
     std::getline(ifs, currency);
     
     setName(QString::fromStdString(name));
-    continent_ = QString::fromStdString(continent);
-    capital_ = QString::fromStdString(capital);
-    currency_ = QString::fromStdString(currency);
+    continent_ = Symbol(QString::fromStdString(continent));
+    capital_ = Symbol(QString::fromStdString(capital));
+    currency_ = Symbol(QString::fromStdString(currency));
 }
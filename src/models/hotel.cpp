@@ -2,16 +2,16 @@
 #include <algorithm>
 
 Hotel::Hotel(const QString& name, const QString& country, int stars, const QString& address)
-    : TouristService(name, 0.0), country_(country), stars_(stars), address_(address) {
+    : TouristService(name), country_(country), stars_(stars), address_(address) {
 }
 
 QString Hotel::getDescription() const {
     return QString("Hotel: %1, Country: %2, Stars: %3, Address: %4, Rooms: %5")
-        .arg(getName(), country_, QString::number(stars_), address_, QString::number(rooms_.size()));
+        .arg(getName(), country_.toString(), QString::number(stars_), address_, QString::number(rooms_.size()));
 }
 
-double Hotel::calculateCost() const {
-    double total = 0.0;
+Money Hotel::calculateCost() const {
+    Money total;
     for (const auto& room : rooms_) {
         total += room.getPricePerNight();
     }
@@ -0,0 +1,148 @@
+#include "models/money.h"
+#include <algorithm>
+#include <cmath>
+
+Money Money::fromDouble(double amount, quint32 currency) {
+    if (!std::isfinite(amount)) {
+        throw MoneyException("Money amount is not a finite number");
+    }
+    return Money(std::llround(amount * KopecksPerUnit), currency);
+}
+
+bool Money::tryParse(const QString& text, Money& result, quint32 currency) {
+    QString trimmed = text.trimmed();
+    if (trimmed.isEmpty()) {
+        return false;
+    }
+
+    int pos = 0;
+    bool negative = false;
+    if (trimmed[0] == '-' || trimmed[0] == '+') {
+        negative = trimmed[0] == '-';
+        ++pos;
+    }
+
+    qint64 units = 0;
+    int unitDigits = 0;
+    while (pos < trimmed.size() && trimmed[pos].isDigit()) {
+        if (++unitDigits > 15) {
+            return false;
+        }
+        units = units * 10 + trimmed[pos].digitValue();
+        ++pos;
+    }
+
+    qint64 fraction = 0;
+    int fractionDigits = 0;
+    if (pos < trimmed.size() && (trimmed[pos] == '.' || trimmed[pos] == ',')) {
+        ++pos;
+        while (pos < trimmed.size() && trimmed[pos].isDigit()) {
+            if (++fractionDigits > 2) {
+                return false;
+            }
+            fraction = fraction * 10 + trimmed[pos].digitValue();
+            ++pos;
+        }
+    }
+
+    if (pos != trimmed.size() || (unitDigits == 0 && fractionDigits == 0)) {
+        return false;
+    }
+
+    if (fractionDigits == 1) {
+        fraction *= 10;
+    }
+
+    qint64 kopecks = units * KopecksPerUnit + fraction;
+    result = Money(negative ? -kopecks : kopecks, currency);
+    return true;
+}
+
+Money Money::fromString(const QString& text, quint32 currency) {
+    Money result;
+    if (!tryParse(text, result, currency)) {
+        throw MoneyException(QString("Invalid money amount: '%1'").arg(text));
+    }
+    return result;
+}
+
+quint32 Money::currencyFromCode(const QString& code) {
+    QString upper = code.trimmed().toUpper();
+    if (upper.size() != 3) {
+        throw MoneyException(QString("Invalid currency code: '%1'").arg(code));
+    }
+    quint32 currency = 0;
+    for (QChar ch : upper) {
+        currency = (currency << 8) | static_cast<quint32>(ch.toLatin1());
+    }
+    return currency;
+}
+
+QString Money::codeFromCurrency(quint32 currency) {
+    QString code;
+    code += QChar(static_cast<char>((currency >> 16) & 0xFF));
+    code += QChar(static_cast<char>((currency >> 8) & 0xFF));
+    code += QChar(static_cast<char>(currency & 0xFF));
+    return code;
+}
+
+QString Money::toString() const {
+    qint64 absolute = kopecks_ < 0 ? -kopecks_ : kopecks_;
+    return QString("%1%2.%3")
+        .arg(kopecks_ < 0 ? "-" : "")
+        .arg(absolute / KopecksPerUnit)
+        .arg(absolute % KopecksPerUnit, 2, 10, QChar('0'));
+}
+
+QString Money::toDisplayString() const {
+    if (currency_ == DefaultCurrency) {
+        return toString() + " руб";
+    }
+    return toString() + " " + currencyCode();
+}
+
+Money Money::scaled(double factor) const {
+    return Money(std::llround(static_cast<double>(kopecks_) * factor), currency_);
+}
+
+Money& Money::operator+=(const Money& other) {
+    checkCurrency(other);
+    kopecks_ += other.kopecks_;
+    return *this;
+}
+
+Money& Money::operator-=(const Money& other) {
+    checkCurrency(other);
+    kopecks_ -= other.kopecks_;
+    return *this;
+}
+
+void Money::checkCurrency(const Money& other) const {
+    if (currency_ != other.currency_) {
+        throw MoneyException(QString("Currency mismatch: %1 and %2")
+            .arg(currencyCode(), other.currencyCode()));
+    }
+}
+
+qint64 Money::sumKopecks(const qint64* values, qsizetype count) {
+    qint64 total = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        total += values[i];
+    }
+    return total;
+}
+
+bool Money::rangeKopecks(const qint64* values, qsizetype count, qint64& minValue, qint64& maxValue) {
+    if (count <= 0) {
+        return false;
+    }
+    qint64 low = values[0];
+    qint64 high = values[0];
+    for (qsizetype i = 1; i < count; ++i) {
+        low = std::min(low, values[i]);
+        high = std::max(high, values[i]);
+    }
+    minValue = low;
+    maxValue = high;
+    return true;
+}
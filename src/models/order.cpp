@@ -1,32 +1,73 @@
 #include "models/order.h"
+#include "utils/orderdetailsource.h"
 #include <sstream>
 
-int Order::nextId_ = 1;
-
-Order::Order() : id_(nextId_++) {
+Order::Order() {
     orderDate_ = QDateTime::currentDateTime();
 }
 
 Order::Order(const Tour& tour, const QString& clientName, const QString& clientPhone, const QString& clientEmail)
-    : id_(nextId_++), tour_(tour), clientName_(clientName), 
+    : clientName_(clientName), 
       clientPhone_(clientPhone), clientEmail_(clientEmail) {
+    setTour(tour);
     orderDate_ = QDateTime::currentDateTime();
 }
 
+Tour Order::getTour() const {
+    if (tour_) {
+        return *tour_;
+    }
+    if (details_) {
+        return *details_->tour(detailRow_);
+    }
+    return Tour();
+}
+
+void Order::setTour(const Tour& tour) {
+    setTour(std::make_shared<const Tour>(tour));
+}
+
+void Order::setTour(std::shared_ptr<const Tour> tour) {
+    tour_ = std::move(tour);
+    details_.reset();
+    detailRow_ = -1;
+    tourName_ = tour_ ? Symbol(tour_->getName()) : Symbol();
+    tourCountry_ = tour_ ? tour_->getCountrySymbol() : Symbol();
+    cost_ = tour_ ? tour_->calculateCost() : Money();
+}
+
+void Order::setLazyTour(std::shared_ptr<OrderDetailSource> source, int row,
+                        Symbol tourName, Symbol tourCountry, const Money& cost) {
+    tour_.reset();
+    details_ = std::move(source);
+    detailRow_ = row;
+    tourName_ = tourName;
+    tourCountry_ = tourCountry;
+    cost_ = cost;
+}
+
 QString Order::toString() const {
     return QString("Order #%1: %2, Client: %3, Cost: %4, Status: %5")
-        .arg(QString::number(id_), tour_.getName(), clientName_, 
-             QString::number(getTotalCost(), 'f', 2), status_);
+        .arg(QString::number(id_), getTourName(), clientName_, 
+             getTotalCost().toString(), getStatusText());
+}
+
+void Order::transitionTo(OrderStatus status) {
+    if (!OrderStatusInfo::canTransition(status_, status)) {
+        throw OrderStatusException(QString("Invalid status transition for order #%1: '%2' -> '%3'")
+            .arg(QString::number(id_), getStatusText(), OrderStatusInfo::toString(status)));
+    }
+    status_ = status;
 }
 
 void Order::writeToFile(std::ofstream& ofs) const {
     ofs << "ORDER\n";
     ofs << id_ << "\n";
-    ofs << tour_.getName().toStdString() << "\n";
+    ofs << getTourName().toStdString() << "\n";
     ofs << clientName_.toStdString() << "\n";
     ofs << clientPhone_.toStdString() << "\n";
     ofs << orderDate_.toString(Qt::ISODate).toStdString() << "\n";
-    ofs << status_.toStdString() << "\n";
+    ofs << getStatusText().toStdString() << "\n";
 }
 
 void Order::readFromFile(std::ifstream& ifs) {
@@ -40,6 +81,7 @@ void Order::readFromFile(std::ifstream& ifs) {
     std::string status;
     ifs >> id_;
     ifs.ignore();
+    OrderIdAllocator::instance().observe(id_);
     std::getline(ifs, tourName);
     std::getline(ifs, clientName);
     std::getline(ifs, clientPhone);
@@ -49,5 +91,5 @@ void Order::readFromFile(std::ifstream& ifs) {
     clientName_ = QString::fromStdString(clientName);
     clientPhone_ = QString::fromStdString(clientPhone);
     orderDate_ = QDateTime::fromString(QString::fromStdString(dateStr), Qt::ISODate);
-    status_ = QString::fromStdString(status);
+    status_ = OrderStatusInfo::fromString(QString::fromStdString(status));
 }
@@ -0,0 +1,78 @@
+#include "models/orderstatus.h"
+
+QString OrderStatusInfo::toString(OrderStatus status) {
+    switch (status) {
+        case OrderStatus::Processing: return "В обработке";
+        case OrderStatus::Confirmed: return "Подтвержден";
+        case OrderStatus::Paid: return "Оплачен";
+        case OrderStatus::Completed: return "Завершен";
+        case OrderStatus::Cancelled: return "Отменен";
+        default: return "Неизвестно";
+    }
+}
+
+bool OrderStatusInfo::tryParse(const QString& str, OrderStatus& status) {
+    QString trimmed = str.trimmed();
+    if (trimmed == "В обработке" || trimmed == "Processing") {
+        status = OrderStatus::Processing;
+    } else if (trimmed == "Подтвержден" || trimmed == "Confirmed") {
+        status = OrderStatus::Confirmed;
+    } else if (trimmed == "Оплачен" || trimmed == "Paid") {
+        status = OrderStatus::Paid;
+    } else if (trimmed == "Завершен" || trimmed == "Completed") {
+        status = OrderStatus::Completed;
+    } else if (trimmed == "Отменен" || trimmed == "Cancelled") {
+        status = OrderStatus::Cancelled;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+OrderStatus OrderStatusInfo::fromString(const QString& str) {
+    OrderStatus status;
+    if (!tryParse(str, status)) {
+        throw OrderStatusException(QString("Unknown order status: '%1'").arg(str));
+    }
+    return status;
+}
+
+bool OrderStatusInfo::canTransition(OrderStatus from, OrderStatus to) {
+    return from == to || allowedTransitions(from).contains(to);
+}
+
+QVector<OrderStatus> OrderStatusInfo::allowedTransitions(OrderStatus from) {
+    switch (from) {
+        case OrderStatus::Processing:
+            return {OrderStatus::Confirmed, OrderStatus::Cancelled};
+        case OrderStatus::Confirmed:
+            return {OrderStatus::Paid, OrderStatus::Cancelled};
+        case OrderStatus::Paid:
+            return {OrderStatus::Completed, OrderStatus::Cancelled};
+        case OrderStatus::Completed:
+        case OrderStatus::Cancelled:
+        default:
+            return {};
+    }
+}
+
+bool OrderStatusInfo::isUnpaid(OrderStatus status) {
+    return status == OrderStatus::Processing || status == OrderStatus::Confirmed;
+}
+
+bool OrderStatusInfo::isFinal(OrderStatus status) {
+    return allowedTransitions(status).isEmpty();
+}
+
+QVector<OrderStatus> OrderStatusInfo::all() {
+    return {OrderStatus::Processing, OrderStatus::Confirmed, OrderStatus::Paid,
+            OrderStatus::Completed, OrderStatus::Cancelled};
+}
+
+QStringList OrderStatusInfo::names() {
+    QStringList result;
+    for (OrderStatus status : all()) {
+        result << toString(status);
+    }
+    return result;
+}
@@ -1,7 +1,7 @@
 #include "models/room.h"
 #include "models/touristservice.h"
 
-Room::Room(const QString& name, RoomType type, double pricePerNight, int capacity)
+Room::Room(const QString& name, RoomType type, const Money& pricePerNight, int capacity)
     : TouristService(name, pricePerNight), roomType_(type), 
       capacity_(capacity), pricePerNight_(pricePerNight) {
 }
@@ -9,7 +9,7 @@ Room::Room(const QString& name, RoomType type, double pricePerNight, int capacit
 QString Room::getDescription() const {
     return QString("Room: %1, Type: %2, Capacity: %3, Price per night: %4")
         .arg(getName(), roomTypeToString(roomType_), QString::number(capacity_), 
-             QString::number(pricePerNight_, 'f', 2));
+             pricePerNight_.toString());
 }
 
 QString Room::roomTypeToString(RoomType type) {
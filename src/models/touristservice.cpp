@@ -2,16 +2,18 @@
 #include <iostream>
 #include <sstream>
 
-TouristService::TouristService(const QString& name, double price)
+TouristService::TouristService(const QString& name, const Money& price)
     : name_(name), price_(price) {
 }
 
 void TouristService::writeToStream(std::ostream& os) const {
-    os << name_.toStdString() << " " << price_;
+    os << name_.toStdString() << " " << price_.toString().toStdString();
 }
 
 void TouristService::readFromStream(std::istream& is) {
     std::string name;
-    is >> name >> price_;
+    std::string price;
+    is >> name >> price;
     name_ = QString::fromStdString(name);
+    price_ = Money::fromString(QString::fromStdString(price));
 }
@@ -1,7 +1,7 @@
 #include "models/transportcompany.h"
 
 TransportCompany::TransportCompany(const QString& name, TransportType type)
-    : TouristService(name, 0.0), transportType_(type) {
+    : TouristService(name), transportType_(type) {
 }
 
 QString TransportCompany::getDescription() const {
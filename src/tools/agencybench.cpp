@@ -0,0 +1,279 @@
+#include "tools/agencybench.h"
+#include "tools/datasetgenerator.h"
+#include "containers/columnstore.h"
+#include "containers/facetcounter.h"
+#include "containers/toursearchindex.h"
+#include "utils/filemanager.h"
+#include "utils/streamfilemanager.h"
+#include "utils/tourlinker.h"
+#include "utils/tourpricing.h"
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QTemporaryDir>
+#include <QtGlobal>
+#include <algorithm>
+
+namespace {
+
+volatile qint64 benchSink = 0;
+
+}
+
+AgencyBench::AgencyBench(QTextStream& log)
+    : log_(log)
+{
+}
+
+bool AgencyBench::enabled(const QString& name) const {
+    return filter_.isEmpty() || name.contains(filter_);
+}
+
+void AgencyBench::measure(const QString& name, qint64 records, const std::function<void()>& body) {
+    if (!enabled(name)) {
+        return;
+    }
+
+    QVector<qint64> samples;
+    samples.reserve(iterations_);
+    QElapsedTimer timer;
+    for (int i = 0; i < std::max(1, iterations_); ++i) {
+        timer.start();
+        body();
+        samples.append(timer.nsecsElapsed());
+    }
+    std::sort(samples.begin(), samples.end());
+
+    Result result;
+    result.name = name;
+    result.size = size_;
+    result.iterations = samples.size();
+    result.minNs = samples.first();
+    result.medianNs = samples[samples.size() / 2];
+    result.maxNs = samples.last();
+    result.records = records;
+    results_.append(result);
+
+    log_ << QString("%1 %2").arg(name, -28).arg(size_, 9) << "  "
+         << QString::number(result.medianNs / 1.0e6, 'f', 3).rightJustified(12) << " ms" << Qt::endl;
+}
+
+QVector<AgencyBench::Result> AgencyBench::run(int records) {
+    results_.clear();
+    size_ = records;
+
+    DatasetGenerator generator(DatasetGenerator::Options::forRecords(records));
+    QElapsedTimer fixtureTimer;
+    fixtureTimer.start();
+    generator.generate(countries_, hotels_, companies_, tours_, orders_);
+    OrderIdAllocator::instance().observe(orders_.size());
+    log_ << QString("fixture %1 records generated in %2 ms").arg(records)
+            .arg(fixtureTimer.nsecsElapsed() / 1.0e6, 0, 'f', 1) << Qt::endl;
+
+    TourLinker linker(&countries_, &hotels_, &companies_, &tours_, &orders_);
+    measure("link.tours", tours_.size(), [&]() {
+        benchSink = linker.linkTours().withTransport;
+    });
+    measure("link.orders", orders_.size(), [&]() {
+        benchSink = linker.linkOrders().ordersLinked;
+    });
+
+    QTemporaryDir directory;
+    if (directory.isValid()) {
+        FileManager fileManager;
+        QString base = directory.path();
+
+        measure("file.save.countries", countries_.size(), [&]() {
+            fileManager.saveCountries(countries_, base + "/countries.txt");
+        });
+        measure("file.save.hotels", hotels_.size(), [&]() {
+            fileManager.saveHotels(hotels_, base + "/hotels.txt");
+        });
+        measure("file.save.transport", companies_.size(), [&]() {
+            fileManager.saveTransportCompanies(companies_, base + "/transport_companies.txt");
+        });
+        measure("file.save.tours", tours_.size(), [&]() {
+            fileManager.saveTours(tours_, base + "/tours.txt");
+        });
+        measure("file.save.orders", orders_.size(), [&]() {
+            fileManager.saveOrders(orders_, base + "/orders.txt");
+        });
+
+        DataContainer<Country> countries;
+        DataContainer<Hotel> hotels;
+        DataContainer<TransportCompany> companies;
+        DataContainer<Tour> tours;
+        DataContainer<Order> orders;
+        measure("file.load.countries", countries_.size(), [&]() {
+            fileManager.loadCountries(countries, base + "/countries.txt");
+        });
+        measure("file.load.hotels", hotels_.size(), [&]() {
+            fileManager.loadHotels(hotels, base + "/hotels.txt");
+        });
+        measure("file.load.transport", companies_.size(), [&]() {
+            fileManager.loadTransportCompanies(companies, base + "/transport_companies.txt");
+        });
+        measure("file.load.tours", tours_.size(), [&]() {
+            fileManager.loadTours(tours, base + "/tours.txt");
+        });
+        measure("file.load.orders", orders_.size(), [&]() {
+            fileManager.loadOrders(orders, base + "/orders.txt");
+        });
+
+        FileManager streamManager;
+        streamManager.setParser(FileManager::Parser::Stream);
+        measure("file.load.hotels.stream", hotels_.size(), [&]() {
+            streamManager.loadHotels(hotels, base + "/hotels.txt");
+        });
+        measure("file.load.tours.stream", tours_.size(), [&]() {
+            streamManager.loadTours(tours, base + "/tours.txt");
+        });
+        measure("file.load.orders.stream", orders_.size(), [&]() {
+            streamManager.loadOrders(orders, base + "/orders.txt");
+        });
+
+        FileManager legacyManager;
+        legacyManager.setFormat(FileManager::Format::V1);
+        measure("file.save.orders.v1", orders_.size(), [&]() {
+            legacyManager.saveOrders(orders_, base + "/orders_v1.txt");
+        });
+        measure("file.load.orders.v1", orders_.size(), [&]() {
+            legacyManager.loadOrders(orders, base + "/orders_v1.txt");
+        });
+
+        StreamFileManager streamFileManager(base.toStdString());
+        std::string streamBase = base.toStdString();
+        measure("stream.save", countries_.size() + orders_.size(), [&]() {
+            streamFileManager.saveAll(countries_, orders_, streamBase);
+        });
+        measure("stream.load", countries_.size() + orders_.size(), [&]() {
+            streamFileManager.loadCountries(countries, streamBase + "/countries_stream.txt");
+            streamFileManager.loadOrders(orders, streamBase + "/orders_stream.txt");
+        });
+    } else {
+        log_ << "warning: no temporary directory, skipping file benchmarks" << Qt::endl;
+    }
+
+    TourColumnStore tourColumns;
+    OrderColumnStore orderColumns;
+    measure("columns.rebuild.tours", tours_.size(), [&]() {
+        tourColumns.rebuild(tours_);
+    });
+    measure("columns.rebuild.orders", orders_.size(), [&]() {
+        orderColumns.rebuild(orders_);
+    });
+    tourColumns.rebuild(tours_);
+    orderColumns.rebuild(orders_);
+
+    qint64 minCost = 0;
+    qint64 maxCost = 0;
+    tourColumns.costRange(minCost, maxCost);
+    qint64 lowCost = minCost + (maxCost - minCost) / 4;
+    qint64 highCost = minCost + (maxCost - minCost) / 2;
+    quint32 firstCountry = tourColumns.size() > 0 ? tourColumns.countryIds().first() : 0;
+
+    measure("filter.tours", tours_.size(), [&]() {
+        RowMask mask = tourColumns.allRows();
+        tourColumns.filterCountry(firstCountry, mask);
+        tourColumns.filterCost(lowCost, highCost, mask);
+        benchSink = tourColumns.totalCost(mask);
+    });
+    measure("filter.orders", orders_.size(), [&]() {
+        RowMask mask = orderColumns.allRows();
+        orderColumns.filterUnpaid(mask);
+        orderColumns.filterCost(lowCost, highCost, mask);
+        benchSink = orderColumns.totalCost(mask);
+    });
+
+    FacetCounter facets;
+    measure("facets.tours", tours_.size(), [&]() {
+        facets.reset(tourColumns.size());
+        int facet = facets.addFacet(tourColumns.countryIds());
+        RowMask mask = tourColumns.allRows();
+        tourColumns.filterCost(lowCost, highCost, mask);
+        facets.select(facet, firstCountry);
+        facets.setBaseMask(mask);
+        benchSink = facets.matchingRows() + facets.total(facet);
+    });
+
+    TourSearchIndex searchIndex;
+    measure("search.rebuild", tours_.size(), [&]() {
+        searchIndex.rebuild(tourColumns);
+    });
+    searchIndex.rebuild(tourColumns);
+
+    TourQuery query;
+    query.limit = 1000;
+    query.maxCost = highCost;
+    query.minDuration = 5;
+    query.filterCountries = true;
+    query.countryIds.insert(firstCountry);
+    measure("search.query", tours_.size(), [&]() {
+        benchSink = searchIndex.query(query).size();
+    });
+    measure("search.count", tours_.size(), [&]() {
+        benchSink = searchIndex.count(query);
+    });
+
+    TourQuery dateQuery;
+    dateQuery.limit = 1000;
+    dateQuery.dateMatch = TourQuery::DateMatch::Overlaps;
+    dateQuery.firstDay = IntervalIndex::dayOf(QDate(2025, 6, 1));
+    dateQuery.lastDay = IntervalIndex::dayOf(QDate(2025, 6, 14));
+    measure("search.dates", tours_.size(), [&]() {
+        benchSink = searchIndex.query(dateQuery).size();
+    });
+
+    measure("price.calculateCost", tours_.size(), [&]() {
+        qint64 total = 0;
+        for (const auto& tour : tours_.getData()) {
+            total += tour.calculateCost().kopecks();
+        }
+        benchSink = total;
+    });
+    measure("price.quote", tours_.size(), [&]() {
+        qint64 total = 0;
+        for (const auto& tour : tours_.getData()) {
+            total += TourPricing::quote(tour).kopecks();
+        }
+        benchSink = total;
+    });
+
+    countries_.clear();
+    hotels_.clear();
+    companies_.clear();
+    tours_.clear();
+    orders_.clear();
+    return results_;
+}
+
+QJsonObject AgencyBench::toJson(const QVector<Result>& results, const QVector<int>& sizes) {
+    QJsonArray sizeArray;
+    for (int size : sizes) {
+        sizeArray.append(size);
+    }
+
+    QJsonArray resultArray;
+    for (const Result& result : results) {
+        QJsonObject object;
+        object["name"] = result.name;
+        object["size"] = result.size;
+        object["iterations"] = result.iterations;
+        object["min_ns"] = result.minNs;
+        object["median_ns"] = result.medianNs;
+        object["max_ns"] = result.maxNs;
+        object["records"] = result.records;
+        object["ns_per_record"] = result.records > 0
+            ? static_cast<double>(result.medianNs) / static_cast<double>(result.records) : 0.0;
+        resultArray.append(object);
+    }
+
+    QJsonObject root;
+    root["version"] = 1;
+    root["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    root["qt"] = QString(qVersion());
+    root["sizes"] = sizeArray;
+    root["results"] = resultArray;
+    return root;
+}
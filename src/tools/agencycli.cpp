@@ -0,0 +1,1154 @@
+#include "tools/agencycli.h"
+#include "tools/agencybench.h"
+#include "tools/datasetgenerator.h"
+#include "containers/columnstore.h"
+#include "containers/intervalindex.h"
+#include "utils/blockchecksums.h"
+#include "utils/crc32c.h"
+#include "utils/jsonserializer.h"
+#include "utils/mappedfileparser.h"
+#include "utils/memoryaccounting.h"
+#include "utils/orderarchive.h"
+#include "utils/orderpartitions.h"
+#include "utils/streamfilemanager.h"
+#include "utils/tourlinker.h"
+#include "utils/tracer.h"
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QSet>
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+AgencyCli::AgencyCli(QTextStream& out, QTextStream& err)
+    : out_(out)
+    , err_(err)
+{
+}
+
+int AgencyCli::run(const QStringList& arguments) {
+    if (arguments.isEmpty() || hasFlag(arguments, "help")) {
+        printUsage();
+        return arguments.isEmpty() ? UsageError : Success;
+    }
+
+    QString tracePath = option(arguments, "trace");
+    if (!tracePath.isEmpty()) {
+        Tracer::instance().setEnabled(true);
+    }
+
+    QString parser = option(arguments, "parser", "mapped");
+    if (parser == "stream") {
+        fileManager_.setParser(FileManager::Parser::Stream);
+    } else if (parser != "mapped") {
+        err_ << "unknown parser: " << parser << Qt::endl;
+        return UsageError;
+    }
+
+    QString textFormat = option(arguments, "text-format", "v2");
+    if (textFormat == "v1") {
+        fileManager_.setFormat(FileManager::Format::V1);
+    } else if (textFormat != "v2") {
+        err_ << "unknown text format: " << textFormat << Qt::endl;
+        return UsageError;
+    }
+
+    QStringList commandArguments;
+    for (const QString& argument : arguments) {
+        if (!argument.startsWith("--trace=") && !argument.startsWith("--parser=") &&
+            !argument.startsWith("--text-format=")) {
+            commandArguments.append(argument);
+        }
+    }
+    if (commandArguments.isEmpty()) {
+        printUsage();
+        return UsageError;
+    }
+
+    int result = runCommand(commandArguments.first(), commandArguments.mid(1));
+
+    if (!tracePath.isEmpty()) {
+        Tracer& tracer = Tracer::instance();
+        if (!tracer.exportToFile(tracePath)) {
+            err_ << "error: cannot write trace to " << tracePath << Qt::endl;
+            return Failure;
+        }
+        err_ << "trace with " << tracer.eventCount() << " events written to " << tracePath << Qt::endl;
+    }
+    return result;
+}
+
+int AgencyCli::runCommand(const QString& command, const QStringList& rest) {
+    try {
+        if (command == "stats") {
+            return runStats(rest);
+        }
+        if (command == "validate") {
+            return runValidate(rest);
+        }
+        if (command == "convert") {
+            return runConvert(rest);
+        }
+        if (command == "relink") {
+            return runRelink(rest);
+        }
+        if (command == "price") {
+            return runPrice(rest);
+        }
+        if (command == "memory") {
+            return runMemory(rest);
+        }
+        if (command == "index") {
+            return runIndex(rest);
+        }
+        if (command == "order") {
+            return runOrder(rest);
+        }
+        if (command == "orders") {
+            return runOrders(rest);
+        }
+        if (command == "partition") {
+            return runPartition(rest);
+        }
+        if (command == "archive") {
+            return runArchive(rest);
+        }
+        if (command == "archive-search") {
+            return runArchiveSearch(rest);
+        }
+        if (command == "verify") {
+            return runVerify(rest);
+        }
+        if (command == "bench") {
+            return runBench(rest);
+        }
+        if (command == "generate") {
+            return runGenerate(rest);
+        }
+    } catch (const FileException& e) {
+        err_ << "error: " << e.what() << Qt::endl;
+        return Failure;
+    } catch (const StreamFileException& e) {
+        err_ << "error: " << e.what() << Qt::endl;
+        return Failure;
+    } catch (const MoneyException& e) {
+        err_ << "error: " << e.what() << Qt::endl;
+        return Failure;
+    }
+
+    err_ << "unknown command: " << command << Qt::endl;
+    printUsage();
+    return UsageError;
+}
+
+void AgencyCli::printUsage() const {
+    err_ << "usage: agencycli <command> [options]\n"
+         << "\n"
+         << "commands:\n"
+         << "  stats <data>                      load data, print record counts and timings\n"
+         << "  validate <data>                   check referential integrity and field ranges\n"
+         << "  convert <input> <output>          convert between formats (--from=, --to=)\n"
+         << "  relink <data> [--output=<path>]   relink tours and orders, optionally save\n"
+         << "  price <data> [--output=<csv>]     price every tour and order in batch\n"
+         << "  memory <data> [--top=N] [--json]  deep memory per entity type, string sharing\n"
+         << "  index <data>                      rebuild the record-offset indexes of tours and orders\n"
+         << "  order <data> <id>                 read one order through the index without a full load\n"
+         << "  orders <data> [--since=<date>] [--until=<date>]\n"
+         << "                                    count and total orders in a date range, reading only\n"
+         << "                                    the yearly partitions that overlap it\n"
+         << "  partition <data>                  split orders.txt into yearly partitions under <data>/orders\n"
+         << "  archive <data> [--before=<date>]  move completed and cancelled orders into the compressed\n"
+         << "                                    archive <data>/archive/orders.arc\n"
+         << "  archive-search <data> [--id=N] [--text=<s>] [--since=<date>] [--until=<date>] [--restore]\n"
+         << "                                    search archived orders, optionally move them back\n"
+         << "  verify <data> [--seal]            check the CRC32C block checksums of every data file and\n"
+         << "                                    report damaged blocks; --seal writes checksums for files\n"
+         << "                                    that have none or were edited by hand\n"
+         << "  bench [--sizes=1000,100000,1000000] [--iterations=5] [--filter=<name>] [--output=<json>]\n"
+         << "                                    run benchmarks on generated fixtures, print JSON\n"
+         << "  generate <output> [--records=N] [--seed=N] [--countries=N] [--cities=N] [--hotels=N]\n"
+         << "           [--rooms=N] [--companies=N] [--schedules=N] [--tours=N] [--orders=N]\n"
+         << "           [--country-skew=S] [--city-skew=S] [--format=<format>]\n"
+         << "                                    write a deterministic synthetic dataset\n"
+         << "\n"
+         << "formats: text (data directory), stream, json, binary\n"
+         << "  detected from the path unless --format=, --from= or --to= is given\n"
+         << "\n"
+         << "--trace=<json> records a Chrome trace of any command (open in chrome://tracing or Perfetto)\n"
+         << "--parser=mapped|stream selects the text loader (default: memory-mapped)\n"
+         << "--text-format=v2|v1 selects how tours.txt and orders.txt are written; v2 stores each\n"
+         << "  hotel and company once and references it, both are read, so convert <data> <out> migrates" << Qt::endl;
+}
+
+AgencyCli::Format AgencyCli::parseFormat(const QString& name) {
+    QString lower = name.toLower();
+    if (lower == "text" || lower == "txt") {
+        return Format::Text;
+    }
+    if (lower == "stream") {
+        return Format::Stream;
+    }
+    if (lower == "json") {
+        return Format::Json;
+    }
+    if (lower == "binary" || lower == "cbor" || lower == "bin") {
+        return Format::Binary;
+    }
+    return Format::Unknown;
+}
+
+QString AgencyCli::formatName(Format format) {
+    switch (format) {
+        case Format::Text: return "text";
+        case Format::Stream: return "stream";
+        case Format::Json: return "json";
+        case Format::Binary: return "binary";
+        default: return "unknown";
+    }
+}
+
+AgencyCli::Format AgencyCli::detectFormat(const QString& path) {
+    QFileInfo info(path);
+    if (info.isDir()) {
+        return QFile::exists(QDir(path).filePath("countries.txt")) ||
+               !QFile::exists(QDir(path).filePath("countries_stream.txt"))
+            ? Format::Text : Format::Stream;
+    }
+
+    QString suffix = info.suffix().toLower();
+    if (suffix == "json") {
+        return Format::Json;
+    }
+    if (suffix == "cbor" || suffix == "bin") {
+        return Format::Binary;
+    }
+    return suffix.isEmpty() ? Format::Text : Format::Unknown;
+}
+
+QString AgencyCli::option(const QStringList& arguments, const QString& name, const QString& defaultValue) {
+    QString prefix = "--" + name + "=";
+    for (const QString& argument : arguments) {
+        if (argument.startsWith(prefix)) {
+            return argument.mid(prefix.size());
+        }
+    }
+    return defaultValue;
+}
+
+bool AgencyCli::hasFlag(const QStringList& arguments, const QString& name) {
+    return arguments.contains("--" + name);
+}
+
+QStringList AgencyCli::positional(const QStringList& arguments) {
+    QStringList result;
+    for (const QString& argument : arguments) {
+        if (!argument.startsWith("--")) {
+            result.append(argument);
+        }
+    }
+    return result;
+}
+
+AgencyCli::Format AgencyCli::formatFor(const QStringList& arguments, const QString& name, const QString& path) {
+    QString explicitFormat = option(arguments, name);
+    return explicitFormat.isEmpty() ? detectFormat(path) : parseFormat(explicitFormat);
+}
+
+template<typename Step>
+void AgencyCli::timed(const QString& step, Step&& action) {
+    QElapsedTimer timer;
+    timer.start();
+    int records = std::forward<Step>(action)();
+    timings_.append(Timing{step, timer.nsecsElapsed(), records});
+}
+
+void AgencyCli::clear() {
+    countries_.clear();
+    hotels_.clear();
+    companies_.clear();
+    tours_.clear();
+    orders_.clear();
+    timings_.clear();
+    loadErrors_.clear();
+}
+
+bool AgencyCli::load(const QString& path, Format format) {
+    clear();
+
+    if (format == Format::Unknown) {
+        err_ << "cannot determine format of " << path << Qt::endl;
+        return false;
+    }
+
+    if (format == Format::Json || format == Format::Binary) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            throw FileException(QString("Cannot open file for reading: %1").arg(path));
+        }
+
+        QByteArray data;
+        timed("read", [&]() {
+            data = file.readAll();
+            return 1;
+        });
+
+        QJsonObject root;
+        timed("decode", [&]() {
+            root = JsonSerializer::decode(data, format == Format::Binary);
+            return 1;
+        });
+
+        timed("build", [&]() {
+            JsonSerializer::fromJson(root, countries_, hotels_, companies_, tours_, orders_);
+            return countries_.size() + hotels_.size() + companies_.size() + tours_.size() + orders_.size();
+        });
+        return true;
+    }
+
+    if (format == Format::Stream) {
+        StreamFileManager streamManager(path.toStdString());
+        std::string base = path.toStdString();
+        timed("countries", [&]() {
+            streamManager.loadCountries(countries_, base + "/countries_stream.txt");
+            return countries_.size();
+        });
+        timed("orders", [&]() {
+            streamManager.loadOrders(orders_, base + "/orders_stream.txt");
+            return orders_.size();
+        });
+        return true;
+    }
+
+    QDir dir(path);
+    fileManager_.takeChecksumWarnings();
+    auto loadStep = [&](const QString& step, auto&& action) {
+        try {
+            timed(step, action);
+        } catch (const FileException& e) {
+            loadErrors_.append(QString("%1: %2").arg(step, e.what()));
+        }
+    };
+
+    loadStep("countries", [&]() {
+        fileManager_.loadCountries(countries_, dir.filePath("countries.txt"));
+        return countries_.size();
+    });
+    loadStep("hotels", [&]() {
+        fileManager_.loadHotels(hotels_, dir.filePath("hotels.txt"));
+        return hotels_.size();
+    });
+    loadStep("transport", [&]() {
+        fileManager_.loadTransportCompanies(companies_, dir.filePath("transport_companies.txt"));
+        return companies_.size();
+    });
+    loadStep("tours", [&]() {
+        fileManager_.loadTours(tours_, dir.filePath("tours.txt"));
+        return tours_.size();
+    });
+    loadStep("orders", [&]() {
+        return loadOrders(path);
+    });
+    loadErrors_ = fileManager_.takeChecksumWarnings() + loadErrors_;
+
+    for (const QString& error : loadErrors_) {
+        err_ << "warning: " << error << Qt::endl;
+    }
+    return loadErrors_.size() < 5;
+}
+
+void AgencyCli::save(const QString& path, Format format) const {
+    if (format == Format::Json || format == Format::Binary) {
+        QByteArray data = JsonSerializer::encode(
+            JsonSerializer::toJson(countries_, hotels_, companies_, tours_, orders_),
+            format == Format::Binary);
+
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            throw FileException(QString("Cannot open file for writing: %1").arg(path));
+        }
+        if (file.write(data) != data.size()) {
+            throw FileException(QString("Error writing to file: %1").arg(path));
+        }
+        return;
+    }
+
+    if (format == Format::Stream) {
+        StreamFileManager streamManager(path.toStdString());
+        streamManager.saveAll(countries_, orders_, path.toStdString());
+        return;
+    }
+
+    if (format == Format::Text) {
+        QDir().mkpath(path);
+        fileManager_.saveAll(countries_, hotels_, companies_, tours_, orders_, path);
+        return;
+    }
+
+    throw FileException(QString("Unsupported output format for %1").arg(path));
+}
+
+void AgencyCli::relink() {
+    TourLinker linker(&countries_, &hotels_, &companies_, &tours_, &orders_);
+    timed("link tours", [&]() {
+        return linker.linkTours().tours;
+    });
+    timed("link orders", [&]() {
+        return linker.linkOrders().orders;
+    });
+}
+
+void AgencyCli::printTimings() const {
+    qint64 total = 0;
+    out_ << "timings:\n";
+    for (const Timing& timing : timings_) {
+        out_ << "  " << timing.step.leftJustified(12) << " "
+             << QString::number(timing.nanoseconds / 1.0e6, 'f', 3).rightJustified(10) << " ms  "
+             << timing.records << " records\n";
+        total += timing.nanoseconds;
+    }
+    out_ << "  " << QString("total").leftJustified(12) << " "
+         << QString::number(total / 1.0e6, 'f', 3).rightJustified(10) << " ms" << Qt::endl;
+}
+
+int AgencyCli::runStats(const QStringList& arguments) {
+    QStringList paths = positional(arguments);
+    if (paths.size() != 1) {
+        err_ << "usage: agencycli stats <data> [--format=<format>]" << Qt::endl;
+        return UsageError;
+    }
+
+    if (!load(paths.first(), formatFor(arguments, "format", paths.first()))) {
+        return Failure;
+    }
+    relink();
+
+    int rooms = 0;
+    for (const auto& hotel : hotels_.getData()) {
+        rooms += hotel.getRoomCount();
+    }
+    int schedules = 0;
+    for (const auto& company : companies_.getData()) {
+        schedules += company.getScheduleCount();
+    }
+
+    out_ << "countries:  " << countries_.size() << "\n"
+         << "hotels:     " << hotels_.size() << " (" << rooms << " rooms)\n"
+         << "transport:  " << companies_.size() << " (" << schedules << " schedules)\n"
+         << "tours:      " << tours_.size() << "\n"
+         << "orders:     " << orders_.size() << "\n";
+    printTimings();
+    return loadErrors_.isEmpty() ? Success : Failure;
+}
+
+QStringList AgencyCli::validate() const {
+    QStringList issues;
+
+    QSet<Symbol> countryNames;
+    for (const auto& country : countries_.getData()) {
+        Symbol name(country.getName());
+        if (name.isEmpty()) {
+            issues.append("country with empty name");
+        } else if (countryNames.contains(name)) {
+            issues.append(QString("duplicate country '%1'").arg(country.getName()));
+        }
+        countryNames.insert(name);
+    }
+
+    for (const auto& hotel : hotels_.getData()) {
+        if (!countryNames.contains(hotel.getCountrySymbol())) {
+            issues.append(QString("hotel '%1' references unknown country '%2'").arg(hotel.getName(), hotel.getCountry()));
+        }
+        if (hotel.getStars() < 1 || hotel.getStars() > 5) {
+            issues.append(QString("hotel '%1' has %2 stars").arg(hotel.getName()).arg(hotel.getStars()));
+        }
+        for (const Room& room : hotel.getRooms()) {
+            if (!room.getPricePerNight().isPositive() || room.getCapacity() <= 0) {
+                issues.append(QString("hotel '%1' room '%2' has invalid price or capacity").arg(hotel.getName(), room.getName()));
+            }
+        }
+    }
+
+    for (const auto& company : companies_.getData()) {
+        const QVector<TransportSchedule> schedules = company.getSchedules();
+        for (int i = 0; i < schedules.size(); ++i) {
+            const TransportSchedule& schedule = schedules[i];
+            QString where = QString("transport '%1' schedule %2").arg(company.getName()).arg(i);
+            if (schedule.departureCity.isEmpty() || schedule.arrivalCity.isEmpty()) {
+                issues.append(where + " has an empty city");
+            } else if (schedule.departureCity == schedule.arrivalCity) {
+                issues.append(where + " departs and arrives in the same city");
+            }
+            if (schedule.departureDate.isValid() && schedule.arrivalDate.isValid() &&
+                schedule.arrivalDate < schedule.departureDate) {
+                issues.append(where + " arrives before it departs");
+            }
+            if (schedule.price.kopecks() < 0) {
+                issues.append(where + " has a negative price");
+            }
+        }
+    }
+
+    QSet<QString> tourKeys;
+    for (const auto& tour : tours_.getData()) {
+        if (!countryNames.contains(tour.getCountrySymbol())) {
+            issues.append(QString("tour '%1' references unknown country '%2'").arg(tour.getName(), tour.getCountry()));
+        }
+        if (tour.getStartDate().isValid() && tour.getEndDate().isValid() &&
+            tour.getEndDate() < tour.getStartDate()) {
+            issues.append(QString("tour '%1' ends before it starts").arg(tour.getName()));
+        }
+        tourKeys.insert(tour.getName() + '\n' + tour.getCountry());
+    }
+
+    QSet<int> orderIds;
+    for (const auto& order : orders_.getData()) {
+        if (!order.hasId()) {
+            issues.append(QString("order for '%1' has no id").arg(order.getClientName()));
+        } else if (orderIds.contains(order.getId())) {
+            issues.append(QString("duplicate order id %1").arg(order.getId()));
+        }
+        orderIds.insert(order.getId());
+
+        if (!tourKeys.contains(order.getTourName() + '\n' + order.getTourCountry())) {
+            issues.append(QString("order %1 references unknown tour '%2'").arg(order.getId()).arg(order.getTourName()));
+        }
+    }
+
+    return issues;
+}
+
+int AgencyCli::runValidate(const QStringList& arguments) {
+    QStringList paths = positional(arguments);
+    if (paths.size() != 1) {
+        err_ << "usage: agencycli validate <data> [--format=<format>]" << Qt::endl;
+        return UsageError;
+    }
+
+    if (!load(paths.first(), formatFor(arguments, "format", paths.first()))) {
+        return Failure;
+    }
+
+    QStringList issues = loadErrors_ + validate();
+    for (const QString& issue : issues) {
+        out_ << issue << "\n";
+    }
+    out_ << issues.size() << " issue(s) found" << Qt::endl;
+    return issues.isEmpty() ? Success : Failure;
+}
+
+int AgencyCli::runConvert(const QStringList& arguments) {
+    QStringList paths = positional(arguments);
+    if (paths.size() != 2) {
+        err_ << "usage: agencycli convert <input> <output> [--from=<format>] [--to=<format>]" << Qt::endl;
+        return UsageError;
+    }
+
+    Format from = formatFor(arguments, "from", paths[0]);
+    QString toName = option(arguments, "to");
+    Format to = toName.isEmpty() ? detectFormat(paths[1]) : parseFormat(toName);
+    if (to == Format::Unknown) {
+        err_ << "cannot determine output format for " << paths[1] << Qt::endl;
+        return UsageError;
+    }
+    if (from == Format::Stream || to == Format::Stream) {
+        err_ << "note: the stream format only holds countries and orders" << Qt::endl;
+    }
+
+    if (!load(paths[0], from)) {
+        return Failure;
+    }
+    if (hasFlag(arguments, "relink")) {
+        relink();
+    }
+
+    timed("write", [&]() {
+        save(paths[1], to);
+        return countries_.size() + hotels_.size() + companies_.size() + tours_.size() + orders_.size();
+    });
+
+    out_ << "converted " << formatName(from) << " -> " << formatName(to) << "\n";
+    printTimings();
+    return Success;
+}
+
+int AgencyCli::runRelink(const QStringList& arguments) {
+    QStringList paths = positional(arguments);
+    if (paths.size() != 1) {
+        err_ << "usage: agencycli relink <data> [--format=<format>] [--output=<path>]" << Qt::endl;
+        return UsageError;
+    }
+
+    if (!load(paths.first(), formatFor(arguments, "format", paths.first()))) {
+        return Failure;
+    }
+
+    TourLinker linker(&countries_, &hotels_, &companies_, &tours_, &orders_);
+    TourLinker::Result tours;
+    TourLinker::Result orders;
+    timed("link tours", [&]() {
+        tours = linker.linkTours();
+        return tours.tours;
+    });
+    timed("link orders", [&]() {
+        orders = linker.linkOrders();
+        return orders.orders;
+    });
+
+    out_ << "tours:  " << tours.tours << " (" << tours.withHotel << " with hotel, "
+         << tours.withTransport << " with transport)\n"
+         << "orders: " << orders.orders << " (" << orders.ordersLinked << " linked to tours)\n";
+
+    QString output = option(arguments, "output");
+    if (!output.isEmpty()) {
+        Format format = formatFor(arguments, "to", output);
+        timed("write", [&]() {
+            save(output, format);
+            return tours_.size() + orders_.size();
+        });
+        out_ << "saved to " << output << " (" << formatName(format) << ")\n";
+    }
+
+    printTimings();
+    return Success;
+}
+
+int AgencyCli::runPrice(const QStringList& arguments) {
+    QStringList paths = positional(arguments);
+    if (paths.size() != 1) {
+        err_ << "usage: agencycli price <data> [--format=<format>] [--output=<csv>]" << Qt::endl;
+        return UsageError;
+    }
+
+    if (!load(paths.first(), formatFor(arguments, "format", paths.first()))) {
+        return Failure;
+    }
+    relink();
+
+    QFile file;
+    QTextStream fileStream;
+    QString output = option(arguments, "output");
+    if (!output.isEmpty()) {
+        file.setFileName(output);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+            throw FileException(QString("Cannot open file for writing: %1").arg(output));
+        }
+        fileStream.setDevice(&file);
+        fileStream.setEncoding(QStringConverter::Encoding::Utf8);
+    }
+    QTextStream& csv = output.isEmpty() ? out_ : fileStream;
+
+    Money tourTotal;
+    Money orderTotal;
+    timed("price", [&]() {
+        csv << "kind;id;name;country;start;end;nights;transport;hotel;total\n";
+        int index = 0;
+        for (const auto& tour : tours_.getData()) {
+            Money cost = tour.calculateCost();
+            tourTotal += cost;
+            csv << "tour;" << index++ << ";" << tour.getName() << ";" << tour.getCountry() << ";"
+                << tour.getStartDate().toString(Qt::ISODate) << ";" << tour.getEndDate().toString(Qt::ISODate) << ";"
+                << tour.getDuration() << ";" << tour.getTransportSchedule().price.toString() << ";"
+                << tour.getHotel().getName() << ";" << cost.toString() << "\n";
+        }
+        for (const auto& order : orders_.getData()) {
+            const Tour tour = order.getTour();
+            Money cost = order.getTotalCost();
+            orderTotal += cost;
+            csv << "order;" << order.getId() << ";" << tour.getName() << ";" << tour.getCountry() << ";"
+                << tour.getStartDate().toString(Qt::ISODate) << ";" << tour.getEndDate().toString(Qt::ISODate) << ";"
+                << tour.getDuration() << ";" << tour.getTransportSchedule().price.toString() << ";"
+                << tour.getHotel().getName() << ";" << cost.toString() << "\n";
+        }
+        csv.flush();
+        return tours_.size() + orders_.size();
+    });
+
+    err_ << "tours total:  " << tourTotal.toString() << "\n"
+         << "orders total: " << orderTotal.toString() << Qt::endl;
+    if (!output.isEmpty()) {
+        printTimings();
+    }
+    return Success;
+}
+
+int AgencyCli::runMemory(const QStringList& arguments) {
+    QStringList paths = positional(arguments);
+    if (paths.size() != 1) {
+        err_ << "usage: agencycli memory <data> [--format=<format>] [--top=N] [--json]" << Qt::endl;
+        return UsageError;
+    }
+
+    bool ok = false;
+    int top = option(arguments, "top", "10").toInt(&ok);
+    if (!ok || top < 0) {
+        err_ << "invalid --top value" << Qt::endl;
+        return UsageError;
+    }
+
+    if (!load(paths.first(), formatFor(arguments, "format", paths.first()))) {
+        return Failure;
+    }
+    relink();
+
+    MemoryAccounting::Report report;
+    timed("measure", [&]() {
+        report = MemoryAccounting::measure(countries_, hotels_, companies_, tours_, orders_, top);
+        return countries_.size() + hotels_.size() + companies_.size() + tours_.size() + orders_.size();
+    });
+
+    if (hasFlag(arguments, "json")) {
+        out_ << QString::fromUtf8(QJsonDocument(MemoryAccounting::toJson(report)).toJson(QJsonDocument::Indented))
+             << Qt::flush;
+        return Success;
+    }
+
+    out_ << MemoryAccounting::toText(report);
+    printTimings();
+    return Success;
+}
+
+int AgencyCli::runIndex(const QStringList& arguments) {
+    QStringList paths = positional(arguments);
+    if (paths.size() != 1) {
+        err_ << "usage: agencycli index <data>" << Qt::endl;
+        return UsageError;
+    }
+
+    MappedFileParser parser;
+    QDir dir(paths.first());
+    QStringList files = QStringList{dir.filePath("tours.txt")} + orderFiles(paths.first());
+    for (const QString& filename : files) {
+        QString name = dir.relativeFilePath(filename);
+        RecordIndex index;
+        timed(name, [&]() {
+            index = parser.buildIndex(filename);
+            return index.size(RecordIndex::Records);
+        });
+        if (!index.save(RecordIndex::pathFor(filename))) {
+            err_ << "error: cannot write " << RecordIndex::pathFor(filename) << Qt::endl;
+            return Failure;
+        }
+        out_ << name << ": " << index.header() << ", " << index.size(RecordIndex::Records) << " records, "
+             << index.size(RecordIndex::Hotels) << " hotels, " << index.size(RecordIndex::Companies)
+             << " companies, " << index.size(RecordIndex::Tours) << " tours in catalog\n";
+    }
+    printTimings();
+    return Success;
+}
+
+int AgencyCli::runOrder(const QStringList& arguments) {
+    QStringList paths = positional(arguments);
+    bool ok = false;
+    int orderId = paths.size() == 2 ? paths[1].toInt(&ok) : 0;
+    if (!ok) {
+        err_ << "usage: agencycli order <data> <id>" << Qt::endl;
+        return UsageError;
+    }
+
+    int row = -1;
+    Order order;
+    for (const QString& filename : orderFiles(paths.first())) {
+        RecordIndex index;
+        timed("index", [&]() {
+            index = fileManager_.openIndex(filename);
+            return index.size(RecordIndex::Records);
+        });
+
+        row = index.find(RecordIndex::Records, RecordIndex::orderKey(orderId));
+        while (row >= 0) {
+            order = fileManager_.readOrder(filename, index, row);
+            if (order.getId() == orderId) {
+                break;
+            }
+            row = index.find(RecordIndex::Records, RecordIndex::orderKey(orderId), row + 1);
+        }
+        if (row >= 0) {
+            break;
+        }
+    }
+    if (row < 0) {
+        err_ << "order " << orderId << " not found in " << paths.first() << Qt::endl;
+        return Failure;
+    }
+
+    Tour tour = order.getTour();
+    out_ << order.toString() << "\n"
+         << "  client:  " << order.getClientName() << ", " << order.getClientPhone() << ", "
+         << order.getClientEmail() << "\n"
+         << "  date:    " << order.getOrderDate().date().toString(Qt::ISODate) << "\n"
+         << "  tour:    " << tour.getName() << " (" << tour.getCountry() << ") "
+         << tour.getStartDate().toString(Qt::ISODate) << " - " << tour.getEndDate().toString(Qt::ISODate) << "\n"
+         << "  hotel:   " << tour.getHotel().getName() << "\n"
+         << "  carrier: " << tour.getTransportCompany().getName() << "\n";
+    printTimings();
+    return Success;
+}
+
+QStringList AgencyCli::orderFiles(const QString& dataPath) {
+    if (!OrderPartitions::existIn(dataPath)) {
+        return {QDir(dataPath).filePath("orders.txt")};
+    }
+    OrderPartitions partitions(dataPath);
+    partitions.readCatalog();
+    return partitions.sourceFiles().mid(1);
+}
+
+int AgencyCli::loadOrders(const QString& dataPath) {
+    if (OrderPartitions::existIn(dataPath)) {
+        OrderPartitions partitions(dataPath);
+        partitions.readCatalog();
+        orders_.clear();
+        partitions.loadAll(fileManager_, orders_);
+    } else {
+        fileManager_.loadOrders(orders_, QDir(dataPath).filePath("orders.txt"));
+    }
+    return orders_.size();
+}
+
+void AgencyCli::saveOrders(const QString& dataPath) const {
+    if (OrderPartitions::existIn(dataPath)) {
+        OrderPartitions partitions(dataPath);
+        partitions.readCatalog();
+        partitions.markAllLoaded();
+        partitions.save(fileManager_, orders_);
+    } else {
+        fileManager_.saveOrders(orders_, QDir(dataPath).filePath("orders.txt"));
+    }
+}
+
+int AgencyCli::runOrders(const QStringList& arguments) {
+    QStringList paths = positional(arguments);
+    QDate since = QDate::fromString(option(arguments, "since"), Qt::ISODate);
+    QDate until = QDate::fromString(option(arguments, "until"), Qt::ISODate);
+    if (paths.size() != 1 || (!option(arguments, "since").isEmpty() && !since.isValid()) ||
+        (!option(arguments, "until").isEmpty() && !until.isValid())) {
+        err_ << "usage: agencycli orders <data> [--since=YYYY-MM-DD] [--until=YYYY-MM-DD]" << Qt::endl;
+        return UsageError;
+    }
+
+    if (OrderPartitions::existIn(paths.first())) {
+        OrderPartitions partitions(paths.first());
+        partitions.readCatalog();
+        QVector<int> rows = partitions.prune(since, until);
+        timed("orders", [&]() {
+            return partitions.load(fileManager_, orders_, rows);
+        });
+        out_ << "partitions: " << rows.size() << " of " << partitions.partitions().size() << " read\n";
+    } else {
+        timed("orders", [&]() {
+            fileManager_.loadOrders(orders_, QDir(paths.first()).filePath("orders.txt"));
+            return orders_.size();
+        });
+    }
+
+    OrderColumnStore columns;
+    columns.rebuild(orders_);
+    RowMask mask = columns.allRows();
+    columns.filterOrderDay(since.isValid() ? IntervalIndex::dayOf(since) : std::numeric_limits<qint64>::min(),
+                           until.isValid() ? IntervalIndex::dayOf(until) : std::numeric_limits<qint64>::max(),
+                           mask);
+    int matched = std::count(mask.cbegin(), mask.cend(), 1);
+    RowMask unpaid = mask;
+    columns.filterUnpaid(unpaid);
+
+    out_ << "orders:     " << matched << " (" << std::count(unpaid.cbegin(), unpaid.cend(), 1) << " unpaid)\n"
+         << "total:      " << Money(columns.totalCost(mask)).toString() << "\n";
+    printTimings();
+    return Success;
+}
+
+int AgencyCli::runPartition(const QStringList& arguments) {
+    QStringList paths = positional(arguments);
+    if (paths.size() != 1) {
+        err_ << "usage: agencycli partition <data>" << Qt::endl;
+        return UsageError;
+    }
+
+    OrderPartitions partitions(paths.first());
+    QString ordersPath = QDir(paths.first()).filePath("orders.txt");
+    bool migrating = !partitions.readCatalog();
+    timed("load", [&]() {
+        if (migrating) {
+            fileManager_.loadOrders(orders_, ordersPath);
+        } else {
+            partitions.loadAll(fileManager_, orders_);
+        }
+        return orders_.size();
+    });
+    timed("partition", [&]() {
+        partitions.markAllLoaded();
+        partitions.save(fileManager_, orders_);
+        return orders_.size();
+    });
+    if (migrating) {
+        QFile::remove(ordersPath);
+        QFile::remove(RecordIndex::pathFor(ordersPath));
+        QFile::remove(BlockChecksums::pathFor(ordersPath));
+    }
+
+    for (const OrderPartitions::Partition& partition : partitions.partitions()) {
+        out_ << "  " << partition.fileName.leftJustified(22) << " "
+             << QString::number(partition.orderCount).rightJustified(9) << " orders, "
+             << partition.openCount << " open, "
+             << partition.firstDate.toString(Qt::ISODate) << " - " << partition.lastDate.toString(Qt::ISODate) << "\n";
+    }
+    printTimings();
+    return Success;
+}
+
+int AgencyCli::runArchive(const QStringList& arguments) {
+    QStringList paths = positional(arguments);
+    QDate before = QDate::fromString(option(arguments, "before"), Qt::ISODate);
+    if (paths.size() != 1 || (!option(arguments, "before").isEmpty() && !before.isValid())) {
+        err_ << "usage: agencycli archive <data> [--before=YYYY-MM-DD]" << Qt::endl;
+        return UsageError;
+    }
+
+    OrderArchive archive(paths.first());
+    timed("load", [&]() {
+        archive.open();
+        return loadOrders(paths.first());
+    });
+    int moved = 0;
+    timed("archive", [&]() {
+        moved = archive.archive(orders_, before);
+        return moved;
+    });
+    if (moved > 0) {
+        timed("save", [&]() {
+            saveOrders(paths.first());
+            return orders_.size();
+        });
+    }
+
+    out_ << "archived:   " << moved << "\n"
+         << "hot:        " << orders_.size() << "\n"
+         << "in archive: " << archive.size() << " (" << archive.blocks().size() << " blocks, "
+         << QFileInfo(archive.path()).size() << " bytes)\n";
+    printTimings();
+    return Success;
+}
+
+int AgencyCli::runArchiveSearch(const QStringList& arguments) {
+    QStringList paths = positional(arguments);
+    OrderArchive::Query query;
+    query.id = option(arguments, "id", "0").toInt();
+    query.text = option(arguments, "text");
+    query.since = QDate::fromString(option(arguments, "since"), Qt::ISODate);
+    query.until = QDate::fromString(option(arguments, "until"), Qt::ISODate);
+    if (paths.size() != 1 || (!option(arguments, "since").isEmpty() && !query.since.isValid()) ||
+        (!option(arguments, "until").isEmpty() && !query.until.isValid())) {
+        err_ << "usage: agencycli archive-search <data> [--id=N] [--text=<s>] [--since=YYYY-MM-DD] "
+                "[--until=YYYY-MM-DD] [--restore]" << Qt::endl;
+        return UsageError;
+    }
+
+    OrderArchive archive(paths.first());
+    DataContainer<Order> found;
+    timed("search", [&]() {
+        archive.open();
+        found = archive.search(query);
+        return found.size();
+    });
+    for (const auto& order : found.getData()) {
+        out_ << order.toString() << ", " << order.getOrderDate().date().toString(Qt::ISODate) << "\n";
+    }
+    out_ << "found:      " << found.size() << " of " << archive.size() << " archived\n";
+
+    if (hasFlag(arguments, "restore") && !found.isEmpty()) {
+        QVector<int> ids;
+        for (const auto& order : found.getData()) {
+            ids.append(order.getId());
+        }
+        int restored = 0;
+        timed("restore", [&]() {
+            loadOrders(paths.first());
+            restored = archive.restore(ids, orders_);
+            saveOrders(paths.first());
+            return restored;
+        });
+        out_ << "restored:   " << restored << "\n";
+    }
+    printTimings();
+    return Success;
+}
+
+int AgencyCli::runVerify(const QStringList& arguments) {
+    QStringList paths = positional(arguments);
+    if (paths.size() != 1) {
+        err_ << "usage: agencycli verify <data> [--seal]" << Qt::endl;
+        return UsageError;
+    }
+
+    QVector<BlockChecksums::Report> reports;
+    timed("verify", [&]() {
+        reports = BlockChecksums::verifyDirectory(paths.first());
+        return reports.size();
+    });
+
+    QDir dir(paths.first());
+    bool seal = hasFlag(arguments, "seal");
+    qint64 checked = 0;
+    int corrupt = 0;
+    for (BlockChecksums::Report report : reports) {
+        QString filename = report.filename;
+        report.filename = dir.relativeFilePath(filename);
+        out_ << report.describe() << "\n";
+        if (report.status != BlockChecksums::Status::Unchecked) {
+            checked += report.size;
+        }
+        if (report.isCorrupt()) {
+            ++corrupt;
+        }
+        if (seal && (report.status == BlockChecksums::Status::Unchecked || report.changedAfterSeal)) {
+            if (!BlockChecksums::seal(filename)) {
+                err_ << "error: cannot write " << BlockChecksums::pathFor(filename) << Qt::endl;
+                return Failure;
+            }
+            out_ << "  sealed " << BlockChecksums::pathFor(report.filename) << "\n";
+        }
+    }
+
+    qint64 elapsed = timings_.last().nanoseconds;
+    out_ << reports.size() << " file(s), " << checked << " bytes checked with crc32c (" << Crc32c::implementation() << ")";
+    if (elapsed > 0) {
+        out_ << " at " << QString::number(checked / static_cast<double>(elapsed), 'f', 2) << " GB/s";
+    }
+    out_ << ", " << corrupt << " corrupt\n";
+    printTimings();
+    return corrupt == 0 ? Success : Failure;
+}
+
+int AgencyCli::runBench(const QStringList& arguments) {
+    QVector<int> sizes;
+    for (const QString& size : option(arguments, "sizes", "1000,100000,1000000").split(',', Qt::SkipEmptyParts)) {
+        bool ok = false;
+        int records = size.trimmed().toInt(&ok);
+        if (!ok || records <= 0) {
+            err_ << "invalid size: " << size << Qt::endl;
+            return UsageError;
+        }
+        sizes.append(records);
+    }
+
+    bool ok = false;
+    int iterations = option(arguments, "iterations", "5").toInt(&ok);
+    if (!ok || iterations <= 0) {
+        err_ << "invalid iteration count" << Qt::endl;
+        return UsageError;
+    }
+
+    AgencyBench bench(err_);
+    bench.setIterations(iterations);
+    bench.setFilter(option(arguments, "filter"));
+
+    QVector<AgencyBench::Result> results;
+    for (int records : sizes) {
+        results += bench.run(records);
+    }
+
+    QByteArray json = QJsonDocument(AgencyBench::toJson(results, sizes)).toJson(QJsonDocument::Indented);
+    QString output = option(arguments, "output");
+    if (output.isEmpty()) {
+        out_ << QString::fromUtf8(json) << Qt::flush;
+        return Success;
+    }
+
+    QFile file(output);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(json) != json.size()) {
+        throw FileException(QString("Cannot write benchmark results to %1").arg(output));
+    }
+    err_ << "results written to " << output << Qt::endl;
+    return Success;
+}
+
+int AgencyCli::runGenerate(const QStringList& arguments) {
+    QStringList paths = positional(arguments);
+    if (paths.size() != 1) {
+        err_ << "usage: agencycli generate <output> [--records=N] [--seed=N] [...]" << Qt::endl;
+        return UsageError;
+    }
+
+    bool valid = true;
+    auto number = [&](const QString& name, qint64 defaultValue) {
+        QString text = option(arguments, name);
+        if (text.isEmpty()) {
+            return defaultValue;
+        }
+        bool ok = false;
+        qint64 value = text.toLongLong(&ok);
+        if (!ok || value < 0 || (name != "seed" && value > std::numeric_limits<int>::max())) {
+            err_ << "invalid --" << name << "=" << text << Qt::endl;
+            valid = false;
+        }
+        return value;
+    };
+    auto skew = [&](const QString& name, double defaultValue) {
+        QString text = option(arguments, name);
+        if (text.isEmpty()) {
+            return defaultValue;
+        }
+        bool ok = false;
+        double value = text.toDouble(&ok);
+        if (!ok || value < 0.0) {
+            err_ << "invalid --" << name << "=" << text << Qt::endl;
+            valid = false;
+        }
+        return value;
+    };
+
+    DatasetGenerator::Options options = DatasetGenerator::Options::forRecords(
+        static_cast<int>(number("records", 100000)));
+    options.seed = static_cast<quint64>(number("seed", static_cast<qint64>(options.seed)));
+    options.countries = static_cast<int>(number("countries", options.countries));
+    options.citiesPerCountry = static_cast<int>(number("cities", options.citiesPerCountry));
+    options.hotels = static_cast<int>(number("hotels", options.hotels));
+    options.roomsPerHotel = static_cast<int>(number("rooms", options.roomsPerHotel));
+    options.companies = static_cast<int>(number("companies", options.companies));
+    options.schedulesPerCompany = static_cast<int>(number("schedules", options.schedulesPerCompany));
+    options.tours = static_cast<int>(number("tours", options.tours));
+    options.orders = static_cast<int>(number("orders", options.orders));
+    options.countrySkew = skew("country-skew", options.countrySkew);
+    options.citySkew = skew("city-skew", options.citySkew);
+    if (!valid) {
+        return UsageError;
+    }
+    if (options.countries == 0 || options.citiesPerCountry == 0) {
+        err_ << "at least one country and one city per country are required" << Qt::endl;
+        return UsageError;
+    }
+
+    QString output = paths.first();
+    QString formatOption = option(arguments, "format");
+    Format format = formatOption.isEmpty() ? detectFormat(output) : parseFormat(formatOption);
+    DatasetGenerator generator(options);
+
+    QElapsedTimer timer;
+    timer.start();
+    qint64 written = 0;
+    if (format == Format::Text) {
+        written = generator.writeText(output, [this](const QString& file, qint64 records) {
+            err_ << "  " << file << ": " << records << Qt::endl;
+        });
+    } else if (format == Format::Json || format == Format::Binary) {
+        generator.generate(countries_, hotels_, companies_, tours_, orders_);
+        OrderIdAllocator::instance().observe(orders_.size());
+        save(output, format);
+        written = countries_.size() + hotels_.size() + companies_.size() + tours_.size() + orders_.size();
+    } else {
+        err_ << "generate supports text, json and binary output" << Qt::endl;
+        return UsageError;
+    }
+
+    double seconds = timer.nsecsElapsed() / 1.0e9;
+    out_ << "generated " << written << " records (" << formatName(format) << ") in "
+         << QString::number(seconds, 'f', 2) << " s";
+    if (seconds > 0.0) {
+        out_ << ", " << QString::number(written / seconds, 'f', 0) << " records/s";
+    }
+    out_ << Qt::endl;
+    return Success;
+}
@@ -0,0 +1,23 @@
+#include "tools/agencycli.h"
+
+#include <QCoreApplication>
+#include <QTextStream>
+#include <cstdio>
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("agencycli");
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    out.setEncoding(QStringConverter::Encoding::Utf8);
+    err.setEncoding(QStringConverter::Encoding::Utf8);
+
+    AgencyCli cli(out, err);
+    int code = cli.run(QCoreApplication::arguments().mid(1));
+
+    out.flush();
+    err.flush();
+    return code;
+}
@@ -0,0 +1,272 @@
+#include "tools/datasetgenerator.h"
+#include "models/orderstatus.h"
+#include "utils/filemanager.h"
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+struct CountrySeed {
+    const char* name;
+    const char* continent;
+    const char* capital;
+    const char* currency;
+};
+
+const CountrySeed countrySeeds[] = {
+    {"Турция", "Азия", "Анкара", "TRY"},
+    {"Египет", "Африка", "Каир", "EGP"},
+    {"Италия", "Европа", "Рим", "EUR"},
+    {"Испания", "Европа", "Мадрид", "EUR"},
+    {"Франция", "Европа", "Париж", "EUR"},
+    {"Греция", "Европа", "Афины", "EUR"},
+    {"ОАЭ", "Азия", "Абу-Даби", "AED"},
+    {"Таиланд", "Азия", "Бангкок", "THB"},
+    {"Грузия", "Азия", "Тбилиси", "GEL"},
+    {"Черногория", "Европа", "Подгорица", "EUR"},
+    {"Кипр", "Европа", "Никосия", "EUR"},
+    {"Тунис", "Африка", "Тунис", "TND"},
+    {"Вьетнам", "Азия", "Ханой", "VND"},
+    {"Мексика", "Северная Америка", "Мехико", "MXN"},
+    {"Бразилия", "Южная Америка", "Бразилиа", "BRL"},
+    {"Австралия", "Австралия", "Канберра", "AUD"}
+};
+
+const char* departureCities[] = {"Минск", "Москва", "Вильнюс", "Варшава", "Брест", "Гомель"};
+
+constexpr int countrySeedCount = sizeof(countrySeeds) / sizeof(countrySeeds[0]);
+constexpr int departureCityCount = sizeof(departureCities) / sizeof(departureCities[0]);
+
+}
+
+DatasetGenerator::Options DatasetGenerator::Options::forRecords(int records) {
+    Options options;
+    options.countries = std::clamp(records / 1000, countrySeedCount, 200);
+    options.hotels = std::max(10, records / 20);
+    options.companies = std::max(5, records / 1000);
+    options.tours = records;
+    options.orders = records;
+    return options;
+}
+
+DatasetGenerator::DatasetGenerator(const Options& options)
+    : options_(options)
+    , firstDay_(2025, 1, 1)
+    , countryTable_(zipfTable(std::max(1, options.countries), options.countrySkew))
+    , cityTable_(zipfTable(std::max(1, options.citiesPerCountry), options.citySkew))
+{
+}
+
+QVector<double> DatasetGenerator::zipfTable(int count, double skew) {
+    QVector<double> table(count);
+    double total = 0.0;
+    for (int i = 0; i < count; ++i) {
+        total += 1.0 / std::pow(i + 1.0, std::max(0.0, skew));
+        table[i] = total;
+    }
+    for (double& value : table) {
+        value /= total;
+    }
+    return table;
+}
+
+quint64 DatasetGenerator::random(quint64 stream, qint64 index) const {
+    quint64 z = options_.seed + stream * 0x9E3779B97F4A7C15ULL + quint64(index) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+int DatasetGenerator::pick(quint64 stream, qint64 index, int bound) const {
+    return bound > 0 ? static_cast<int>(random(stream, index) % quint64(bound)) : 0;
+}
+
+int DatasetGenerator::pickSkewed(const QVector<double>& table, quint64 stream, qint64 index) const {
+    double unit = static_cast<double>(random(stream, index) >> 11) * (1.0 / 9007199254740992.0);
+    auto it = std::upper_bound(table.cbegin(), table.cend(), unit);
+    return it == table.cend() ? table.size() - 1 : static_cast<int>(it - table.cbegin());
+}
+
+QString DatasetGenerator::countryName(int index) const {
+    if (index < countrySeedCount) {
+        return QString::fromUtf8(countrySeeds[index].name);
+    }
+    return QString("Страна %1").arg(index);
+}
+
+QString DatasetGenerator::capitalOf(int countryIndex) const {
+    if (countryIndex < countrySeedCount) {
+        return QString::fromUtf8(countrySeeds[countryIndex].capital);
+    }
+    return QString("Столица %1").arg(countryIndex);
+}
+
+QString DatasetGenerator::cityIn(int countryIndex, int variant) const {
+    return variant == 0 ? capitalOf(countryIndex) : QString("%1-%2").arg(capitalOf(countryIndex)).arg(variant);
+}
+
+Country DatasetGenerator::country(int index) const {
+    Country result(countryName(index));
+    if (index < countrySeedCount) {
+        result.setContinent(QString::fromUtf8(countrySeeds[index].continent));
+        result.setCurrency(QString::fromUtf8(countrySeeds[index].currency));
+    } else {
+        result.setContinent(QString::fromUtf8(countrySeeds[index % countrySeedCount].continent));
+        result.setCurrency(QString::fromUtf8(countrySeeds[index % countrySeedCount].currency));
+    }
+    result.setCapital(capitalOf(index));
+    return result;
+}
+
+Hotel DatasetGenerator::hotel(int index) const {
+    int countryIndex = pickSkewed(countryTable_, 0, index);
+    int stars = 1 + pick(1, index, 5);
+    QString city = cityIn(countryIndex, pickSkewed(cityTable_, 2, index));
+
+    Hotel result(QString("Отель %1").arg(index), countryName(countryIndex), stars,
+                 QString("%1, ул. Морская, %2").arg(city).arg(1 + pick(3, index, 200)));
+
+    static const Room::RoomType types[] = {
+        Room::RoomType::Single, Room::RoomType::Double, Room::RoomType::Suite, Room::RoomType::Apartment
+    };
+    for (int room = 0; room < options_.roomsPerHotel; ++room) {
+        qint64 key = qint64(index) * options_.roomsPerHotel + room;
+        Room::RoomType type = types[pick(4, key, 4)];
+        Money price(qint64(3000 + pick(5, key, 25000)) * 100);
+        result.addRoom(Room(Room::roomTypeToString(type), type, price, 1 + pick(6, key, 4)));
+    }
+    return result;
+}
+
+TransportCompany DatasetGenerator::company(int index) const {
+    TransportCompany result(QString("Перевозчик %1").arg(index),
+                            static_cast<TransportCompany::TransportType>(pick(7, index, 4)));
+
+    for (int i = 0; i < options_.schedulesPerCompany; ++i) {
+        qint64 key = qint64(index) * options_.schedulesPerCompany + i;
+        int countryIndex = pickSkewed(countryTable_, 8, key);
+
+        TransportSchedule schedule;
+        schedule.departureCity = Symbol(QString::fromUtf8(departureCities[pick(9, key, departureCityCount)]));
+        schedule.arrivalCity = Symbol(cityIn(countryIndex, pickSkewed(cityTable_, 10, key)));
+        schedule.departureDate = firstDay_.addDays(pick(11, key, 730));
+        schedule.arrivalDate = schedule.departureDate.addDays(pick(12, key, 2));
+        schedule.price = Money(qint64(10000 + pick(13, key, 90000)) * 100);
+        schedule.availableSeats = 20 + pick(14, key, 300);
+        result.addSchedule(schedule);
+    }
+    return result;
+}
+
+Tour DatasetGenerator::tour(int index) const {
+    int countryIndex = pickSkewed(countryTable_, 15, index);
+    QDate start = firstDay_.addDays(pick(16, index, 730));
+    QDate end = start.addDays(3 + pick(17, index, 12));
+    return Tour(QString("Тур %1").arg(index), countryName(countryIndex), start, end);
+}
+
+Order DatasetGenerator::order(int index) const {
+    Order result;
+    result.setId(index + 1);
+    result.setTour(tour(pick(18, index, std::max(1, options_.tours))));
+    result.setClientName(QString("Клиент %1").arg(index));
+    result.setClientPhone(QString("+37529%1").arg(1000000 + pick(19, index, 8999999)));
+    result.setClientEmail(QString("client%1@example.com").arg(index));
+    result.setOrderDate(QDateTime(firstDay_.addDays(pick(20, index, 730)), QTime(0, 0)));
+    result.setStatus(static_cast<OrderStatus>(pick(21, index, OrderStatusInfo::Count)));
+    return result;
+}
+
+void DatasetGenerator::generate(DataContainer<Country>& countries,
+                                DataContainer<Hotel>& hotels,
+                                DataContainer<TransportCompany>& companies,
+                                DataContainer<Tour>& tours,
+                                DataContainer<Order>& orders) const {
+    countries.clear();
+    hotels.clear();
+    companies.clear();
+    tours.clear();
+    orders.clear();
+
+    countries.getData().reserve(options_.countries);
+    for (int i = 0; i < options_.countries; ++i) {
+        countries.add(country(i));
+    }
+
+    hotels.getData().reserve(options_.hotels);
+    for (int i = 0; i < options_.hotels; ++i) {
+        hotels.add(hotel(i));
+    }
+
+    companies.getData().reserve(options_.companies);
+    for (int i = 0; i < options_.companies; ++i) {
+        companies.add(company(i));
+    }
+
+    tours.getData().reserve(options_.tours);
+    for (int i = 0; i < options_.tours; ++i) {
+        tours.add(tour(i));
+    }
+
+    orders.getData().reserve(options_.orders);
+    for (int i = 0; i < options_.orders; ++i) {
+        orders.add(order(i));
+    }
+}
+
+qint64 DatasetGenerator::writeText(const QString& directory, const Progress& progress) const {
+    QDir().mkpath(directory);
+    FileManager fileManager;
+    qint64 written = 0;
+
+    auto writeFile = [&](const QString& name, const QString& header, int count, int nextOrderId, auto&& writeRecord) {
+        QFile file(QDir(directory).filePath(name));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+            throw FileException(QString("Cannot open file for writing: %1").arg(file.fileName()));
+        }
+
+        QTextStream out(&file);
+        out.setEncoding(QStringConverter::Encoding::Utf8);
+        fileManager.saveHeaderToStream(out, header, count);
+        if (nextOrderId > 0) {
+            fileManager.saveOrderIdHighWaterToStream(out, nextOrderId);
+        }
+
+        for (int i = 0; i < count; ++i) {
+            writeRecord(out, i);
+            if (progress && (i + 1) % 100000 == 0) {
+                progress(name, i + 1);
+            }
+        }
+
+        out.flush();
+        if (out.status() != QTextStream::Ok || file.error() != QFileDevice::NoError) {
+            throw FileException(QString("Error writing to file: %1").arg(file.fileName()));
+        }
+        written += count;
+        if (progress) {
+            progress(name, count);
+        }
+    };
+
+    writeFile("countries.txt", "COUNTRIES", options_.countries, 0, [&](QTextStream& out, int i) {
+        fileManager.saveCountryToStream(out, country(i));
+    });
+    writeFile("hotels.txt", "HOTELS", options_.hotels, 0, [&](QTextStream& out, int i) {
+        fileManager.saveHotelToStream(out, hotel(i));
+    });
+    writeFile("transport_companies.txt", "TRANSPORT_COMPANIES", options_.companies, 0, [&](QTextStream& out, int i) {
+        fileManager.saveTransportCompanyToStream(out, company(i));
+    });
+    writeFile("tours.txt", "TOURS", options_.tours, 0, [&](QTextStream& out, int i) {
+        fileManager.saveTourToStream(out, tour(i));
+    });
+    writeFile("orders.txt", "ORDERS", options_.orders, options_.orders + 1, [&](QTextStream& out, int i) {
+        fileManager.saveOrderToStream(out, order(i));
+    });
+
+    return written;
+}
@@ -0,0 +1,247 @@
+#include "utils/blockchecksums.h"
+#include "utils/crc32c.h"
+#include "utils/filemanager.h"
+#include "utils/snapshotcache.h"
+#include "utils/tracer.h"
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <algorithm>
+
+namespace {
+
+constexpr int DescribedBlocks = 8;
+
+class MappedSource {
+public:
+    explicit MappedSource(const QString& filename)
+        : file_(filename) {
+        if (!file_.open(QIODevice::ReadOnly)) {
+            throw FileException(QString("Cannot open file for reading: %1").arg(filename));
+        }
+
+        size_ = file_.size();
+        if (size_ > 0) {
+            uchar* mapped = file_.map(0, size_);
+            if (mapped) {
+                data_ = reinterpret_cast<const char*>(mapped);
+            } else {
+                fallback_ = file_.readAll();
+                data_ = fallback_.constData();
+                size_ = fallback_.size();
+            }
+        }
+    }
+
+    const char* data() const { return data_; }
+    qint64 size() const { return size_; }
+
+private:
+    QFile file_;
+    QByteArray fallback_;
+    const char* data_ = nullptr;
+    qint64 size_ = 0;
+};
+
+qint64 blockCount(qint64 size, qint64 blockSize) {
+    return (size + blockSize - 1) / blockSize;
+}
+
+qint64 countLines(const char* from, const char* to) {
+    return from < to ? std::count(from, to, '\n') : 0;
+}
+
+}
+
+QString BlockChecksums::Report::describe() const {
+    switch (status) {
+    case Status::Ok:
+        return QString("%1: ok, %2 blocks").arg(filename).arg(blocks);
+    case Status::Unchecked:
+        return QString("%1: no checksums").arg(filename);
+    case Status::Missing:
+        return QString("%1: file does not exist").arg(filename);
+    case Status::Modified:
+    case Status::Corrupt:
+        break;
+    }
+
+    QString text = status == Status::Corrupt
+        ? QString("%1: corrupt, %2 of %3 blocks damaged").arg(filename).arg(damage.size()).arg(blocks)
+        : QString("%1: %2 of %3 blocks differ").arg(filename).arg(damage.size()).arg(blocks);
+    if (changedAfterSeal) {
+        text += ", file was modified after its checksums were written";
+    }
+    if (size != expectedSize) {
+        text += QString(" (size %1 bytes, expected %2)").arg(size).arg(expectedSize);
+    }
+    for (int i = 0; i < damage.size() && i < DescribedBlocks; ++i) {
+        const Damage& block = damage[i];
+        text += QString("%1 block %2 at bytes %3-%4")
+            .arg(i == 0 ? ":" : ";").arg(block.block).arg(block.offset).arg(block.offset + block.length - 1);
+        text += block.firstLine == block.lastLine
+            ? QString(", line %1").arg(block.firstLine)
+            : QString(", lines %1-%2").arg(block.firstLine).arg(block.lastLine);
+    }
+    if (damage.size() > DescribedBlocks) {
+        text += QString("; and %1 more").arg(damage.size() - DescribedBlocks);
+    }
+    return text;
+}
+
+QString BlockChecksums::pathFor(const QString& dataFile) {
+    return dataFile + ".crc";
+}
+
+BlockChecksums BlockChecksums::compute(const char* data, qint64 size, qint64 blockSize) {
+    BlockChecksums checksums;
+    checksums.blockSize_ = blockSize;
+    checksums.sourceSize_ = size;
+    checksums.crcs_.resize(blockCount(size, blockSize));
+    Crc32c::computeBlocks(data, size, blockSize, checksums.crcs_.data());
+    return checksums;
+}
+
+BlockChecksums BlockChecksums::computeFile(const QString& dataFile, qint64 blockSize) {
+    MappedSource source(dataFile);
+    BlockChecksums checksums = compute(source.data(), source.size(), blockSize);
+    checksums.stamp(dataFile);
+    return checksums;
+}
+
+bool BlockChecksums::seal(const QString& dataFile) {
+    TRACE_SCOPE("BlockChecksums::seal", "io");
+    try {
+        return computeFile(dataFile).save(pathFor(dataFile));
+    } catch (const FileException&) {
+        return false;
+    }
+}
+
+void BlockChecksums::stamp(const QString& dataFile) {
+    QFileInfo info(dataFile);
+    sourceModified_ = info.exists() ? info.lastModified().toMSecsSinceEpoch() : 0;
+}
+
+BlockChecksums::Report BlockChecksums::verify(const QString& dataFile) {
+    TRACE_SCOPE("BlockChecksums::verify", "io");
+    Report report;
+    report.filename = dataFile;
+    QFileInfo info(dataFile);
+    if (!info.exists()) {
+        report.status = Status::Missing;
+        return report;
+    }
+
+    BlockChecksums stored;
+    if (!stored.load(pathFor(dataFile))) {
+        report.size = info.size();
+        report.expectedSize = report.size;
+        return report;
+    }
+
+    MappedSource source(dataFile);
+    BlockChecksums actual = compute(source.data(), source.size(), stored.blockSize_);
+    report.size = source.size();
+    report.expectedSize = stored.sourceSize_;
+    report.blocks = stored.size();
+
+    const char* data = source.data();
+    const char* counted = data;
+    qint64 line = 1;
+    int blocks = std::max(stored.size(), actual.size());
+    qint64 extent = std::max(report.size, report.expectedSize);
+    for (int block = 0; block < blocks; ++block) {
+        if (block < stored.size() && block < actual.size() && stored.crc(block) == actual.crc(block)) {
+            continue;
+        }
+
+        Damage damage;
+        damage.block = block;
+        damage.offset = block * stored.blockSize_;
+        damage.length = std::min(stored.blockSize_, extent - damage.offset);
+        const char* first = data + std::min(damage.offset, report.size);
+        const char* last = data + std::min(damage.offset + damage.length, report.size);
+        line += countLines(counted, first);
+        damage.firstLine = line;
+        damage.lastLine = line + countLines(first, last > first ? last - 1 : first);
+        counted = first;
+        report.damage.append(damage);
+    }
+
+    report.changedAfterSeal = info.lastModified().toMSecsSinceEpoch() != stored.sourceModified_;
+    if (report.damage.isEmpty() && report.size == report.expectedSize) {
+        report.status = Status::Ok;
+    } else if (!report.changedAfterSeal || report.size != report.expectedSize) {
+        report.status = Status::Corrupt;
+    } else {
+        report.status = Status::Modified;
+    }
+    return report;
+}
+
+QVector<BlockChecksums::Report> BlockChecksums::verifyDirectory(const QString& dataPath) {
+    TRACE_SCOPE("BlockChecksums::verifyDirectory", "io");
+    QVector<Report> reports;
+    QStringList seen;
+    for (const QString& filename : SnapshotCache::sourceFilesIn(dataPath)) {
+        if (!QFile::exists(filename) || seen.contains(filename)) {
+            continue;
+        }
+        seen.append(filename);
+        try {
+            reports.append(verify(filename));
+        } catch (const FileException&) {
+            Report report;
+            report.filename = filename;
+            report.status = Status::Missing;
+            reports.append(report);
+        }
+    }
+    return reports;
+}
+
+bool BlockChecksums::load(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (in.status() != QDataStream::Ok || magic != Magic || version != FormatVersion) {
+        return false;
+    }
+
+    BlockChecksums loaded;
+    in >> loaded.blockSize_ >> loaded.sourceSize_ >> loaded.sourceModified_ >> loaded.crcs_;
+    if (in.status() != QDataStream::Ok || loaded.blockSize_ <= 0 || loaded.sourceSize_ < 0 ||
+        loaded.crcs_.size() != blockCount(loaded.sourceSize_, loaded.blockSize_)) {
+        return false;
+    }
+
+    *this = std::move(loaded);
+    return true;
+}
+
+bool BlockChecksums::save(const QString& path) const {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << Magic << FormatVersion;
+    out << blockSize_ << sourceSize_ << sourceModified_ << crcs_;
+    if (out.status() != QDataStream::Ok) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
@@ -0,0 +1,192 @@
+#include "utils/crc32c.h"
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <nmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#define CRC32C_SSE42 1
+#define CRC32C_HARDWARE 1
+#elif defined(__ARM_FEATURE_CRC32) && Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+#include <arm_acle.h>
+#define CRC32C_ARMV8 1
+#define CRC32C_HARDWARE 1
+#endif
+
+#if defined(CRC32C_SSE42) && (defined(__GNUC__) || defined(__clang__))
+#define CRC32C_TARGET __attribute__((target("sse4.2")))
+#else
+#define CRC32C_TARGET
+#endif
+
+namespace {
+
+constexpr quint32 Polynomial = 0x82F63B78;
+
+struct Tables {
+    quint32 slice[8][256];
+
+    Tables() {
+        for (quint32 i = 0; i < 256; ++i) {
+            quint32 crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc >> 1) ^ ((crc & 1) ? Polynomial : 0);
+            }
+            slice[0][i] = crc;
+        }
+        for (int k = 1; k < 8; ++k) {
+            for (int i = 0; i < 256; ++i) {
+                slice[k][i] = (slice[k - 1][i] >> 8) ^ slice[0][slice[k - 1][i] & 0xFF];
+            }
+        }
+    }
+};
+
+const Tables& tables() {
+    static const Tables instance;
+    return instance;
+}
+
+quint32 softwareUpdate(quint32 crc, const uchar* data, qint64 size) {
+    const auto& t = tables().slice;
+    while (size >= 8) {
+        quint64 word = qFromLittleEndian<quint64>(data) ^ crc;
+        crc = t[7][word & 0xFF] ^ t[6][(word >> 8) & 0xFF] ^
+              t[5][(word >> 16) & 0xFF] ^ t[4][(word >> 24) & 0xFF] ^
+              t[3][(word >> 32) & 0xFF] ^ t[2][(word >> 40) & 0xFF] ^
+              t[1][(word >> 48) & 0xFF] ^ t[0][word >> 56];
+        data += 8;
+        size -= 8;
+    }
+    while (size-- > 0) {
+        crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xFF];
+    }
+    return crc;
+}
+
+#ifdef CRC32C_HARDWARE
+quint64 load64(const uchar* data) {
+    quint64 word;
+    std::memcpy(&word, data, sizeof(word));
+    return word;
+}
+
+#ifdef CRC32C_SSE42
+CRC32C_TARGET inline quint32 step64(quint32 crc, quint64 word) {
+    return static_cast<quint32>(_mm_crc32_u64(crc, word));
+}
+
+CRC32C_TARGET inline quint32 step8(quint32 crc, uchar byte) {
+    return _mm_crc32_u8(crc, byte);
+}
+#else
+inline quint32 step64(quint32 crc, quint64 word) {
+    return __crc32cd(crc, word);
+}
+
+inline quint32 step8(quint32 crc, uchar byte) {
+    return __crc32cb(crc, byte);
+}
+#endif
+
+CRC32C_TARGET quint32 hardwareUpdate(quint32 crc, const uchar* data, qint64 size) {
+    while (size >= 8) {
+        crc = step64(crc, load64(data));
+        data += 8;
+        size -= 8;
+    }
+    while (size-- > 0) {
+        crc = step8(crc, *data++);
+    }
+    return crc;
+}
+
+// The crc32 instruction has a latency of several cycles but a throughput of one per cycle,
+// so three independent blocks are folded side by side to keep the unit busy.
+CRC32C_TARGET void hardwareUpdate3(quint32* crcs, const uchar* data, qint64 blockSize) {
+    quint32 crc0 = crcs[0];
+    quint32 crc1 = crcs[1];
+    quint32 crc2 = crcs[2];
+    const uchar* block1 = data + blockSize;
+    const uchar* block2 = block1 + blockSize;
+    for (qint64 offset = 0; offset < blockSize; offset += 8) {
+        crc0 = step64(crc0, load64(data + offset));
+        crc1 = step64(crc1, load64(block1 + offset));
+        crc2 = step64(crc2, load64(block2 + offset));
+    }
+    crcs[0] = crc0;
+    crcs[1] = crc1;
+    crcs[2] = crc2;
+}
+#endif
+
+bool detectHardware() {
+#if defined(CRC32C_SSE42) && defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;
+#elif defined(CRC32C_SSE42)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2");
+#elif defined(CRC32C_HARDWARE)
+    return true;
+#else
+    return false;
+#endif
+}
+
+}
+
+bool Crc32c::isHardwareAccelerated() {
+    static const bool hardware = detectHardware();
+    return hardware;
+}
+
+const char* Crc32c::implementation() {
+#if defined(CRC32C_SSE42)
+    if (isHardwareAccelerated()) {
+        return "sse4.2";
+    }
+#elif defined(CRC32C_ARMV8)
+    return "armv8-crc";
+#endif
+    return "software";
+}
+
+quint32 Crc32c::compute(const char* data, qint64 size, quint32 crc) {
+    const uchar* bytes = reinterpret_cast<const uchar*>(data);
+#ifdef CRC32C_HARDWARE
+    if (isHardwareAccelerated()) {
+        return ~hardwareUpdate(~crc, bytes, size);
+    }
+#endif
+    return ~softwareUpdate(~crc, bytes, size);
+}
+
+void Crc32c::computeBlocks(const char* data, qint64 size, qint64 blockSize, quint32* crcs) {
+    if (blockSize <= 0 || size <= 0) {
+        return;
+    }
+
+    qint64 count = (size + blockSize - 1) / blockSize;
+    qint64 block = 0;
+#ifdef CRC32C_HARDWARE
+    if (isHardwareAccelerated() && blockSize % 8 == 0) {
+        const uchar* bytes = reinterpret_cast<const uchar*>(data);
+        for (; (block + 3) * blockSize <= size; block += 3) {
+            quint32 lanes[3] = {~0u, ~0u, ~0u};
+            hardwareUpdate3(lanes, bytes + block * blockSize, blockSize);
+            for (int lane = 0; lane < 3; ++lane) {
+                crcs[block + lane] = ~lanes[lane];
+            }
+        }
+    }
+#endif
+    for (; block < count; ++block) {
+        qint64 offset = block * blockSize;
+        crcs[block] = compute(data + offset, std::min(blockSize, size - offset));
+    }
+}
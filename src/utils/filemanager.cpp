@@ -1,5 +1,14 @@
 #include "utils/filemanager.h"
+#include "utils/blockchecksums.h"
+#include "utils/mappedfileparser.h"
+#include "utils/orderdetailsource.h"
+#include "utils/orderpartitions.h"
+#include "utils/perfcounters.h"
+#include "utils/recordindex.h"
+#include "utils/tracer.h"
 #include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
 #include <QTextStream>
 #include <QStringConverter>
 #include <QDir>
@@ -8,6 +17,66 @@
 #include <QJsonArray>
 #include <QDebug>
 #include <QLocale>
+#include <QHash>
+#include <QSet>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+template<typename Write>
+QString toBlock(Write&& write) {
+    QString block;
+    {
+        QTextStream out(&block);
+        write(out);
+    }
+    return block;
+}
+
+bool sameSchedule(const TransportSchedule& lhs, const TransportSchedule& rhs) {
+    return lhs.departureCity == rhs.departureCity && lhs.arrivalCity == rhs.arrivalCity &&
+           lhs.departureDate == rhs.departureDate && lhs.arrivalDate == rhs.arrivalDate &&
+           lhs.price == rhs.price && lhs.availableSeats == rhs.availableSeats;
+}
+
+int readReference(const QString& line, int size, const QString& kind) {
+    bool ok;
+    int reference = line.trimmed().toInt(&ok);
+    if (!ok || reference < 0 || reference >= size) {
+        throw FileException(QString("Invalid %1 reference: '%2'").arg(kind, line));
+    }
+    return reference;
+}
+
+}
+
+struct FileManager::ReferenceCatalog {
+    QStringList hotels;
+    QHash<QString, int> hotelIds;
+    QStringList companies;
+    QHash<QString, int> companyIds;
+    QStringList tours;
+    QHash<QString, int> tourIds;
+
+    static int intern(QStringList& blocks, QHash<QString, int>& ids, const QString& block) {
+        auto it = ids.constFind(block);
+        if (it != ids.cend()) {
+            return it.value();
+        }
+        int id = blocks.size();
+        blocks.append(block);
+        ids.insert(block, id);
+        return id;
+    }
+
+    static void write(QTextStream& out, const QStringList& blocks) {
+        out << blocks.size() << "\n";
+        for (const QString& block : blocks) {
+            out << block;
+        }
+    }
+};
 
 FileManager::FileManager() {
     dataPath_ = "data";
@@ -17,13 +86,20 @@ FileManager::FileManager() {
     }
 }
 
-void FileManager::openFileForWriting(QFile& file, const QString& filename) const {
+void FileManager::openFileForWriting(QSaveFile& file, const QString& filename) const {
     file.setFileName(filename);
     if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
         throw FileException(QString("Cannot open file for writing: %1").arg(filename));
     }
 }
 
+void FileManager::commitFile(QSaveFile& file, const QString& filename) const {
+    if (!file.commit()) {
+        throw FileException(QString("Cannot write file: %1").arg(filename));
+    }
+    writeChecksums(filename);
+}
+
 void FileManager::openFileForReading(QFile& file, const QString& filename) const {
     file.setFileName(filename);
     if (!file.exists()) {
@@ -43,23 +119,30 @@ void FileManager::validateFileHeader(QTextStream& in, const QString& expectedHea
 }
 
 void FileManager::saveCountries(const DataContainer<Country>& countries, const QString& filename) const {
-    QFile file;
+    TRACE_SCOPE("FileManager::saveCountries", "io");
+    QSaveFile file;
     openFileForWriting(file, filename);
     QTextStream out(&file);
     out.setEncoding(QStringConverter::Encoding::Utf8);
 
-    out << "COUNTRIES\n";
-    out << countries.size() << "\n";
+    saveHeaderToStream(out, "COUNTRIES", countries.size());
 
     for (const auto& country : countries.getData()) {
-        out << country.getName() << "\n";
-        out << country.getContinent() << "\n";
-        out << country.getCapital() << "\n";
-        out << country.getCurrency() << "\n";
+        saveCountryToStream(out, country);
     }
+
+    out.flush();
+    commitFile(file, filename);
 }
 
 void FileManager::loadCountries(DataContainer<Country>& countries, const QString& filename) const {
+    TRACE_SCOPE("FileManager::loadCountries", "io");
+    PerfTimer perfTimer(PerfCounters::LoadCountries);
+    verifyChecksums(filename);
+    if (parser_ == Parser::Mapped) {
+        MappedFileParser().loadCountries(countries, filename);
+        return;
+    }
     QFile file;
     openFileForReading(file, filename);
     QTextStream in(&file);
@@ -95,20 +178,30 @@ void FileManager::loadCountries(DataContainer<Country>& countries, const QString
 }
 
 void FileManager::saveHotels(const DataContainer<Hotel>& hotels, const QString& filename) const {
-    QFile file;
+    TRACE_SCOPE("FileManager::saveHotels", "io");
+    QSaveFile file;
     openFileForWriting(file, filename);
     QTextStream out(&file);
     out.setEncoding(QStringConverter::Encoding::Utf8);
 
-    out << "HOTELS\n";
-    out << hotels.size() << "\n";
+    saveHeaderToStream(out, "HOTELS", hotels.size());
 
     for (const auto& hotel : hotels.getData()) {
         saveHotelToStream(out, hotel);
     }
+
+    out.flush();
+    commitFile(file, filename);
 }
 
 void FileManager::loadHotels(DataContainer<Hotel>& hotels, const QString& filename) const {
+    TRACE_SCOPE("FileManager::loadHotels", "io");
+    PerfTimer perfTimer(PerfCounters::LoadHotels);
+    verifyChecksums(filename);
+    if (parser_ == Parser::Mapped) {
+        MappedFileParser().loadHotels(hotels, filename);
+        return;
+    }
     QFile file;
     openFileForReading(file, filename);
     QTextStream in(&file);
@@ -172,20 +265,30 @@ void FileManager::loadHotels(DataContainer<Hotel>& hotels, const QString& filena
 }
 
 void FileManager::saveTransportCompanies(const DataContainer<TransportCompany>& companies, const QString& filename) const {
-    QFile file;
+    TRACE_SCOPE("FileManager::saveTransportCompanies", "io");
+    QSaveFile file;
     openFileForWriting(file, filename);
     QTextStream out(&file);
     out.setEncoding(QStringConverter::Encoding::Utf8);
 
-    out << "TRANSPORT_COMPANIES\n";
-    out << companies.size() << "\n";
+    saveHeaderToStream(out, "TRANSPORT_COMPANIES", companies.size());
 
     for (const auto& company : companies.getData()) {
         saveTransportCompanyToStream(out, company);
     }
+
+    out.flush();
+    commitFile(file, filename);
 }
 
 void FileManager::loadTransportCompanies(DataContainer<TransportCompany>& companies, const QString& filename) const {
+    TRACE_SCOPE("FileManager::loadTransportCompanies", "io");
+    PerfTimer perfTimer(PerfCounters::LoadTransport);
+    verifyChecksums(filename);
+    if (parser_ == Parser::Mapped) {
+        MappedFileParser().loadTransportCompanies(companies, filename);
+        return;
+    }
     QFile file;
     openFileForReading(file, filename);
     QTextStream in(&file);
@@ -203,34 +306,48 @@ void FileManager::loadTransportCompanies(DataContainer<TransportCompany>& compan
 }
 
 void FileManager::saveTours(const DataContainer<Tour>& tours, const QString& filename) const {
-    QFile file;
+    TRACE_SCOPE("FileManager::saveTours", "io");
+    QSaveFile file;
     openFileForWriting(file, filename);
     QTextStream out(&file);
     out.setEncoding(QStringConverter::Encoding::Utf8);
 
-    out << "TOURS\n";
-    out << tours.size() << "\n";
+    if (format_ == Format::V2) {
+        saveToursV2(out, tours);
+    } else {
+        saveHeaderToStream(out, "TOURS", tours.size());
 
-    for (const auto& tour : tours.getData()) {
-        out << tour.getName() << "\n";
-        out << tour.getCountry() << "\n";
-        out << tour.getStartDate().toString(Qt::ISODate) << "\n";
-        out << tour.getEndDate().toString(Qt::ISODate) << "\n";
-        
-        saveHotelToStream(out, tour.getHotel());
-        
-        saveTransportCompanyToStream(out, tour.getTransportCompany());
-        
-        saveScheduleToStream(out, tour.getTransportSchedule());
+        for (const auto& tour : tours.getData()) {
+            saveTourToStream(out, tour);
+        }
     }
+
+    out.flush();
+    commitFile(file, filename);
+    writeIndex(filename);
 }
 
 void FileManager::loadTours(DataContainer<Tour>& tours, const QString& filename) const {
+    TRACE_SCOPE("FileManager::loadTours", "io");
+    PerfTimer perfTimer(PerfCounters::LoadTours);
+    verifyChecksums(filename);
+    if (parser_ == Parser::Mapped) {
+        MappedFileParser().loadTours(tours, filename);
+        return;
+    }
     QFile file;
     openFileForReading(file, filename);
     QTextStream in(&file);
     in.setEncoding(QStringConverter::Encoding::Utf8);
-    validateFileHeader(in, "TOURS");
+
+    QString header = in.readLine();
+    if (header == "TOURS_V2") {
+        loadToursV2(in, tours);
+        return;
+    }
+    if (header != "TOURS") {
+        throw FileException("Invalid file format");
+    }
 
     int count = in.readLine().toInt();
     tours.clear();
@@ -279,49 +396,105 @@ void FileManager::loadTours(DataContainer<Tour>& tours, const QString& filename)
 }
 
 void FileManager::saveOrders(const DataContainer<Order>& orders, const QString& filename) const {
-    QFile file;
+    TRACE_SCOPE("FileManager::saveOrders", "io");
+    QSaveFile file;
     openFileForWriting(file, filename);
     QTextStream out(&file);
     out.setEncoding(QStringConverter::Encoding::Utf8);
 
-    out << "ORDERS\n";
-    out << orders.size() << "\n";
+    QVector<int> detailRows;
+    if (format_ == Format::V2) {
+        saveOrdersV2(out, orders, detailRows);
+    } else {
+        saveHeaderToStream(out, "ORDERS", orders.size());
+        saveOrderIdHighWaterToStream(out, OrderIdAllocator::instance().peekNext());
 
-    for (const auto& order : orders.getData()) {
-        out << order.getClientName() << "\n";
-        out << order.getClientPhone() << "\n";
-        out << order.getClientEmail() << "\n";
-        out << "2" << "\n";
-        out << order.getOrderDate().date().toString(Qt::ISODate) << "\n";
-        
-        const Tour& tour = order.getTour();
-        out << tour.getName() << "\n";
-        out << tour.getCountry() << "\n";
-        out << tour.getStartDate().toString(Qt::ISODate) << "\n";
-        out << tour.getEndDate().toString(Qt::ISODate) << "\n";
-        
-        saveHotelToStream(out, tour.getHotel());
-        
-        saveTransportCompanyToStream(out, tour.getTransportCompany());
-        
-        saveScheduleToStream(out, tour.getTransportSchedule());
+        detailRows.reserve(orders.size());
+        for (const auto& order : orders.getData()) {
+            detailRows.append(detailRows.size());
+            saveOrderToStream(out, order);
+        }
+    }
 
-        out << order.getStatus() << "\n";
+    out.flush();
+    commitFile(file, filename);
+    writeIndex(filename);
+    rebindOrderDetails(orders, detailRows, filename);
+}
+
+void FileManager::rebindOrderDetails(const DataContainer<Order>& orders, const QVector<int>& detailRows,
+                                     const QString& filename) const {
+    const QString target = QFileInfo(filename).absoluteFilePath();
+    QHash<OrderDetailSource*, QHash<int, int>> remapped;
+    const QVector<Order>& data = orders.getData();
+    for (int i = 0; i < data.size(); ++i) {
+        OrderDetailSource* source = data[i].getDetailSource().get();
+        if (source && source->filename() == target) {
+            QHash<int, int>& rows = remapped[source];
+            if (!rows.contains(data[i].getDetailRow())) {
+                rows.insert(data[i].getDetailRow(), detailRows[i]);
+            }
+        }
+    }
+    if (remapped.isEmpty()) {
+        return;
+    }
+
+    try {
+        RecordIndex index = openIndex(filename);
+        for (auto it = remapped.cbegin(); it != remapped.cend(); ++it) {
+            it.key()->rebind(index, it.value());
+        }
+    } catch (const FileException& e) {
+        qWarning() << "Cannot reopen order details in" << filename << ":" << e.what();
+    }
+}
+
+void FileManager::refreshOrderDetails(const DataContainer<Order>& orders, const QString& filename,
+                                      const RecordIndex& index) const {
+    const QString target = QFileInfo(filename).absoluteFilePath();
+    QSet<OrderDetailSource*> refreshed;
+    for (const auto& order : orders.getData()) {
+        OrderDetailSource* source = order.getDetailSource().get();
+        if (source && source->filename() == target && !refreshed.contains(source)) {
+            source->refresh(index);
+            refreshed.insert(source);
+        }
     }
 }
 
 void FileManager::loadOrders(DataContainer<Order>& orders, const QString& filename) const {
+    TRACE_SCOPE("FileManager::loadOrders", "io");
+    PerfTimer perfTimer(PerfCounters::LoadOrders);
+    verifyChecksums(filename);
+    if (parser_ == Parser::Mapped) {
+        MappedFileParser().loadOrders(orders, filename, lazyOrderDetails_);
+        return;
+    }
     QFile file;
     openFileForReading(file, filename);
     QTextStream in(&file);
     in.setEncoding(QStringConverter::Encoding::Utf8);
-    validateFileHeader(in, "ORDERS");
+
+    QString header = in.readLine();
+    if (header == "ORDERS_V2") {
+        loadOrdersV2(in, orders);
+        return;
+    }
+    if (header != "ORDERS") {
+        throw FileException("Invalid file format");
+    }
 
     int count = in.readLine().toInt();
     orders.clear();
+    
+    OrderIdAllocator& allocator = OrderIdAllocator::instance();
+    bool hasStoredIds = readOrderIdHighWater(in);
+    int reservedId = hasStoredIds ? 0 : allocator.reserve(count);
 
     for (int i = 0; i < count; ++i) {
         try {
+            int orderId = hasStoredIds ? in.readLine().trimmed().toInt() : reservedId + i;
             QString clientName = in.readLine().trimmed();
             QString clientPhone = in.readLine().trimmed();
             QString clientEmail = in.readLine().trimmed();
@@ -349,6 +522,12 @@ void FileManager::loadOrders(DataContainer<Order>& orders, const QString& filena
             tour.setTransportSchedule(selectedSchedule);
             
             Order order;
+            if (orderId > 0) {
+                allocator.observe(orderId);
+                order.setId(orderId);
+            } else {
+                order.setId(allocator.allocate());
+            }
             order.setTour(tour);
             order.setClientName(clientName);
             order.setClientPhone(clientPhone);
@@ -356,8 +535,7 @@ void FileManager::loadOrders(DataContainer<Order>& orders, const QString& filena
             QDateTime orderDateTime(orderDate, QTime(0, 0));
             order.setOrderDate(orderDateTime);
             
-            QString status = determineOrderStatus(in, i, count);
-            order.setStatus(status);
+            order.setStatus(readOrderStatus(in));
             
             orders.add(order);
         } catch (const FileException& e) {
@@ -373,11 +551,19 @@ void FileManager::saveAll(const DataContainer<Country>& countries,
                           const DataContainer<Tour>& tours,
                           const DataContainer<Order>& orders,
                           const QString& basePath) const {
+    TRACE_SCOPE("FileManager::saveAll", "io");
     saveCountries(countries, basePath + "/countries.txt");
     saveHotels(hotels, basePath + "/hotels.txt");
     saveTransportCompanies(companies, basePath + "/transport_companies.txt");
     saveTours(tours, basePath + "/tours.txt");
-    saveOrders(orders, basePath + "/orders.txt");
+    if (OrderPartitions::existIn(basePath)) {
+        OrderPartitions partitions(basePath);
+        partitions.readCatalog();
+        partitions.markAllLoaded();
+        partitions.save(*this, orders);
+    } else {
+        saveOrders(orders, basePath + "/orders.txt");
+    }
 }
 
 void FileManager::loadAll(DataContainer<Country>& countries,
@@ -386,11 +572,19 @@ void FileManager::loadAll(DataContainer<Country>& countries,
                           DataContainer<Tour>& tours,
                           DataContainer<Order>& orders,
                           const QString& basePath) const {
+    TRACE_SCOPE("FileManager::loadAll", "io");
     loadCountries(countries, basePath + "/countries.txt");
     loadHotels(hotels, basePath + "/hotels.txt");
     loadTransportCompanies(companies, basePath + "/transport_companies.txt");
     loadTours(tours, basePath + "/tours.txt");
-    loadOrders(orders, basePath + "/orders.txt");
+    if (OrderPartitions::existIn(basePath)) {
+        OrderPartitions partitions(basePath);
+        partitions.readCatalog();
+        orders.clear();
+        partitions.loadAll(*this, orders);
+    } else {
+        loadOrders(orders, basePath + "/orders.txt");
+    }
 }
 
 Room FileManager::readRoomFromStream(QTextStream& in, const QString& hotelName, int hotelIndex, int roomIndex) const {
@@ -412,12 +606,8 @@ Room FileManager::readRoomFromStream(QTextStream& in, const QString& hotelName,
             .arg(hotelName).arg(roomIndex).arg(roomTypeStr).arg(hotelIndex));
     }
     
-    QLocale locale(QLocale::C);
-    double price = locale.toDouble(priceStr, &ok);
-    if (!ok) {
-        price = priceStr.toDouble(&ok);
-    }
-    if (!ok || price < 0) {
+    Money price;
+    if (!parseMoney(priceStr, price) || price.kopecks() < 0) {
         throw FileException(QString("Invalid price for hotel '%1' (index %4), room %2: expected number, got '%3'")
             .arg(hotelName).arg(roomIndex).arg(priceStr).arg(hotelIndex));
     }
@@ -443,45 +633,109 @@ void FileManager::skipInvalidHotelLines(QTextStream& in, int linesToSkip) const
     }
 }
 
-QString FileManager::determineOrderStatus(QTextStream& in, int orderIndex, int totalOrders) const {
-    QString defaultStatus = "В обработке";
+bool FileManager::parseMoney(const QString& text, Money& result) const {
+    if (Money::tryParse(text, result)) {
+        return true;
+    }
+    
+    bool ok;
+    double legacyValue = QLocale(QLocale::C).toDouble(text.trimmed(), &ok);
+    if (!ok || !std::isfinite(legacyValue)) {
+        return false;
+    }
+    result = Money::fromDouble(legacyValue);
+    return true;
+}
+
+Money FileManager::readMoney(QTextStream& in) const {
+    QString line = in.readLine();
+    Money result;
+    if (!line.trimmed().isEmpty() && !parseMoney(line, result)) {
+        throw FileException(QString("Invalid money amount: '%1'").arg(line));
+    }
+    return result;
+}
+
+bool FileManager::readOrderIdHighWater(QTextStream& in) const {
+    const QString prefix = "NEXT_ID:";
     
     if (in.atEnd()) {
-        return defaultStatus;
+        return false;
     }
     
-    qint64 pos = in.device()->pos();
-    QString peekLine = in.readLine().trimmed();
+    qint64 pos = in.pos();
+    QString line = in.readLine().trimmed();
+    if (!line.startsWith(prefix)) {
+        in.seek(pos);
+        return false;
+    }
     
-    QStringList validStatuses = {"В обработке", "Подтвержден", "Оплачен", "Завершен", "Отменен"};
-    bool isValidStatus = validStatuses.contains(peekLine);
+    bool ok;
+    int nextId = line.mid(prefix.length()).toInt(&ok);
+    if (!ok) {
+        throw FileException(QString("Invalid order id high-water mark: '%1'").arg(line));
+    }
+    OrderIdAllocator::instance().observe(nextId - 1);
+    return true;
+}
+
+OrderStatus FileManager::readOrderStatus(QTextStream& in) const {
+    if (in.atEnd()) {
+        return OrderStatus::Processing;
+    }
     
-    bool looksLikeClientName = peekLine.contains(" ") && 
-                             !peekLine.contains("@") && 
-                             !peekLine.startsWith("+") &&
-                             !peekLine.contains("client@") &&
-                             peekLine.length() > 5 && peekLine.length() < 100 &&
-                             (!peekLine.contains("-") || (peekLine.contains("-") && peekLine.length() > 15));
+    qint64 pos = in.pos();
+    QString line = in.readLine();
     
-    if (isValidStatus) {
-        return peekLine;
+    OrderStatus status;
+    if (OrderStatusInfo::tryParse(line, status)) {
+        return status;
     }
     
-    if (looksLikeClientName && orderIndex < totalOrders - 1) {
-        in.device()->seek(pos);
-        return defaultStatus;
-    }
+    in.seek(pos);
+    return OrderStatus::Processing;
+}
+
+void FileManager::saveHeaderToStream(QTextStream& out, const QString& header, int count) const {
+    out << header << "\n";
+    out << count << "\n";
+}
+
+void FileManager::saveOrderIdHighWaterToStream(QTextStream& out, int nextId) const {
+    out << "NEXT_ID:" << nextId << "\n";
+}
+
+void FileManager::saveCountryToStream(QTextStream& out, const Country& country) const {
+    out << country.getName() << "\n";
+    out << country.getContinent() << "\n";
+    out << country.getCapital() << "\n";
+    out << country.getCurrency() << "\n";
+}
+
+void FileManager::saveTourToStream(QTextStream& out, const Tour& tour) const {
+    out << tour.getName() << "\n";
+    out << tour.getCountry() << "\n";
+    out << tour.getStartDate().toString(Qt::ISODate) << "\n";
+    out << tour.getEndDate().toString(Qt::ISODate) << "\n";
     
-    if (orderIndex == totalOrders - 1) {
-        if (!looksLikeClientName && peekLine.length() > 0 && peekLine.length() < 50) {
-            return peekLine;
-        }
-        in.device()->seek(pos);
-        return defaultStatus;
-    }
+    saveHotelToStream(out, tour.getHotel());
+    
+    saveTransportCompanyToStream(out, tour.getTransportCompany());
     
-    in.device()->seek(pos);
-    return defaultStatus;
+    saveScheduleToStream(out, tour.getTransportSchedule());
+}
+
+void FileManager::saveOrderToStream(QTextStream& out, const Order& order) const {
+    out << order.getId() << "\n";
+    out << order.getClientName() << "\n";
+    out << order.getClientPhone() << "\n";
+    out << order.getClientEmail() << "\n";
+    out << "2" << "\n";
+    out << order.getOrderDate().date().toString(Qt::ISODate) << "\n";
+    
+    saveTourToStream(out, order.getTour());
+
+    out << order.getStatusText() << "\n";
 }
 
 void FileManager::saveHotelToStream(QTextStream& out, const Hotel& hotel) const {
@@ -499,7 +753,7 @@ void FileManager::saveHotelToStream(QTextStream& out, const Hotel& hotel) const
 void FileManager::saveRoomToStream(QTextStream& out, const Room& room) const {
     out << room.getName() << "\n";
     out << static_cast<int>(room.getRoomType()) << "\n";
-    out << room.getPricePerNight() << "\n";
+    out << room.getPricePerNight().toString() << "\n";
     out << room.getCapacity() << "\n";
 }
 
@@ -514,11 +768,11 @@ void FileManager::saveTransportCompanyToStream(QTextStream& out, const Transport
 }
 
 void FileManager::saveScheduleToStream(QTextStream& out, const TransportSchedule& schedule) const {
-    out << schedule.departureCity << "\n";
-    out << schedule.arrivalCity << "\n";
+    out << schedule.departureCity.toString() << "\n";
+    out << schedule.arrivalCity.toString() << "\n";
     out << schedule.departureDate.toString(Qt::ISODate) << "\n";
     out << schedule.arrivalDate.toString(Qt::ISODate) << "\n";
-    out << schedule.price << "\n";
+    out << schedule.price.toString() << "\n";
     out << schedule.availableSeats << "\n";
 }
 
@@ -547,7 +801,7 @@ Room FileManager::loadRoomFromStream(QTextStream& in) const {
     Room room;
     room.setName(in.readLine().trimmed());
     room.setRoomType(static_cast<Room::RoomType>(in.readLine().toInt()));
-    room.setPricePerNight(in.readLine().toDouble());
+    room.setPricePerNight(readMoney(in));
     room.setCapacity(in.readLine().toInt());
     return room;
 }
@@ -568,12 +822,372 @@ TransportCompany FileManager::loadTransportCompanyFromStream(QTextStream& in) co
 
 TransportSchedule FileManager::loadScheduleFromStream(QTextStream& in) const {
     TransportSchedule schedule;
-    schedule.departureCity = in.readLine().trimmed();
-    schedule.arrivalCity = in.readLine().trimmed();
+    schedule.departureCity = Symbol(in.readLine().trimmed());
+    schedule.arrivalCity = Symbol(in.readLine().trimmed());
     schedule.departureDate = QDate::fromString(in.readLine().trimmed(), Qt::ISODate);
     schedule.arrivalDate = QDate::fromString(in.readLine().trimmed(), Qt::ISODate);
-    schedule.price = in.readLine().toDouble();
+    schedule.price = readMoney(in);
     schedule.availableSeats = in.readLine().toInt();
     return schedule;
 }
 
+void FileManager::saveToursV2(QTextStream& out, const DataContainer<Tour>& tours) const {
+    ReferenceCatalog catalog;
+    QStringList records;
+    records.reserve(tours.size());
+    for (const auto& tour : tours.getData()) {
+        records.append(tourRecordV2(tour, catalog));
+    }
+
+    saveHeaderToStream(out, "TOURS_V2", tours.size());
+    ReferenceCatalog::write(out, catalog.hotels);
+    ReferenceCatalog::write(out, catalog.companies);
+    for (const QString& record : records) {
+        out << record;
+    }
+}
+
+void FileManager::saveOrdersV2(QTextStream& out, const DataContainer<Order>& orders,
+                               QVector<int>& tourRefs) const {
+    ReferenceCatalog catalog;
+    QStringList records;
+    records.reserve(orders.size());
+    tourRefs.reserve(orders.size());
+    for (const auto& order : orders.getData()) {
+        int tourRef = ReferenceCatalog::intern(catalog.tours, catalog.tourIds,
+                                               tourRecordV2(order.getTour(), catalog));
+        tourRefs.append(tourRef);
+        records.append(toBlock([&](QTextStream& record) {
+            record << order.getId() << "\n";
+            record << order.getClientName() << "\n";
+            record << order.getClientPhone() << "\n";
+            record << order.getClientEmail() << "\n";
+            record << order.getOrderDate().date().toString(Qt::ISODate) << "\n";
+            record << tourRef << "\n";
+            record << order.getStatusText() << "\n";
+        }));
+    }
+
+    saveHeaderToStream(out, "ORDERS_V2", orders.size());
+    saveOrderIdHighWaterToStream(out, OrderIdAllocator::instance().peekNext());
+    ReferenceCatalog::write(out, catalog.hotels);
+    ReferenceCatalog::write(out, catalog.companies);
+    ReferenceCatalog::write(out, catalog.tours);
+    for (const QString& record : records) {
+        out << record;
+    }
+}
+
+QString FileManager::tourRecordV2(const Tour& tour, ReferenceCatalog& catalog) const {
+    TransportCompany company = tour.getTransportCompany();
+    TransportSchedule selected = tour.getTransportSchedule();
+
+    int hotelRef = ReferenceCatalog::intern(catalog.hotels, catalog.hotelIds, toBlock([&](QTextStream& out) {
+        saveHotelToStream(out, tour.getHotel());
+    }));
+    int companyRef = ReferenceCatalog::intern(catalog.companies, catalog.companyIds, toBlock([&](QTextStream& out) {
+        saveTransportCompanyToStream(out, company);
+    }));
+
+    int scheduleRef = -1;
+    const QVector<TransportSchedule> schedules = company.getSchedules();
+    for (int i = 0; i < schedules.size(); ++i) {
+        if (sameSchedule(schedules[i], selected)) {
+            scheduleRef = i;
+            break;
+        }
+    }
+
+    return toBlock([&](QTextStream& out) {
+        out << tour.getName() << "\n";
+        out << tour.getCountry() << "\n";
+        out << tour.getStartDate().toString(Qt::ISODate) << "\n";
+        out << tour.getEndDate().toString(Qt::ISODate) << "\n";
+        out << hotelRef << "\n";
+        out << companyRef << "\n";
+        out << scheduleRef << "\n";
+        if (scheduleRef < 0) {
+            saveScheduleToStream(out, selected);
+        }
+    });
+}
+
+void FileManager::loadCatalogFromStream(QTextStream& in, QVector<Hotel>& hotels,
+                                        QVector<TransportCompany>& companies) const {
+    int hotelCount = in.readLine().toInt();
+    hotels.reserve(std::max(0, hotelCount));
+    for (int i = 0; i < hotelCount; ++i) {
+        hotels.append(loadHotelFromStream(in));
+    }
+
+    int companyCount = in.readLine().toInt();
+    companies.reserve(std::max(0, companyCount));
+    for (int i = 0; i < companyCount; ++i) {
+        companies.append(loadTransportCompanyFromStream(in));
+    }
+}
+
+Tour FileManager::loadTourRecordFromStream(QTextStream& in, const QVector<Hotel>& hotels,
+                                           const QVector<TransportCompany>& companies) const {
+    QString name = in.readLine().trimmed();
+    QString country = in.readLine().trimmed();
+    QDate startDate = QDate::fromString(in.readLine().trimmed(), Qt::ISODate);
+    QDate endDate = QDate::fromString(in.readLine().trimmed(), Qt::ISODate);
+    QString hotelLine = in.readLine();
+    QString companyLine = in.readLine();
+    QString scheduleLine = in.readLine();
+
+    bool inlineSchedule = scheduleLine.trimmed() == "-1";
+    TransportSchedule schedule;
+    if (inlineSchedule) {
+        schedule = loadScheduleFromStream(in);
+    }
+
+    const Hotel& hotel = hotels[readReference(hotelLine, hotels.size(), "hotel")];
+    const TransportCompany& company = companies[readReference(companyLine, companies.size(), "transport company")];
+    if (!inlineSchedule) {
+        schedule = company.getSchedules()[readReference(scheduleLine, company.getScheduleCount(), "schedule")];
+    }
+
+    Tour tour;
+    tour.setName(name);
+    tour.setCountry(country);
+    if (startDate.isValid()) {
+        tour.setStartDate(startDate);
+    }
+    if (endDate.isValid()) {
+        tour.setEndDate(endDate);
+    }
+    tour.setHotel(hotel);
+    tour.setTransportCompany(company);
+    tour.setTransportSchedule(schedule);
+    return tour;
+}
+
+void FileManager::loadToursV2(QTextStream& in, DataContainer<Tour>& tours) const {
+    int count = in.readLine().toInt();
+    tours.clear();
+    tours.getData().reserve(std::max(0, count));
+
+    QVector<Hotel> hotels;
+    QVector<TransportCompany> companies;
+    loadCatalogFromStream(in, hotels, companies);
+
+    for (int i = 0; i < count; ++i) {
+        try {
+            Tour tour = loadTourRecordFromStream(in, hotels, companies);
+            if (tour.getName().isEmpty() || tour.getCountrySymbol().isEmpty()) {
+                qWarning() << "Skipping tour at index" << i << "- empty name or country";
+                continue;
+            }
+            tours.add(tour);
+        } catch (const FileException& e) {
+            qWarning() << "Error loading tour at index" << i << ":" << e.what();
+        }
+    }
+}
+
+void FileManager::loadOrdersV2(QTextStream& in, DataContainer<Order>& orders) const {
+    int count = in.readLine().toInt();
+    orders.clear();
+    orders.getData().reserve(std::max(0, count));
+
+    OrderIdAllocator& allocator = OrderIdAllocator::instance();
+    bool hasStoredIds = readOrderIdHighWater(in);
+    int reservedId = hasStoredIds ? 0 : allocator.reserve(count);
+
+    QVector<Hotel> hotels;
+    QVector<TransportCompany> companies;
+    loadCatalogFromStream(in, hotels, companies);
+
+    int tourCount = in.readLine().toInt();
+    QVector<std::shared_ptr<const Tour>> tours;
+    tours.reserve(std::max(0, tourCount));
+    for (int i = 0; i < tourCount; ++i) {
+        try {
+            tours.append(std::make_shared<const Tour>(loadTourRecordFromStream(in, hotels, companies)));
+        } catch (const FileException& e) {
+            qWarning() << "Error loading catalog tour at index" << i << ":" << e.what();
+            tours.append(nullptr);
+        }
+    }
+
+    for (int i = 0; i < count; ++i) {
+        try {
+            int orderId = in.readLine().trimmed().toInt();
+            if (!hasStoredIds) {
+                orderId = reservedId + i;
+            }
+            QString clientName = in.readLine().trimmed();
+            QString clientPhone = in.readLine().trimmed();
+            QString clientEmail = in.readLine().trimmed();
+            QDate orderDate = QDate::fromString(in.readLine().trimmed(), Qt::ISODate);
+            QString tourLine = in.readLine();
+            OrderStatus status = readOrderStatus(in);
+            int tourRef = readReference(tourLine, tours.size(), "tour");
+            const std::shared_ptr<const Tour>& tour = tours[tourRef];
+            if (!tour) {
+                throw FileException(QString("Catalog tour %1 could not be loaded").arg(tourRef));
+            }
+
+            Order order;
+            if (orderId > 0) {
+                allocator.observe(orderId);
+                order.setId(orderId);
+            } else {
+                order.setId(allocator.allocate());
+            }
+            order.setTour(tour);
+            order.setClientName(clientName);
+            order.setClientPhone(clientPhone);
+            order.setClientEmail(clientEmail);
+            order.setOrderDate(QDateTime(orderDate, QTime(0, 0)));
+            order.setStatus(status);
+
+            orders.add(order);
+        } catch (const FileException& e) {
+            qWarning() << "Error loading order at index" << i << ":" << e.what();
+        }
+    }
+}
+
+void FileManager::writeIndex(const QString& filename) const {
+    QString indexPath = RecordIndex::pathFor(filename);
+    if (!indexing_) {
+        QFile::remove(indexPath);
+        return;
+    }
+
+    try {
+        if (!MappedFileParser().buildIndex(filename).save(indexPath)) {
+            qWarning() << "Cannot write record index:" << indexPath;
+        }
+    } catch (const FileException& e) {
+        QFile::remove(indexPath);
+        qWarning() << "Cannot index" << filename << ":" << e.what();
+    }
+}
+
+void FileManager::writeChecksums(const QString& filename) const {
+    QString checksumPath = BlockChecksums::pathFor(filename);
+    if (!checksums_) {
+        QFile::remove(checksumPath);
+        return;
+    }
+
+    if (!BlockChecksums::seal(filename)) {
+        qWarning() << "Cannot write block checksums:" << checksumPath;
+    }
+}
+
+void FileManager::verifyChecksums(const QString& filename) const {
+    if (!checksums_) {
+        return;
+    }
+
+    BlockChecksums::Report report = BlockChecksums::verify(filename);
+    if (report.isCorrupt()) {
+        throw FileException(report.changedAfterSeal
+            ? report.describe() + "; if the file was edited on purpose, reseal it from the Diagnostics menu"
+                                  " or with 'agencycli verify --seal'"
+            : report.describe());
+    }
+    if (report.status == BlockChecksums::Status::Modified) {
+        qWarning() << report.describe();
+        checksumWarnings_.append(report.describe());
+    }
+}
+
+QStringList FileManager::takeChecksumWarnings() const {
+    QStringList warnings;
+    warnings.swap(checksumWarnings_);
+    return warnings;
+}
+
+RecordIndex FileManager::openIndex(const QString& filename) const {
+    TRACE_SCOPE("FileManager::openIndex", "io");
+    QString indexPath = RecordIndex::pathFor(filename);
+    RecordIndex index;
+    if (index.load(indexPath) && index.matches(filename)) {
+        return index;
+    }
+
+    index = MappedFileParser().buildIndex(filename);
+    if (indexing_) {
+        index.save(indexPath);
+    }
+    return index;
+}
+
+Tour FileManager::readTour(const QString& filename, const RecordIndex& index, int row) const {
+    return MappedFileParser().readTour(filename, index, row);
+}
+
+Order FileManager::readOrder(const QString& filename, const RecordIndex& index, int row) const {
+    return MappedFileParser().readOrder(filename, index, row);
+}
+
+void FileManager::updateOrder(const QString& filename, RecordIndex& index, const Order& order,
+                              const DataContainer<Order>& orders) const {
+    TRACE_SCOPE("FileManager::updateOrder", "io");
+    const QString staleMessage = QString("Record index is out of date: %1").arg(filename);
+    if (!index.header().startsWith("ORDERS") || !index.matches(filename)) {
+        throw FileException(staleMessage);
+    }
+
+    int row = index.hasStoredIds() ? index.find(RecordIndex::Records, RecordIndex::orderKey(order.getId())) : -1;
+    if (row < 0) {
+        throw FileException(QString("Order %1 is not indexed in %2").arg(order.getId()).arg(filename));
+    }
+    const RecordIndex::Entry entry = index.entry(RecordIndex::Records, row);
+
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw FileException(QString("Cannot open file for reading: %1").arg(filename));
+    }
+    file.seek(entry.offset);
+    QByteArray previous = file.read(entry.length);
+    QList<QByteArray> lines = previous.split('\n');
+    bool normalized = index.header() == "ORDERS_V2";
+    if (previous.size() != entry.length || lines.first().trimmed().toInt() != order.getId() ||
+        (normalized && lines.size() < 7)) {
+        throw FileException(staleMessage);
+    }
+
+    QString record = toBlock([&](QTextStream& out) {
+        if (!normalized) {
+            saveOrderToStream(out, order);
+            return;
+        }
+        out << order.getId() << "\n";
+        out << order.getClientName() << "\n";
+        out << order.getClientPhone() << "\n";
+        out << order.getClientEmail() << "\n";
+        out << order.getOrderDate().date().toString(Qt::ISODate) << "\n";
+        out << QString::fromUtf8(lines[5].trimmed()) << "\n";
+        out << order.getStatusText() << "\n";
+    });
+    QByteArray bytes = record.toUtf8();
+    if (previous.contains("\r\n")) {
+        bytes.replace("\n", "\r\n");
+    }
+
+    QByteArray tail = file.readAll();
+    file.seek(0);
+    QByteArray head = file.read(entry.offset);
+    file.close();
+
+    QSaveFile target(filename);
+    if (!target.open(QIODevice::WriteOnly) || target.write(head) != head.size() ||
+        target.write(bytes) != bytes.size() || target.write(tail) != tail.size()) {
+        throw FileException(QString("Cannot update order %1 in %2").arg(order.getId()).arg(filename));
+    }
+    commitFile(target, filename);
+
+    index.resize(RecordIndex::Records, row, bytes.size());
+    index.stamp(filename);
+    if (indexing_) {
+        index.save(RecordIndex::pathFor(filename));
+    }
+    refreshOrderDetails(orders, filename, index);
+}
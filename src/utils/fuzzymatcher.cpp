@@ -0,0 +1,293 @@
+#include "utils/fuzzymatcher.h"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <utility>
+
+namespace {
+
+const QHash<char16_t, QString>& transliterationTable() {
+    static const QHash<char16_t, QString> table = {
+        {u'а', "a"}, {u'б', "b"}, {u'в', "v"}, {u'г', "g"}, {u'д', "d"},
+        {u'е', "e"}, {u'ё', "e"}, {u'ж', "zh"}, {u'з', "z"}, {u'и', "i"},
+        {u'й', "y"}, {u'к', "k"}, {u'л', "l"}, {u'м', "m"}, {u'н', "n"},
+        {u'о', "o"}, {u'п', "p"}, {u'р', "r"}, {u'с', "s"}, {u'т', "t"},
+        {u'у', "u"}, {u'ф', "f"}, {u'х', "kh"}, {u'ц', "ts"}, {u'ч', "ch"},
+        {u'ш', "sh"}, {u'щ', "shch"}, {u'ъ', ""}, {u'ы', "y"}, {u'ь', ""},
+        {u'э', "e"}, {u'ю', "yu"}, {u'я', "ya"}, {u'і', "i"}, {u'ў', "u"},
+        {u'є', "ye"}, {u'ї', "yi"}, {u'ґ', "g"}
+    };
+    return table;
+}
+
+}
+
+QString FuzzyMatcher::normalize(const QString& text) {
+    const QHash<char16_t, QString>& table = transliterationTable();
+    QString decomposed = text.toLower().normalized(QString::NormalizationForm_KD);
+
+    QString result;
+    result.reserve(decomposed.size());
+    bool pendingSpace = false;
+
+    for (QChar ch : decomposed) {
+        if (ch.category() == QChar::Mark_NonSpacing) {
+            continue;
+        }
+
+        QString piece;
+        auto it = table.constFind(ch.unicode());
+        if (it != table.cend()) {
+            piece = it.value();
+        } else if (ch.unicode() < 128 && ch.isLetterOrNumber()) {
+            piece = ch;
+        } else {
+            pendingSpace = !result.isEmpty();
+            continue;
+        }
+
+        if (pendingSpace) {
+            result += ' ';
+            pendingSpace = false;
+        }
+        result += piece;
+    }
+    return result;
+}
+
+int FuzzyMatcher::maxDistanceFor(int length) {
+    if (length <= 3) {
+        return 0;
+    }
+    if (length <= 6) {
+        return 1;
+    }
+    if (length <= 12) {
+        return 2;
+    }
+    return 3;
+}
+
+int FuzzyMatcher::editDistance(const QString& lhs, const QString& rhs) {
+    if (lhs.isEmpty()) {
+        return rhs.size();
+    }
+    if (rhs.isEmpty()) {
+        return lhs.size();
+    }
+
+    const QString& pattern = lhs.size() <= rhs.size() ? lhs : rhs;
+    const QString& text = lhs.size() <= rhs.size() ? rhs : lhs;
+    if (pattern.size() <= 64) {
+        return bitParallelDistance(pattern, text);
+    }
+    return dynamicDistance(lhs, rhs);
+}
+
+int FuzzyMatcher::bitParallelDistance(const QString& pattern, const QString& text) {
+    std::array<quint64, 128> asciiPeq{};
+    QHash<char16_t, quint64> otherPeq;
+
+    int m = pattern.size();
+    for (int i = 0; i < m; ++i) {
+        char16_t code = pattern[i].unicode();
+        if (code < 128) {
+            asciiPeq[code] |= quint64(1) << i;
+        } else {
+            otherPeq[code] |= quint64(1) << i;
+        }
+    }
+
+    quint64 pv = ~quint64(0);
+    quint64 mv = 0;
+    quint64 highBit = quint64(1) << (m - 1);
+    int score = m;
+
+    for (QChar ch : text) {
+        char16_t code = ch.unicode();
+        quint64 eq = code < 128 ? asciiPeq[code] : otherPeq.value(code, 0);
+
+        quint64 xv = eq | mv;
+        quint64 xh = (((eq & pv) + pv) ^ pv) | eq;
+        quint64 ph = mv | ~(xh | pv);
+        quint64 mh = pv & xh;
+
+        if (ph & highBit) {
+            ++score;
+        } else if (mh & highBit) {
+            --score;
+        }
+
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+    }
+    return score;
+}
+
+int FuzzyMatcher::dynamicDistance(const QString& lhs, const QString& rhs) {
+    QVector<int> previous(rhs.size() + 1);
+    QVector<int> current(rhs.size() + 1);
+    for (int j = 0; j <= rhs.size(); ++j) {
+        previous[j] = j;
+    }
+
+    for (int i = 1; i <= lhs.size(); ++i) {
+        current[0] = i;
+        for (int j = 1; j <= rhs.size(); ++j) {
+            int substitution = previous[j - 1] + (lhs[i - 1] == rhs[j - 1] ? 0 : 1);
+            current[j] = std::min({previous[j] + 1, current[j - 1] + 1, substitution});
+        }
+        std::swap(previous, current);
+    }
+    return previous[rhs.size()];
+}
+
+bool FuzzyMatcher::isSimilar(const QString& normalizedLhs, const QString& normalizedRhs) {
+    if (normalizedLhs.isEmpty() || normalizedRhs.isEmpty()) {
+        return false;
+    }
+    if (normalizedLhs == normalizedRhs) {
+        return true;
+    }
+
+    int limit = maxDistanceFor(std::min(normalizedLhs.size(), normalizedRhs.size()));
+    if (std::abs(normalizedLhs.size() - normalizedRhs.size()) > limit) {
+        return false;
+    }
+    return editDistance(normalizedLhs, normalizedRhs) <= limit;
+}
+
+bool FuzzyMatcher::matches(const QString& lhs, const QString& rhs) {
+    return matchesNormalized(normalize(lhs), normalize(rhs));
+}
+
+bool FuzzyMatcher::matchesNormalized(const QString& left, const QString& right) {
+    if (left.isEmpty() || right.isEmpty()) {
+        return false;
+    }
+    return left.contains(right) || right.contains(left) || isSimilar(left, right);
+}
+
+void FuzzyIndex::clear() {
+    entries_.clear();
+    bySymbol_.clear();
+    postings_.clear();
+    byLength_.clear();
+    similarCache_.clear();
+}
+
+QVector<quint32> FuzzyIndex::bigrams(const QString& normalized) {
+    QString padded = ' ' + normalized + ' ';
+    QVector<quint32> result;
+    result.reserve(padded.size() - 1);
+    for (int i = 0; i + 1 < padded.size(); ++i) {
+        quint32 code = (quint32(padded[i].unicode()) << 16) | padded[i + 1].unicode();
+        if (!result.contains(code)) {
+            result.append(code);
+        }
+    }
+    return result;
+}
+
+void FuzzyIndex::add(Symbol symbol) {
+    if (symbol.isEmpty() || bySymbol_.contains(symbol.id())) {
+        return;
+    }
+
+    QString normalized = FuzzyMatcher::normalize(symbol.toString());
+    if (normalized.isEmpty()) {
+        return;
+    }
+
+    int index = entries_.size();
+    entries_.append(Entry{symbol, normalized});
+    bySymbol_.insert(symbol.id(), index);
+    byLength_[normalized.size()].append(index);
+    for (quint32 gram : bigrams(normalized)) {
+        postings_[gram].append(index);
+    }
+    similarCache_.clear();
+}
+
+void FuzzyIndex::add(const QSet<Symbol>& symbols) {
+    for (Symbol symbol : symbols) {
+        add(symbol);
+    }
+}
+
+QVector<Symbol> FuzzyIndex::lookupNormalized(const QString& normalized) const {
+    QVector<Symbol> result;
+    if (normalized.isEmpty()) {
+        return result;
+    }
+
+    int limit = FuzzyMatcher::maxDistanceFor(normalized.size());
+    QVector<quint32> grams = bigrams(normalized);
+    int threshold = grams.size() - 2 * limit;
+
+    QVector<int> candidates;
+    if (threshold <= 0) {
+        for (int length = normalized.size() - limit; length <= normalized.size() + limit; ++length) {
+            candidates += byLength_.value(length);
+        }
+    } else {
+        QHash<int, int> shared;
+        for (quint32 gram : grams) {
+            auto posting = postings_.constFind(gram);
+            if (posting == postings_.cend()) {
+                continue;
+            }
+            for (int index : posting.value()) {
+                ++shared[index];
+            }
+        }
+        for (auto it = shared.cbegin(); it != shared.cend(); ++it) {
+            if (it.value() >= threshold) {
+                candidates.append(it.key());
+            }
+        }
+    }
+
+    QVector<std::pair<int, int>> ranked;
+    for (int index : candidates) {
+        const QString& candidate = entries_[index].normalized;
+        if (std::abs(candidate.size() - normalized.size()) > limit) {
+            continue;
+        }
+        int distance = FuzzyMatcher::editDistance(normalized, candidate);
+        if (distance <= limit) {
+            ranked.append({distance, index});
+        }
+    }
+
+    std::sort(ranked.begin(), ranked.end());
+    result.reserve(ranked.size());
+    for (const auto& entry : ranked) {
+        result.append(entries_[entry.second].symbol);
+    }
+    return result;
+}
+
+QVector<Symbol> FuzzyIndex::lookup(const QString& query) const {
+    return lookupNormalized(FuzzyMatcher::normalize(query));
+}
+
+QString FuzzyIndex::normalized(Symbol symbol) const {
+    auto indexed = bySymbol_.constFind(symbol.id());
+    return indexed != bySymbol_.cend()
+        ? entries_[indexed.value()].normalized
+        : FuzzyMatcher::normalize(symbol.toString());
+}
+
+QVector<Symbol> FuzzyIndex::similarTo(Symbol symbol) const {
+    auto cached = similarCache_.constFind(symbol.id());
+    if (cached != similarCache_.cend()) {
+        return cached.value();
+    }
+
+    QVector<Symbol> result = lookupNormalized(normalized(symbol));
+    similarCache_.insert(symbol.id(), result);
+    return result;
+}
@@ -0,0 +1,277 @@
+#include "utils/jsonserializer.h"
+#include "utils/filemanager.h"
+#include <QCborValue>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonParseError>
+
+QJsonObject JsonSerializer::moneyToJson(const Money& money) {
+    QJsonObject object;
+    object["kopecks"] = money.kopecks();
+    object["currency"] = money.currencyCode();
+    return object;
+}
+
+Money JsonSerializer::moneyFromJson(const QJsonObject& object) {
+    QString code = object["currency"].toString();
+    quint32 currency = code.isEmpty() ? Money::DefaultCurrency : Money::currencyFromCode(code);
+    return Money(object["kopecks"].toInteger(), currency);
+}
+
+QJsonObject JsonSerializer::countryToJson(const Country& country) {
+    QJsonObject object;
+    object["name"] = country.getName();
+    object["continent"] = country.getContinent();
+    object["capital"] = country.getCapital();
+    object["currency"] = country.getCurrency();
+    return object;
+}
+
+Country JsonSerializer::countryFromJson(const QJsonObject& object) {
+    Country country(object["name"].toString(), object["continent"].toString());
+    country.setCapital(object["capital"].toString());
+    country.setCurrency(object["currency"].toString());
+    return country;
+}
+
+QJsonObject JsonSerializer::hotelToJson(const Hotel& hotel) {
+    QJsonObject object;
+    object["name"] = hotel.getName();
+    object["country"] = hotel.getCountry();
+    object["stars"] = hotel.getStars();
+    object["address"] = hotel.getAddress();
+
+    QJsonArray rooms;
+    for (const Room& room : hotel.getRooms()) {
+        QJsonObject roomObject;
+        roomObject["name"] = room.getName();
+        roomObject["type"] = Room::roomTypeToString(room.getRoomType());
+        roomObject["price"] = moneyToJson(room.getPricePerNight());
+        roomObject["capacity"] = room.getCapacity();
+        rooms.append(roomObject);
+    }
+    object["rooms"] = rooms;
+    return object;
+}
+
+Hotel JsonSerializer::hotelFromJson(const QJsonObject& object) {
+    Hotel hotel(object["name"].toString(), object["country"].toString(),
+                object["stars"].toInt(3), object["address"].toString());
+
+    for (const QJsonValue& value : object["rooms"].toArray()) {
+        QJsonObject roomObject = value.toObject();
+        hotel.addRoom(Room(roomObject["name"].toString(),
+                           Room::stringToRoomType(roomObject["type"].toString()),
+                           moneyFromJson(roomObject["price"].toObject()),
+                           roomObject["capacity"].toInt(1)));
+    }
+    return hotel;
+}
+
+QJsonObject JsonSerializer::scheduleToJson(const TransportSchedule& schedule) {
+    QJsonObject object;
+    object["from"] = schedule.departureCity.toString();
+    object["to"] = schedule.arrivalCity.toString();
+    object["departure"] = schedule.departureDate.toString(Qt::ISODate);
+    object["arrival"] = schedule.arrivalDate.toString(Qt::ISODate);
+    object["price"] = moneyToJson(schedule.price);
+    object["seats"] = schedule.availableSeats;
+    return object;
+}
+
+TransportSchedule JsonSerializer::scheduleFromJson(const QJsonObject& object) {
+    TransportSchedule schedule;
+    schedule.departureCity = Symbol(object["from"].toString());
+    schedule.arrivalCity = Symbol(object["to"].toString());
+    schedule.departureDate = QDate::fromString(object["departure"].toString(), Qt::ISODate);
+    schedule.arrivalDate = QDate::fromString(object["arrival"].toString(), Qt::ISODate);
+    schedule.price = moneyFromJson(object["price"].toObject());
+    schedule.availableSeats = object["seats"].toInt();
+    return schedule;
+}
+
+QJsonObject JsonSerializer::companyToJson(const TransportCompany& company) {
+    QJsonObject object;
+    object["name"] = company.getName();
+    object["type"] = TransportCompany::transportTypeToString(company.getTransportType());
+
+    QJsonArray schedules;
+    for (const TransportSchedule& schedule : company.getSchedules()) {
+        schedules.append(scheduleToJson(schedule));
+    }
+    object["schedules"] = schedules;
+    return object;
+}
+
+TransportCompany JsonSerializer::companyFromJson(const QJsonObject& object) {
+    TransportCompany company(object["name"].toString(),
+                             TransportCompany::stringToTransportType(object["type"].toString()));
+    for (const QJsonValue& value : object["schedules"].toArray()) {
+        company.addSchedule(scheduleFromJson(value.toObject()));
+    }
+    return company;
+}
+
+QJsonObject JsonSerializer::tourToJson(const Tour& tour) {
+    QJsonObject object;
+    object["name"] = tour.getName();
+    object["country"] = tour.getCountry();
+    object["start"] = tour.getStartDate().toString(Qt::ISODate);
+    object["end"] = tour.getEndDate().toString(Qt::ISODate);
+    object["hotel"] = hotelToJson(tour.getHotel());
+    object["transport"] = companyToJson(tour.getTransportCompany());
+    object["schedule"] = scheduleToJson(tour.getTransportSchedule());
+    return object;
+}
+
+Tour JsonSerializer::tourFromJson(const QJsonObject& object) {
+    Tour tour(object["name"].toString(), object["country"].toString(),
+              QDate::fromString(object["start"].toString(), Qt::ISODate),
+              QDate::fromString(object["end"].toString(), Qt::ISODate));
+    tour.setHotel(hotelFromJson(object["hotel"].toObject()));
+    tour.setTransportCompany(companyFromJson(object["transport"].toObject()));
+    tour.setTransportSchedule(scheduleFromJson(object["schedule"].toObject()));
+    return tour;
+}
+
+QJsonObject JsonSerializer::orderToJson(const Order& order) {
+    QJsonObject object;
+    object["id"] = order.getId();
+    object["client"] = order.getClientName();
+    object["phone"] = order.getClientPhone();
+    object["email"] = order.getClientEmail();
+    object["date"] = order.getOrderDate().date().toString(Qt::ISODate);
+    object["status"] = order.getStatusText();
+    object["tour"] = tourToJson(order.getTour());
+    return object;
+}
+
+Order JsonSerializer::orderFromJson(const QJsonObject& object) {
+    Order order;
+    int id = object["id"].toInt();
+    if (id > 0) {
+        OrderIdAllocator::instance().observe(id);
+        order.setId(id);
+    } else {
+        order.setId(OrderIdAllocator::instance().allocate());
+    }
+    order.setClientName(object["client"].toString());
+    order.setClientPhone(object["phone"].toString());
+    order.setClientEmail(object["email"].toString());
+    order.setOrderDate(QDateTime(QDate::fromString(object["date"].toString(), Qt::ISODate), QTime(0, 0)));
+
+    OrderStatus status;
+    if (OrderStatusInfo::tryParse(object["status"].toString(), status)) {
+        order.setStatus(status);
+    }
+    order.setTour(tourFromJson(object["tour"].toObject()));
+    return order;
+}
+
+QJsonObject JsonSerializer::toJson(const DataContainer<Country>& countries,
+                                   const DataContainer<Hotel>& hotels,
+                                   const DataContainer<TransportCompany>& companies,
+                                   const DataContainer<Tour>& tours,
+                                   const DataContainer<Order>& orders) {
+    QJsonArray countryArray;
+    for (const auto& country : countries.getData()) {
+        countryArray.append(countryToJson(country));
+    }
+
+    QJsonArray hotelArray;
+    for (const auto& hotel : hotels.getData()) {
+        hotelArray.append(hotelToJson(hotel));
+    }
+
+    QJsonArray companyArray;
+    for (const auto& company : companies.getData()) {
+        companyArray.append(companyToJson(company));
+    }
+
+    QJsonArray tourArray;
+    for (const auto& tour : tours.getData()) {
+        tourArray.append(tourToJson(tour));
+    }
+
+    QJsonArray orderArray;
+    for (const auto& order : orders.getData()) {
+        orderArray.append(orderToJson(order));
+    }
+
+    QJsonObject root;
+    root["version"] = FormatVersion;
+    root["nextOrderId"] = OrderIdAllocator::instance().peekNext();
+    root["countries"] = countryArray;
+    root["hotels"] = hotelArray;
+    root["transportCompanies"] = companyArray;
+    root["tours"] = tourArray;
+    root["orders"] = orderArray;
+    return root;
+}
+
+void JsonSerializer::fromJson(const QJsonObject& root,
+                              DataContainer<Country>& countries,
+                              DataContainer<Hotel>& hotels,
+                              DataContainer<TransportCompany>& companies,
+                              DataContainer<Tour>& tours,
+                              DataContainer<Order>& orders) {
+    int version = root["version"].toInt();
+    if (version <= 0 || version > FormatVersion) {
+        throw FileException(QString("Unsupported JSON format version: %1").arg(version));
+    }
+
+    countries.clear();
+    for (const QJsonValue& value : root["countries"].toArray()) {
+        countries.add(countryFromJson(value.toObject()));
+    }
+
+    hotels.clear();
+    for (const QJsonValue& value : root["hotels"].toArray()) {
+        hotels.add(hotelFromJson(value.toObject()));
+    }
+
+    companies.clear();
+    for (const QJsonValue& value : root["transportCompanies"].toArray()) {
+        companies.add(companyFromJson(value.toObject()));
+    }
+
+    tours.clear();
+    for (const QJsonValue& value : root["tours"].toArray()) {
+        tours.add(tourFromJson(value.toObject()));
+    }
+
+    orders.clear();
+    for (const QJsonValue& value : root["orders"].toArray()) {
+        orders.add(orderFromJson(value.toObject()));
+    }
+
+    int nextOrderId = root["nextOrderId"].toInt();
+    if (nextOrderId > 1) {
+        OrderIdAllocator::instance().observe(nextOrderId - 1);
+    }
+}
+
+QByteArray JsonSerializer::encode(const QJsonObject& root, bool binary) {
+    if (binary) {
+        return QCborValue::fromJsonValue(root).toCbor();
+    }
+    return QJsonDocument(root).toJson(QJsonDocument::Indented);
+}
+
+QJsonObject JsonSerializer::decode(const QByteArray& data, bool binary) {
+    if (binary) {
+        QCborParserError error;
+        QCborValue value = QCborValue::fromCbor(data, &error);
+        if (error.error != QCborError::NoError || !value.isMap()) {
+            throw FileException(QString("Invalid binary data: %1").arg(error.errorString()));
+        }
+        return value.toJsonValue().toObject();
+    }
+
+    QJsonParseError error;
+    QJsonDocument document = QJsonDocument::fromJson(data, &error);
+    if (error.error != QJsonParseError::NoError || !document.isObject()) {
+        throw FileException(QString("Invalid JSON data: %1").arg(error.errorString()));
+    }
+    return document.object();
+}
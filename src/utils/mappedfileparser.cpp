@@ -0,0 +1,1242 @@
+#include "utils/mappedfileparser.h"
+#include "utils/filemanager.h"
+#include "utils/orderdetailsource.h"
+#include "utils/orderidallocator.h"
+#include "utils/recordindex.h"
+#include <QDebug>
+#include <QFile>
+#include <QLocale>
+#include <QtAlgorithms>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MAPPED_PARSER_SSE2 1
+#endif
+
+namespace {
+
+class MappedFile {
+public:
+    explicit MappedFile(const QString& filename)
+        : file_(filename) {
+        if (!file_.exists()) {
+            qWarning() << "File does not exist:" << filename;
+            throw FileException(QString("File does not exist: %1").arg(filename));
+        }
+        if (!file_.open(QIODevice::ReadOnly)) {
+            throw FileException(QString("Cannot open file for reading: %1").arg(filename));
+        }
+
+        qint64 size = file_.size();
+        if (size > 0) {
+            uchar* mapped = file_.map(0, size);
+            if (mapped) {
+                data_ = reinterpret_cast<const char*>(mapped);
+            } else {
+                fallback_ = file_.readAll();
+                data_ = fallback_.constData();
+                size = fallback_.size();
+            }
+            begin_ = data_;
+            end_ = data_ + size;
+        }
+
+        if (end_ - begin_ >= 3 && std::memcmp(begin_, "\xEF\xBB\xBF", 3) == 0) {
+            begin_ += 3;
+        }
+    }
+
+    const char* data() const { return data_; }
+    const char* begin() const { return begin_; }
+    const char* end() const { return end_; }
+
+private:
+    QFile file_;
+    QByteArray fallback_;
+    const char* data_ = nullptr;
+    const char* begin_ = nullptr;
+    const char* end_ = nullptr;
+};
+
+const char* findNewline(const char* from, const char* end) {
+#ifdef MAPPED_PARSER_SSE2
+    const __m128i newline = _mm_set1_epi8('\n');
+    while (end - from >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline));
+        if (mask != 0) {
+            return from + qCountTrailingZeroBits(static_cast<quint32>(mask));
+        }
+        from += 16;
+    }
+#endif
+    const void* hit = std::memchr(from, '\n', static_cast<size_t>(end - from));
+    return hit ? static_cast<const char*>(hit) : end;
+}
+
+int leadingSpaceBytes(std::string_view text) {
+    if (text.empty()) {
+        return 0;
+    }
+    unsigned char c0 = static_cast<unsigned char>(text[0]);
+    if (c0 == ' ' || (c0 >= '\t' && c0 <= '\r')) {
+        return 1;
+    }
+    if (c0 < 0xC2 || text.size() < 2) {
+        return 0;
+    }
+    unsigned char c1 = static_cast<unsigned char>(text[1]);
+    if (c0 == 0xC2) {
+        return c1 == 0x85 || c1 == 0xA0 ? 2 : 0;
+    }
+    if (text.size() < 3) {
+        return 0;
+    }
+    unsigned char c2 = static_cast<unsigned char>(text[2]);
+    if (c0 == 0xE1) {
+        return c1 == 0x9A && c2 == 0x80 ? 3 : 0;
+    }
+    if (c0 == 0xE2 && c1 == 0x80) {
+        return (c2 >= 0x80 && c2 <= 0x8A) || c2 == 0xA8 || c2 == 0xA9 || c2 == 0xAF ? 3 : 0;
+    }
+    if (c0 == 0xE2 && c1 == 0x81) {
+        return c2 == 0x9F ? 3 : 0;
+    }
+    if (c0 == 0xE3) {
+        return c1 == 0x80 && c2 == 0x80 ? 3 : 0;
+    }
+    return 0;
+}
+
+int trailingSpaceBytes(std::string_view text) {
+    if (text.empty()) {
+        return 0;
+    }
+    unsigned char last = static_cast<unsigned char>(text.back());
+    if (last == ' ' || (last >= '\t' && last <= '\r')) {
+        return 1;
+    }
+    if (last < 0x80) {
+        return 0;
+    }
+    for (int length = 2; length <= 3 && length <= static_cast<int>(text.size()); ++length) {
+        if (leadingSpaceBytes(text.substr(text.size() - length)) == length) {
+            return length;
+        }
+    }
+    return 0;
+}
+
+std::string_view trimmed(std::string_view text) {
+    while (int bytes = leadingSpaceBytes(text)) {
+        text.remove_prefix(bytes);
+    }
+    while (int bytes = trailingSpaceBytes(text)) {
+        text.remove_suffix(bytes);
+    }
+    return text;
+}
+
+QString toQString(std::string_view text) {
+    return QString::fromUtf8(text.data(), static_cast<qsizetype>(text.size()));
+}
+
+int toInt(std::string_view text, bool* ok = nullptr) {
+    std::string_view digits = trimmed(text);
+    if (digits.size() > 1 && digits[0] == '+' && digits[1] != '-') {
+        digits.remove_prefix(1);
+    }
+
+    int value = 0;
+    auto [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(), value);
+    bool valid = !digits.empty() && error == std::errc() && end == digits.data() + digits.size();
+    if (ok) {
+        *ok = valid;
+    }
+    return valid ? value : 0;
+}
+
+QDate toDate(std::string_view text) {
+    auto digit = [&](size_t index) { return text[index] >= '0' && text[index] <= '9'; };
+    if (text.size() == 10 && text[4] == '-' && text[7] == '-' &&
+        digit(0) && digit(1) && digit(2) && digit(3) && digit(5) && digit(6) && digit(8) && digit(9)) {
+        int year = (text[0] - '0') * 1000 + (text[1] - '0') * 100 + (text[2] - '0') * 10 + (text[3] - '0');
+        int month = (text[5] - '0') * 10 + (text[6] - '0');
+        int day = (text[8] - '0') * 10 + (text[9] - '0');
+        return QDate(year, month, day);
+    }
+    return text.empty() ? QDate() : QDate::fromString(toQString(text), Qt::ISODate);
+}
+
+bool parseMoney(std::string_view text, Money& result) {
+    std::string_view value = trimmed(text);
+    if (value.empty()) {
+        return false;
+    }
+
+    size_t pos = 0;
+    bool negative = false;
+    if (value[0] == '-' || value[0] == '+') {
+        negative = value[0] == '-';
+        ++pos;
+    }
+
+    qint64 units = 0;
+    int unitDigits = 0;
+    while (pos < value.size() && value[pos] >= '0' && value[pos] <= '9') {
+        if (++unitDigits > 15) {
+            break;
+        }
+        units = units * 10 + (value[pos] - '0');
+        ++pos;
+    }
+
+    qint64 fraction = 0;
+    int fractionDigits = 0;
+    if (unitDigits <= 15 && pos < value.size() && (value[pos] == '.' || value[pos] == ',')) {
+        ++pos;
+        while (pos < value.size() && value[pos] >= '0' && value[pos] <= '9' && fractionDigits <= 2) {
+            ++fractionDigits;
+            fraction = fraction * 10 + (value[pos] - '0');
+            ++pos;
+        }
+    }
+
+    if (pos == value.size() && unitDigits <= 15 && fractionDigits <= 2 && (unitDigits > 0 || fractionDigits > 0)) {
+        if (fractionDigits == 1) {
+            fraction *= 10;
+        }
+        qint64 kopecks = units * Money::KopecksPerUnit + fraction;
+        result = Money(negative ? -kopecks : kopecks);
+        return true;
+    }
+
+    QString slow = toQString(text);
+    if (Money::tryParse(slow, result)) {
+        return true;
+    }
+    bool ok;
+    double legacyValue = QLocale(QLocale::C).toDouble(slow.trimmed(), &ok);
+    if (!ok || !std::isfinite(legacyValue)) {
+        return false;
+    }
+    result = Money::fromDouble(legacyValue);
+    return true;
+}
+
+class Reader {
+public:
+    explicit Reader(const MappedFile& file)
+        : pos_(file.begin())
+        , end_(file.end()) {}
+
+    bool atEnd() const { return pos_ >= end_; }
+    const char* position() const { return pos_; }
+    void seek(const char* position) { pos_ = position; }
+
+    std::string_view line() {
+        if (pos_ >= end_) {
+            return std::string_view();
+        }
+        const char* newline = findNewline(pos_, end_);
+        const char* lineEnd = newline;
+        if (lineEnd > pos_ && lineEnd[-1] == '\r') {
+            --lineEnd;
+        }
+        std::string_view result(pos_, static_cast<size_t>(lineEnd - pos_));
+        pos_ = newline < end_ ? newline + 1 : end_;
+        return result;
+    }
+
+    std::string_view trimmedLine() { return trimmed(line()); }
+    int intLine(bool* ok = nullptr) { return toInt(line(), ok); }
+
+    void skip(int lines) {
+        for (int i = 0; i < lines && !atEnd(); ++i) {
+            line();
+        }
+    }
+
+    void validateHeader(std::string_view expected) {
+        if (line() != expected) {
+            throw FileException("Invalid file format");
+        }
+    }
+
+private:
+    const char* pos_;
+    const char* end_;
+};
+
+struct LoadedCatalog {
+    QVector<Hotel> hotels;
+    QVector<TransportCompany> companies;
+
+    int hotelCount() const { return hotels.size(); }
+    int companyCount() const { return companies.size(); }
+    const Hotel& hotel(int index) const { return hotels[index]; }
+    const TransportCompany& company(int index) const { return companies[index]; }
+};
+
+struct TourSummary {
+    Symbol name;
+    Symbol country;
+    Money cost;
+    bool valid = false;
+};
+
+Money tourCost(const Money& schedulePrice, bool hasRoom, const Money& roomPrice,
+               const QDate& startDate, const QDate& endDate) {
+    Money cost = schedulePrice;
+    int nights = startDate.isValid() && endDate.isValid() ? startDate.daysTo(endDate) : 0;
+    if (nights > 0 && hasRoom) {
+        cost += roomPrice * nights;
+    }
+    return cost;
+}
+
+class Parser {
+public:
+    explicit Parser(const MappedFile& file)
+        : in(file) {}
+
+    Reader in;
+
+    QString text(std::string_view value) {
+        if (value.empty()) {
+            return QString();
+        }
+        auto it = strings_.find(value);
+        if (it != strings_.end()) {
+            return it->second;
+        }
+        return strings_.emplace(value, toQString(value)).first->second;
+    }
+
+    Symbol symbol(std::string_view value) {
+        if (value.empty()) {
+            return Symbol();
+        }
+        auto it = symbols_.find(value);
+        if (it != symbols_.end()) {
+            return it->second;
+        }
+        return symbols_.emplace(value, Symbol(toQString(value))).first->second;
+    }
+
+    Money money() {
+        std::string_view value = in.line();
+        Money result;
+        if (!trimmed(value).empty() && !parseMoney(value, result)) {
+            throw FileException(QString("Invalid money amount: '%1'").arg(toQString(value)));
+        }
+        return result;
+    }
+
+    Room room() {
+        Room result;
+        result.setName(text(in.trimmedLine()));
+        result.setRoomType(static_cast<Room::RoomType>(in.intLine()));
+        result.setPricePerNight(money());
+        result.setCapacity(in.intLine());
+        return result;
+    }
+
+    Room checkedRoom(const QString& hotelName, int hotelIndex, int roomIndex) {
+        std::string_view roomName = in.trimmedLine();
+        std::string_view roomTypeStr = in.trimmedLine();
+        std::string_view priceStr = in.trimmedLine();
+        std::string_view capacityStr = in.trimmedLine();
+
+        if (roomName.empty() || roomTypeStr.empty() || priceStr.empty() || capacityStr.empty()) {
+            throw FileException(QString("Incomplete room data for hotel '%1' (index %7), room %2. RoomName: '%3', RoomType: '%4', Price: '%5', Capacity: '%6'")
+                .arg(hotelName).arg(roomIndex).arg(toQString(roomName)).arg(toQString(roomTypeStr))
+                .arg(toQString(priceStr)).arg(toQString(capacityStr)).arg(hotelIndex));
+        }
+
+        bool ok;
+        int roomType = toInt(roomTypeStr, &ok);
+        if (!ok || roomType < 0 || roomType > 3) {
+            throw FileException(QString("Invalid room type for hotel '%1' (index %4), room %2: '%3'")
+                .arg(hotelName).arg(roomIndex).arg(toQString(roomTypeStr)).arg(hotelIndex));
+        }
+
+        Money price;
+        if (!parseMoney(priceStr, price) || price.kopecks() < 0) {
+            throw FileException(QString("Invalid price for hotel '%1' (index %4), room %2: expected number, got '%3'")
+                .arg(hotelName).arg(roomIndex).arg(toQString(priceStr)).arg(hotelIndex));
+        }
+
+        int capacity = toInt(capacityStr, &ok);
+        if (!ok || capacity <= 0) {
+            throw FileException(QString("Invalid capacity for hotel '%1' (index %4), room %2: '%3'")
+                .arg(hotelName).arg(roomIndex).arg(toQString(capacityStr)).arg(hotelIndex));
+        }
+
+        Room result;
+        result.setName(text(roomName));
+        result.setRoomType(static_cast<Room::RoomType>(roomType));
+        result.setPricePerNight(price);
+        result.setCapacity(capacity);
+        return result;
+    }
+
+    Hotel hotel() {
+        Hotel result;
+        QString name = text(in.trimmedLine());
+        Symbol country = symbol(in.trimmedLine());
+        int stars = in.intLine();
+        QString address = text(in.trimmedLine());
+        int roomCount = in.intLine();
+
+        result.setName(name);
+        result.setCountry(country);
+        result.setStars(stars);
+        result.setAddress(address);
+        for (int j = 0; j < roomCount; ++j) {
+            result.addRoom(room());
+        }
+        return result;
+    }
+
+    TransportSchedule schedule() {
+        TransportSchedule result;
+        result.departureCity = symbol(in.trimmedLine());
+        result.arrivalCity = symbol(in.trimmedLine());
+        result.departureDate = toDate(in.trimmedLine());
+        result.arrivalDate = toDate(in.trimmedLine());
+        result.price = money();
+        result.availableSeats = in.intLine();
+        return result;
+    }
+
+    TransportCompany company() {
+        TransportCompany result;
+        result.setName(text(in.line()));
+        result.setTransportType(static_cast<TransportCompany::TransportType>(in.intLine()));
+
+        int scheduleCount = in.intLine();
+        for (int j = 0; j < scheduleCount; ++j) {
+            result.addSchedule(schedule());
+        }
+        return result;
+    }
+
+    bool orderIdHighWater(bool observe = true) {
+        constexpr std::string_view prefix = "NEXT_ID:";
+        if (in.atEnd()) {
+            return false;
+        }
+
+        const char* position = in.position();
+        std::string_view value = in.trimmedLine();
+        if (value.substr(0, prefix.size()) != prefix) {
+            in.seek(position);
+            return false;
+        }
+
+        bool ok;
+        int nextId = toInt(value.substr(prefix.size()), &ok);
+        if (!ok) {
+            throw FileException(QString("Invalid order id high-water mark: '%1'").arg(toQString(value)));
+        }
+        if (observe) {
+            OrderIdAllocator::instance().observe(nextId - 1);
+        }
+        return true;
+    }
+
+    OrderStatus orderStatus() {
+        if (in.atEnd()) {
+            return OrderStatus::Processing;
+        }
+
+        const char* position = in.position();
+        std::string_view value = in.line();
+
+        OrderStatus status;
+        if (OrderStatusInfo::tryParse(text(trimmed(value)), status)) {
+            return status;
+        }
+
+        in.seek(position);
+        return OrderStatus::Processing;
+    }
+
+    void catalog(LoadedCatalog& catalog) {
+        int hotelCount = in.intLine();
+        catalog.hotels.reserve(std::max(0, hotelCount));
+        for (int i = 0; i < hotelCount; ++i) {
+            catalog.hotels.append(hotel());
+        }
+
+        int companyCount = in.intLine();
+        catalog.companies.reserve(std::max(0, companyCount));
+        for (int i = 0; i < companyCount; ++i) {
+            catalog.companies.append(company());
+        }
+    }
+
+    template<typename Catalog>
+    Tour tourRecord(Catalog& catalog) {
+        std::string_view name = in.trimmedLine();
+        std::string_view country = in.trimmedLine();
+        QDate startDate = toDate(in.trimmedLine());
+        QDate endDate = toDate(in.trimmedLine());
+        std::string_view hotelLine = in.line();
+        std::string_view companyLine = in.line();
+        std::string_view scheduleLine = in.line();
+
+        bool inlineSchedule = trimmed(scheduleLine) == "-1";
+        TransportSchedule selected;
+        if (inlineSchedule) {
+            selected = schedule();
+        }
+
+        Hotel hotel = catalog.hotel(reference(hotelLine, catalog.hotelCount(), "hotel"));
+        TransportCompany company = catalog.company(reference(companyLine, catalog.companyCount(), "transport company"));
+        if (!inlineSchedule) {
+            selected = company.getSchedules()[reference(scheduleLine, company.getScheduleCount(), "schedule")];
+        }
+
+        Tour tour;
+        tour.setName(text(name));
+        tour.setCountry(symbol(country));
+        if (startDate.isValid()) {
+            tour.setStartDate(startDate);
+        }
+        if (endDate.isValid()) {
+            tour.setEndDate(endDate);
+        }
+        tour.setHotel(hotel);
+        tour.setTransportCompany(company);
+        tour.setTransportSchedule(selected);
+        return tour;
+    }
+
+    bool firstRoomPrice(Money& price) {
+        in.skip(4);
+        int roomCount = in.intLine();
+        for (int j = 0; j < roomCount; ++j) {
+            in.skip(2);
+            Money roomPrice = money();
+            in.skip(1);
+            if (j == 0) {
+                price = roomPrice;
+            }
+        }
+        return roomCount > 0;
+    }
+
+    QVector<Money> schedulePrices() {
+        in.skip(2);
+        int scheduleCount = in.intLine();
+        QVector<Money> prices;
+        prices.reserve(std::max(0, scheduleCount));
+        for (int j = 0; j < scheduleCount; ++j) {
+            prices.append(schedulePrice());
+        }
+        return prices;
+    }
+
+    Money schedulePrice() {
+        in.skip(4);
+        Money price = money();
+        in.skip(1);
+        return price;
+    }
+
+    static int reference(std::string_view line, int size, const QString& kind) {
+        bool ok;
+        int result = toInt(line, &ok);
+        if (!ok || result < 0 || result >= size) {
+            throw FileException(QString("Invalid %1 reference: '%2'").arg(kind, toQString(line)));
+        }
+        return result;
+    }
+
+private:
+    std::unordered_map<std::string_view, QString> strings_;
+    std::unordered_map<std::string_view, Symbol> symbols_;
+};
+
+void loadToursV2(Parser& parser, DataContainer<Tour>& tours) {
+    int count = parser.in.intLine();
+    tours.clear();
+    tours.getData().reserve(std::max(0, count));
+
+    LoadedCatalog catalog;
+    parser.catalog(catalog);
+
+    for (int i = 0; i < count; ++i) {
+        try {
+            Tour tour = parser.tourRecord(catalog);
+            if (tour.getName().isEmpty() || tour.getCountrySymbol().isEmpty()) {
+                qWarning() << "Skipping tour at index" << i << "- empty name or country";
+                continue;
+            }
+            tours.add(tour);
+        } catch (const FileException& e) {
+            qWarning() << "Error loading tour at index" << i << ":" << e.what();
+        }
+    }
+}
+
+struct SummaryCatalog {
+    QVector<Money> roomPrices;
+    QVector<bool> hasRooms;
+    QVector<QVector<Money>> schedulePrices;
+};
+
+TourSummary catalogTourSummary(Parser& parser, const SummaryCatalog& catalog) {
+    Reader& in = parser.in;
+    std::string_view name = in.trimmedLine();
+    std::string_view country = in.trimmedLine();
+    QDate startDate = toDate(in.trimmedLine());
+    QDate endDate = toDate(in.trimmedLine());
+    std::string_view hotelLine = in.line();
+    std::string_view companyLine = in.line();
+    std::string_view scheduleLine = in.line();
+
+    bool inlineSchedule = trimmed(scheduleLine) == "-1";
+    Money price;
+    if (inlineSchedule) {
+        price = parser.schedulePrice();
+    }
+
+    int hotel = Parser::reference(hotelLine, catalog.roomPrices.size(), "hotel");
+    int company = Parser::reference(companyLine, catalog.schedulePrices.size(), "transport company");
+    if (!inlineSchedule) {
+        const QVector<Money>& prices = catalog.schedulePrices[company];
+        price = prices[Parser::reference(scheduleLine, prices.size(), "schedule")];
+    }
+
+    return {parser.symbol(name), parser.symbol(country),
+            tourCost(price, catalog.hasRooms[hotel], catalog.roomPrices[hotel], startDate, endDate), true};
+}
+
+void loadOrdersV2(Parser& parser, DataContainer<Order>& orders, const std::shared_ptr<OrderDetailSource>& details) {
+    Reader& in = parser.in;
+    int count = in.intLine();
+    orders.clear();
+    orders.getData().reserve(std::max(0, count));
+
+    OrderIdAllocator& allocator = OrderIdAllocator::instance();
+    bool hasStoredIds = parser.orderIdHighWater();
+    int reservedId = hasStoredIds ? 0 : allocator.reserve(count);
+
+    QVector<std::shared_ptr<const Tour>> tours;
+    QVector<TourSummary> summaries;
+    int tourCount = 0;
+    if (details) {
+        SummaryCatalog catalog;
+        int hotelCount = in.intLine();
+        for (int i = 0; i < hotelCount; ++i) {
+            Money price;
+            catalog.hasRooms.append(parser.firstRoomPrice(price));
+            catalog.roomPrices.append(price);
+        }
+        int companyCount = in.intLine();
+        for (int i = 0; i < companyCount; ++i) {
+            catalog.schedulePrices.append(parser.schedulePrices());
+        }
+        tourCount = in.intLine();
+        summaries.reserve(std::max(0, tourCount));
+        for (int i = 0; i < tourCount; ++i) {
+            try {
+                summaries.append(catalogTourSummary(parser, catalog));
+            } catch (const FileException& e) {
+                qWarning() << "Error loading catalog tour at index" << i << ":" << e.what();
+                summaries.append(TourSummary());
+            }
+        }
+    } else {
+        LoadedCatalog catalog;
+        parser.catalog(catalog);
+        tourCount = in.intLine();
+        tours.reserve(std::max(0, tourCount));
+        for (int i = 0; i < tourCount; ++i) {
+            try {
+                tours.append(std::make_shared<const Tour>(parser.tourRecord(catalog)));
+            } catch (const FileException& e) {
+                qWarning() << "Error loading catalog tour at index" << i << ":" << e.what();
+                tours.append(nullptr);
+            }
+        }
+    }
+
+    for (int i = 0; i < count; ++i) {
+        try {
+            int orderId = toInt(in.trimmedLine());
+            if (!hasStoredIds) {
+                orderId = reservedId + i;
+            }
+            std::string_view clientName = in.trimmedLine();
+            std::string_view clientPhone = in.trimmedLine();
+            std::string_view clientEmail = in.trimmedLine();
+            QDate orderDate = toDate(in.trimmedLine());
+            std::string_view tourLine = in.line();
+            OrderStatus status = parser.orderStatus();
+            int tourRef = Parser::reference(tourLine, std::max(0, tourCount), "tour");
+            if (details ? !summaries[tourRef].valid : !tours[tourRef]) {
+                throw FileException(QString("Catalog tour %1 could not be loaded").arg(tourRef));
+            }
+
+            Order order;
+            if (orderId > 0) {
+                allocator.observe(orderId);
+                order.setId(orderId);
+            } else {
+                order.setId(allocator.allocate());
+            }
+            if (details) {
+                const TourSummary& summary = summaries[tourRef];
+                order.setLazyTour(details, tourRef, summary.name, summary.country, summary.cost);
+            } else {
+                order.setTour(tours[tourRef]);
+            }
+            order.setClientName(toQString(clientName));
+            order.setClientPhone(toQString(clientPhone));
+            order.setClientEmail(toQString(clientEmail));
+            order.setOrderDate(QDateTime(orderDate, QTime(0, 0)));
+            order.setStatus(status);
+
+            orders.add(order);
+        } catch (const FileException& e) {
+            qWarning() << "Error loading order at index" << i << ":" << e.what();
+        }
+    }
+}
+
+void seekRecord(Reader& in, const MappedFile& file, const RecordIndex& index,
+                RecordIndex::Section section, int row) {
+    if (row < 0 || row >= index.size(section)) {
+        throw FileException(QString("Record %1 is out of range").arg(row));
+    }
+    const RecordIndex::Entry& entry = index.entry(section, row);
+    if (entry.offset < file.begin() - file.data() || entry.offset + entry.length > file.end() - file.data()) {
+        throw FileException("Record index does not match the data file");
+    }
+    in.seek(file.data() + entry.offset);
+}
+
+void checkHeader(Reader& in, const RecordIndex& index, const QString& kind) {
+    QString header = toQString(in.line());
+    if (header != index.header() || !header.startsWith(kind)) {
+        throw FileException("Record index does not match the data file");
+    }
+}
+
+class IndexedCatalog {
+public:
+    IndexedCatalog(Parser& parser, const MappedFile& file, const RecordIndex& index)
+        : parser_(parser)
+        , file_(file)
+        , index_(index) {}
+
+    int hotelCount() const { return index_.size(RecordIndex::Hotels); }
+    int companyCount() const { return index_.size(RecordIndex::Companies); }
+
+    Hotel hotel(int row) {
+        const char* position = parser_.in.position();
+        seekRecord(parser_.in, file_, index_, RecordIndex::Hotels, row);
+        Hotel result = parser_.hotel();
+        parser_.in.seek(position);
+        return result;
+    }
+
+    TransportCompany company(int row) {
+        const char* position = parser_.in.position();
+        seekRecord(parser_.in, file_, index_, RecordIndex::Companies, row);
+        TransportCompany result = parser_.company();
+        parser_.in.seek(position);
+        return result;
+    }
+
+private:
+    Parser& parser_;
+    const MappedFile& file_;
+    const RecordIndex& index_;
+};
+
+class IndexBuilder {
+public:
+    IndexBuilder(Parser& parser, const MappedFile& file, RecordIndex& index)
+        : in(parser.in)
+        , parser_(parser)
+        , file_(file)
+        , index_(index) {}
+
+    Reader& in;
+
+    static quint64 key(std::string_view name) {
+        return RecordIndex::keyHash(name.data(), static_cast<qsizetype>(name.size()));
+    }
+
+    static quint64 key(std::string_view name, std::string_view country) {
+        quint64 hash = RecordIndex::keyHash("\n", 1, key(name));
+        return RecordIndex::keyHash(country.data(), static_cast<qsizetype>(country.size()), hash);
+    }
+
+    void mark(RecordIndex::Section section, const char* start, quint64 keyHash) {
+        index_.append(section, {start - file_.data(), in.position() - start, keyHash});
+    }
+
+    void catalog() {
+        int hotelCount = in.intLine();
+        index_.reserve(RecordIndex::Hotels, std::max(0, hotelCount));
+        for (int i = 0; i < hotelCount; ++i) {
+            const char* start = in.position();
+            std::string_view name = in.trimmedLine();
+            std::string_view country = in.trimmedLine();
+            in.skip(2);
+            in.skip(4 * std::max(0, in.intLine()));
+            mark(RecordIndex::Hotels, start, key(name, country));
+        }
+
+        int companyCount = in.intLine();
+        index_.reserve(RecordIndex::Companies, std::max(0, companyCount));
+        for (int i = 0; i < companyCount; ++i) {
+            const char* start = in.position();
+            std::string_view name = in.trimmedLine();
+            in.skip(1);
+            in.skip(6 * std::max(0, in.intLine()));
+            mark(RecordIndex::Companies, start, key(name));
+        }
+    }
+
+    void tourRecord(RecordIndex::Section section) {
+        const char* start = in.position();
+        std::string_view name = in.trimmedLine();
+        std::string_view country = in.trimmedLine();
+        in.skip(4);
+        if (trimmed(in.line()) == "-1") {
+            in.skip(6);
+        }
+        mark(section, start, key(name, country));
+    }
+
+    void skipEmbeddedTour() {
+        try {
+            parser_.hotel();
+            parser_.company();
+            parser_.schedule();
+        } catch (const FileException&) {
+        }
+    }
+
+private:
+    Parser& parser_;
+    const MappedFile& file_;
+    RecordIndex& index_;
+};
+
+Tour embeddedTour(Parser& parser, bool skipIncomplete) {
+    Reader& in = parser.in;
+    std::string_view name = in.trimmedLine();
+    std::string_view country = in.trimmedLine();
+    QDate startDate = toDate(in.trimmedLine());
+    QDate endDate = toDate(in.trimmedLine());
+
+    Tour tour;
+    tour.setName(parser.text(name));
+    tour.setCountry(parser.symbol(country));
+    tour.setStartDate(startDate);
+    tour.setEndDate(endDate);
+    if (skipIncomplete && (name.empty() || country.empty())) {
+        return tour;
+    }
+    tour.setHotel(parser.hotel());
+    tour.setTransportCompany(parser.company());
+    tour.setTransportSchedule(parser.schedule());
+    return tour;
+}
+
+}
+
+void MappedFileParser::loadCountries(DataContainer<Country>& countries, const QString& filename) const {
+    MappedFile file(filename);
+    Parser parser(file);
+    parser.in.validateHeader("COUNTRIES");
+
+    int count = parser.in.intLine();
+    if (count <= 0) {
+        qWarning() << "Invalid count in countries file:" << count;
+        return;
+    }
+
+    countries.clear();
+    countries.getData().reserve(count);
+
+    for (int i = 0; i < count; ++i) {
+        std::string_view name = parser.in.line();
+        std::string_view continent = parser.in.line();
+        std::string_view capital = parser.in.line();
+        std::string_view currency = parser.in.line();
+
+        if (name.empty() || continent.empty() || capital.empty() || currency.empty()) {
+            throw FileException(QString("Incomplete data for country at index %1").arg(i));
+        }
+
+        Country country;
+        country.setName(toQString(name));
+        country.setContinent(parser.symbol(continent));
+        country.setCapital(parser.symbol(capital));
+        country.setCurrency(parser.symbol(currency));
+        countries.add(country);
+    }
+}
+
+void MappedFileParser::loadHotels(DataContainer<Hotel>& hotels, const QString& filename) const {
+    MappedFile file(filename);
+    Parser parser(file);
+    Reader& in = parser.in;
+    in.validateHeader("HOTELS");
+
+    int count = in.intLine();
+    hotels.clear();
+    hotels.getData().reserve(std::max(0, count));
+
+    for (int i = 0; i < count; ++i) {
+        Hotel hotel;
+        std::string_view hotelName = in.trimmedLine();
+        if (hotelName.empty()) {
+            qWarning() << "Skipping hotel at index" << i << "- empty name";
+            in.skip(4);
+            continue;
+        }
+
+        std::string_view hotelCountry = in.trimmedLine();
+        if (hotelCountry.empty()) {
+            qWarning() << "Skipping hotel" << toQString(hotelName) << "at index" << i << "- empty country";
+            in.skip(3);
+            continue;
+        }
+
+        bool ok;
+        std::string_view starsStr = in.trimmedLine();
+        int stars = toInt(starsStr, &ok);
+        if (!ok || stars < 1 || stars > 7) {
+            throw FileException(QString("Invalid stars for hotel at index %1: '%2' (expected number 1-7, got '%3'). This usually means the previous hotel has incorrect room count.")
+                .arg(i).arg(toQString(hotelName)).arg(toQString(starsStr)));
+        }
+
+        hotel.setName(parser.text(hotelName));
+        hotel.setCountry(parser.symbol(hotelCountry));
+        hotel.setStars(stars);
+        hotel.setAddress(parser.text(in.trimmedLine()));
+
+        std::string_view roomCountStr = in.trimmedLine();
+        int roomCount = toInt(roomCountStr, &ok);
+        if (!ok || roomCount < 0) {
+            throw FileException(QString("Invalid room count for hotel '%1' (index %2): expected number, got '%3'")
+                .arg(hotel.getName()).arg(i).arg(toQString(roomCountStr)));
+        }
+
+        for (int j = 0; j < roomCount; ++j) {
+            if (in.atEnd()) {
+                throw FileException(QString("Unexpected end of file while reading room %1 for hotel '%2' (index %3)")
+                    .arg(j).arg(hotel.getName()).arg(i));
+            }
+            hotel.addRoom(parser.checkedRoom(hotel.getName(), i, j));
+        }
+
+        hotels.add(hotel);
+    }
+}
+
+void MappedFileParser::loadTransportCompanies(DataContainer<TransportCompany>& companies, const QString& filename) const {
+    MappedFile file(filename);
+    Parser parser(file);
+    parser.in.validateHeader("TRANSPORT_COMPANIES");
+
+    int count = parser.in.intLine();
+    companies.clear();
+    companies.getData().reserve(std::max(0, count));
+
+    for (int i = 0; i < count; ++i) {
+        companies.add(parser.company());
+    }
+}
+
+void MappedFileParser::loadTours(DataContainer<Tour>& tours, const QString& filename) const {
+    MappedFile file(filename);
+    Parser parser(file);
+    Reader& in = parser.in;
+    std::string_view header = in.line();
+    if (header == "TOURS_V2") {
+        loadToursV2(parser, tours);
+        return;
+    }
+    if (header != "TOURS") {
+        throw FileException("Invalid file format");
+    }
+
+    int count = in.intLine();
+    tours.clear();
+    tours.getData().reserve(std::max(0, count));
+
+    for (int i = 0; i < count; ++i) {
+        try {
+            std::string_view name = in.trimmedLine();
+            std::string_view country = in.trimmedLine();
+            QDate startDate = toDate(in.trimmedLine());
+            QDate endDate = toDate(in.trimmedLine());
+
+            if (name.empty() || country.empty()) {
+                qWarning() << "Skipping tour at index" << i << "- empty name or country";
+                continue;
+            }
+
+            Tour tour;
+            tour.setName(parser.text(name));
+            tour.setCountry(parser.symbol(country));
+            if (startDate.isValid()) {
+                tour.setStartDate(startDate);
+            }
+            if (endDate.isValid()) {
+                tour.setEndDate(endDate);
+            }
+
+            tour.setHotel(parser.hotel());
+            tour.setTransportCompany(parser.company());
+            tour.setTransportSchedule(parser.schedule());
+            tours.add(tour);
+        } catch (const FileException& e) {
+            qWarning() << "Error loading tour at index" << i << ":" << e.what();
+        }
+    }
+}
+
+void MappedFileParser::loadOrders(DataContainer<Order>& orders, const QString& filename, bool lazyDetails) const {
+    MappedFile file(filename);
+    Parser parser(file);
+    Reader& in = parser.in;
+    std::string_view header = in.line();
+    if (header != "ORDERS" && header != "ORDERS_V2") {
+        throw FileException("Invalid file format");
+    }
+
+    std::shared_ptr<OrderDetailSource> details;
+    if (lazyDetails) {
+        details = std::make_shared<OrderDetailSource>(filename, toQString(header));
+    }
+    if (header == "ORDERS_V2") {
+        loadOrdersV2(parser, orders, details);
+        return;
+    }
+
+    int count = in.intLine();
+    orders.clear();
+    orders.getData().reserve(std::max(0, count));
+
+    OrderIdAllocator& allocator = OrderIdAllocator::instance();
+    bool hasStoredIds = parser.orderIdHighWater();
+    int reservedId = hasStoredIds ? 0 : allocator.reserve(count);
+
+    for (int i = 0; i < count; ++i) {
+        try {
+            int orderId = hasStoredIds ? toInt(in.trimmedLine()) : reservedId + i;
+            std::string_view clientName = in.trimmedLine();
+            std::string_view clientPhone = in.trimmedLine();
+            std::string_view clientEmail = in.trimmedLine();
+            in.line();
+            QDate orderDate = toDate(in.trimmedLine());
+
+            Order order;
+            if (details) {
+                Symbol tourName = parser.symbol(in.trimmedLine());
+                Symbol tourCountry = parser.symbol(in.trimmedLine());
+                QDate startDate = toDate(in.trimmedLine());
+                QDate endDate = toDate(in.trimmedLine());
+                Money roomPrice;
+                bool hasRoom = parser.firstRoomPrice(roomPrice);
+                parser.schedulePrices();
+                Money price = parser.schedulePrice();
+                order.setLazyTour(details, i, tourName, tourCountry,
+                                  tourCost(price, hasRoom, roomPrice, startDate, endDate));
+            } else {
+                Tour tour;
+                tour.setName(parser.text(in.trimmedLine()));
+                tour.setCountry(parser.symbol(in.trimmedLine()));
+                tour.setStartDate(toDate(in.trimmedLine()));
+                tour.setEndDate(toDate(in.trimmedLine()));
+                tour.setHotel(parser.hotel());
+                tour.setTransportCompany(parser.company());
+                tour.setTransportSchedule(parser.schedule());
+                order.setTour(tour);
+            }
+
+            if (orderId > 0) {
+                allocator.observe(orderId);
+                order.setId(orderId);
+            } else {
+                order.setId(allocator.allocate());
+            }
+            order.setClientName(toQString(clientName));
+            order.setClientPhone(toQString(clientPhone));
+            order.setClientEmail(toQString(clientEmail));
+            order.setOrderDate(QDateTime(orderDate, QTime(0, 0)));
+            order.setStatus(parser.orderStatus());
+
+            orders.add(order);
+        } catch (const FileException& e) {
+            qWarning() << "Error loading order at index" << i << ":" << e.what();
+        }
+    }
+}
+
+RecordIndex MappedFileParser::buildIndex(const QString& filename) const {
+    MappedFile file(filename);
+    Parser parser(file);
+    RecordIndex index;
+    IndexBuilder builder(parser, file, index);
+    Reader& in = parser.in;
+
+    QString header = toQString(in.line());
+    index.setHeader(header);
+    int count = in.intLine();
+
+    if (header == "TOURS" || header == "TOURS_V2") {
+        bool normalized = header == "TOURS_V2";
+        if (normalized) {
+            builder.catalog();
+        }
+        index.reserve(RecordIndex::Records, std::max(0, count));
+        for (int i = 0; i < count; ++i) {
+            if (normalized) {
+                builder.tourRecord(RecordIndex::Records);
+                continue;
+            }
+            const char* start = in.position();
+            std::string_view name = in.trimmedLine();
+            std::string_view country = in.trimmedLine();
+            in.skip(2);
+            if (!name.empty() && !country.empty()) {
+                builder.skipEmbeddedTour();
+            }
+            builder.mark(RecordIndex::Records, start, IndexBuilder::key(name, country));
+        }
+    } else if (header == "ORDERS" || header == "ORDERS_V2") {
+        bool normalized = header == "ORDERS_V2";
+        bool hasStoredIds = parser.orderIdHighWater(false);
+        index.setHasStoredIds(hasStoredIds);
+        if (normalized) {
+            builder.catalog();
+            int tourCount = in.intLine();
+            index.reserve(RecordIndex::Tours, std::max(0, tourCount));
+            for (int i = 0; i < tourCount; ++i) {
+                builder.tourRecord(RecordIndex::Tours);
+            }
+        }
+        index.reserve(RecordIndex::Records, std::max(0, count));
+        for (int i = 0; i < count; ++i) {
+            const char* start = in.position();
+            int orderId = hasStoredIds ? toInt(in.trimmedLine()) : 0;
+            if (normalized) {
+                in.skip(5);
+                parser.orderStatus();
+            } else {
+                in.skip(9);
+                try {
+                    parser.hotel();
+                    parser.company();
+                    parser.schedule();
+                    parser.orderStatus();
+                } catch (const FileException&) {
+                }
+            }
+            builder.mark(RecordIndex::Records, start, RecordIndex::orderKey(orderId));
+        }
+    } else {
+        throw FileException("Invalid file format");
+    }
+
+    index.stamp(filename);
+    return index;
+}
+
+Tour MappedFileParser::readTour(const QString& filename, const RecordIndex& index, int row) const {
+    MappedFile file(filename);
+    Parser parser(file);
+    checkHeader(parser.in, index, "TOURS");
+    seekRecord(parser.in, file, index, RecordIndex::Records, row);
+
+    Tour tour;
+    if (index.header() == "TOURS_V2") {
+        IndexedCatalog catalog(parser, file, index);
+        tour = parser.tourRecord(catalog);
+    } else {
+        tour = embeddedTour(parser, true);
+    }
+
+    if (RecordIndex::tourKey(tour) != index.entry(RecordIndex::Records, row).keyHash) {
+        throw FileException(QString("Record index is out of date at tour %1").arg(row));
+    }
+    return tour;
+}
+
+Order MappedFileParser::readOrder(const QString& filename, const RecordIndex& index, int row) const {
+    MappedFile file(filename);
+    Parser parser(file);
+    Reader& in = parser.in;
+    checkHeader(in, index, "ORDERS");
+    seekRecord(in, file, index, RecordIndex::Records, row);
+
+    int orderId = index.hasStoredIds() ? toInt(in.trimmedLine()) : 0;
+    std::string_view clientName = in.trimmedLine();
+    std::string_view clientPhone = in.trimmedLine();
+    std::string_view clientEmail = in.trimmedLine();
+
+    Tour tour;
+    QDate orderDate;
+    OrderStatus status;
+    if (index.header() == "ORDERS_V2") {
+        orderDate = toDate(in.trimmedLine());
+        std::string_view tourLine = in.line();
+        status = parser.orderStatus();
+        seekRecord(in, file, index, RecordIndex::Tours,
+                   Parser::reference(tourLine, index.size(RecordIndex::Tours), "tour"));
+        IndexedCatalog catalog(parser, file, index);
+        tour = parser.tourRecord(catalog);
+    } else {
+        in.line();
+        orderDate = toDate(in.trimmedLine());
+        tour = embeddedTour(parser, false);
+        status = parser.orderStatus();
+    }
+
+    if (RecordIndex::orderKey(orderId) != index.entry(RecordIndex::Records, row).keyHash) {
+        throw FileException(QString("Record index is out of date at order %1").arg(row));
+    }
+
+    Order order;
+    order.setId(orderId);
+    order.setTour(tour);
+    order.setClientName(toQString(clientName));
+    order.setClientPhone(toQString(clientPhone));
+    order.setClientEmail(toQString(clientEmail));
+    order.setOrderDate(QDateTime(orderDate, QTime(0, 0)));
+    order.setStatus(status);
+    return order;
+}
+
+Tour MappedFileParser::readCatalogTour(const QString& filename, const RecordIndex& index, int row) const {
+    MappedFile file(filename);
+    Parser parser(file);
+    checkHeader(parser.in, index, "ORDERS");
+    seekRecord(parser.in, file, index, RecordIndex::Tours, row);
+
+    IndexedCatalog catalog(parser, file, index);
+    Tour tour = parser.tourRecord(catalog);
+    if (RecordIndex::tourKey(tour) != index.entry(RecordIndex::Tours, row).keyHash) {
+        throw FileException(QString("Record index is out of date at catalog tour %1").arg(row));
+    }
+    return tour;
+}
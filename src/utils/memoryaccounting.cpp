@@ -0,0 +1,266 @@
+#include "utils/memoryaccounting.h"
+#include "utils/symboltable.h"
+#include <QHash>
+#include <QJsonArray>
+#include <QSet>
+#include <QTextStream>
+#include <algorithm>
+
+namespace {
+
+class MemoryWalker {
+public:
+    struct Content {
+        int buffers = 0;
+        int references = 0;
+        qint64 bufferBytes = 0;
+    };
+
+    qint64 logical = 0;
+    qint64 physical = 0;
+    MemoryAccounting::StringStats strings;
+    QHash<QString, Content> contents;
+
+    void string(const QString& text) {
+        if (text.isNull()) {
+            return;
+        }
+
+        qint64 bytes = static_cast<qint64>(sizeof(QArrayData)) + (text.capacity() + 1) * qint64(sizeof(QChar));
+        logical += bytes;
+        ++strings.references;
+        strings.logicalBytes += bytes;
+
+        Content& content = contents[text];
+        ++content.references;
+        content.bufferBytes = bytes;
+
+        if (!text.data_ptr().d_ptr() || !firstSighting(text.constData())) {
+            return;
+        }
+        physical += bytes;
+        ++strings.buffers;
+        strings.physicalBytes += bytes;
+        if (++content.buffers > 1) {
+            ++strings.duplicateBuffers;
+            strings.duplicateBytes += bytes;
+        }
+    }
+
+    template<typename T>
+    void vector(const QVector<T>& values) {
+        if (values.capacity() == 0) {
+            return;
+        }
+        qint64 bytes = static_cast<qint64>(sizeof(QArrayData)) + values.capacity() * qint64(sizeof(T));
+        logical += bytes;
+        if (firstSighting(values.constData())) {
+            physical += bytes;
+        }
+    }
+
+    void country(const Country& value) {
+        string(value.getName());
+    }
+
+    void room(const Room& value) {
+        string(value.getName());
+    }
+
+    void hotel(const Hotel& value) {
+        string(value.getName());
+        string(value.getAddress());
+        const QVector<Room> rooms = value.getRooms();
+        vector(rooms);
+        for (const Room& item : rooms) {
+            room(item);
+        }
+    }
+
+    void company(const TransportCompany& value) {
+        string(value.getName());
+        vector(value.getSchedules());
+    }
+
+    void tour(const Tour& value) {
+        string(value.getName());
+        hotel(value.getHotel());
+        company(value.getTransportCompany());
+    }
+
+    void order(const Order& value) {
+        std::shared_ptr<const Tour> shared = value.getSharedTour();
+        if (shared) {
+            logical += sizeof(Tour);
+            if (firstSighting(shared.get())) {
+                physical += sizeof(Tour);
+            }
+            tour(*shared);
+        }
+        string(value.getClientName());
+        string(value.getClientPhone());
+        string(value.getClientEmail());
+    }
+
+    template<typename T, typename Visit>
+    MemoryAccounting::EntityStats container(const QString& type, const DataContainer<T>& values, Visit visit) {
+        qint64 logicalBefore = logical;
+        qint64 physicalBefore = physical;
+
+        MemoryAccounting::EntityStats stats;
+        stats.type = type;
+        stats.count = values.size();
+        stats.containerBytes = values.getData().capacity() * qint64(sizeof(T));
+        for (const T& value : values.getData()) {
+            visit(value);
+        }
+        stats.deepBytes = stats.containerBytes + logical - logicalBefore;
+        stats.ownedBytes = stats.containerBytes + physical - physicalBefore;
+        return stats;
+    }
+
+private:
+    bool firstSighting(const void* buffer) {
+        int before = seen_.size();
+        seen_.insert(buffer);
+        return seen_.size() != before;
+    }
+
+    QSet<const void*> seen_;
+};
+
+}
+
+MemoryAccounting::Report MemoryAccounting::measure(const DataContainer<Country>& countries,
+                                                   const DataContainer<Hotel>& hotels,
+                                                   const DataContainer<TransportCompany>& companies,
+                                                   const DataContainer<Tour>& tours,
+                                                   const DataContainer<Order>& orders,
+                                                   int topCount) {
+    MemoryWalker walker;
+    Report report;
+    report.entities.append(walker.container("Country", countries, [&](const Country& value) { walker.country(value); }));
+    report.entities.append(walker.container("Hotel", hotels, [&](const Hotel& value) { walker.hotel(value); }));
+    report.entities.append(walker.container("TransportCompany", companies,
+                                            [&](const TransportCompany& value) { walker.company(value); }));
+    report.entities.append(walker.container("Tour", tours, [&](const Tour& value) { walker.tour(value); }));
+    report.entities.append(walker.container("Order", orders, [&](const Order& value) { walker.order(value); }));
+    report.strings = walker.strings;
+
+    for (auto it = walker.contents.cbegin(); it != walker.contents.cend(); ++it) {
+        if (it.value().buffers < 2) {
+            continue;
+        }
+        Offender offender;
+        offender.text = it.key();
+        offender.buffers = it.value().buffers;
+        offender.references = it.value().references;
+        offender.wastedBytes = (it.value().buffers - 1) * it.value().bufferBytes;
+        report.offenders.append(offender);
+    }
+    std::sort(report.offenders.begin(), report.offenders.end(), [](const Offender& lhs, const Offender& rhs) {
+        return lhs.wastedBytes != rhs.wastedBytes ? lhs.wastedBytes > rhs.wastedBytes : lhs.text < rhs.text;
+    });
+    if (report.offenders.size() > topCount) {
+        report.offenders.resize(std::max(0, topCount));
+    }
+
+    SymbolTable& symbols = SymbolTable::instance();
+    report.symbols = symbols.size();
+    report.symbolTableBytes = symbols.memoryUsage();
+
+    for (const EntityStats& stats : report.entities) {
+        report.totalBytes += stats.ownedBytes;
+    }
+    report.totalBytes += report.symbolTableBytes;
+    return report;
+}
+
+QString MemoryAccounting::formatBytes(qint64 bytes) {
+    if (bytes < 1024) {
+        return QString("%1 B").arg(bytes);
+    }
+    if (bytes < 1024 * 1024) {
+        return QString("%1 KiB").arg(bytes / 1024.0, 0, 'f', 1);
+    }
+    return QString("%1 MiB").arg(bytes / (1024.0 * 1024.0), 0, 'f', 1);
+}
+
+QString MemoryAccounting::toText(const Report& report) {
+    QString text;
+    QTextStream out(&text);
+
+    out << QString("%1 %2 %3 %4 %5 %6\n")
+               .arg("type", -18).arg("count", 9).arg("container", 12)
+               .arg("deep", 12).arg("owned", 12).arg("per entity", 12);
+    for (const EntityStats& stats : report.entities) {
+        out << QString("%1 %2 %3 %4 %5 %6\n")
+                   .arg(stats.type, -18).arg(stats.count, 9)
+                   .arg(formatBytes(stats.containerBytes), 12).arg(formatBytes(stats.deepBytes), 12)
+                   .arg(formatBytes(stats.ownedBytes), 12).arg(formatBytes(stats.bytesPerEntity()), 12);
+    }
+
+    const StringStats& strings = report.strings;
+    out << "\nstrings: " << strings.references << " references, " << formatBytes(strings.logicalBytes)
+        << " if unshared\n"
+        << "  physical buffers: " << strings.buffers << " (" << formatBytes(strings.physicalBytes) << ")\n"
+        << "  saved by implicit sharing: " << formatBytes(strings.logicalBytes - strings.physicalBytes) << "\n"
+        << "  duplicated content: " << strings.duplicateBuffers << " buffers ("
+        << formatBytes(strings.duplicateBytes) << ")\n";
+
+    if (!report.offenders.isEmpty()) {
+        out << "\ntop duplicated strings:\n";
+        for (const Offender& offender : report.offenders) {
+            QString shown = offender.text.size() > 40 ? offender.text.left(37) + "..." : offender.text;
+            out << QString("  %1 %2 copies %3 refs  \"%4\"\n")
+                       .arg(formatBytes(offender.wastedBytes), 10).arg(offender.buffers, 7)
+                       .arg(offender.references, 8).arg(shown);
+        }
+    }
+
+    out << "\nsymbol table: " << report.symbols << " symbols, " << formatBytes(report.symbolTableBytes) << "\n"
+        << "total: " << formatBytes(report.totalBytes) << "\n";
+    out.flush();
+    return text;
+}
+
+QJsonObject MemoryAccounting::toJson(const Report& report) {
+    QJsonArray entities;
+    for (const EntityStats& stats : report.entities) {
+        QJsonObject object;
+        object["type"] = stats.type;
+        object["count"] = stats.count;
+        object["container_bytes"] = stats.containerBytes;
+        object["deep_bytes"] = stats.deepBytes;
+        object["owned_bytes"] = stats.ownedBytes;
+        object["bytes_per_entity"] = stats.bytesPerEntity();
+        entities.append(object);
+    }
+
+    QJsonObject strings;
+    strings["references"] = report.strings.references;
+    strings["logical_bytes"] = report.strings.logicalBytes;
+    strings["buffers"] = report.strings.buffers;
+    strings["physical_bytes"] = report.strings.physicalBytes;
+    strings["duplicate_buffers"] = report.strings.duplicateBuffers;
+    strings["duplicate_bytes"] = report.strings.duplicateBytes;
+
+    QJsonArray offenders;
+    for (const Offender& offender : report.offenders) {
+        QJsonObject object;
+        object["text"] = offender.text;
+        object["buffers"] = offender.buffers;
+        object["references"] = offender.references;
+        object["wasted_bytes"] = offender.wastedBytes;
+        offenders.append(object);
+    }
+
+    QJsonObject root;
+    root["entities"] = entities;
+    root["strings"] = strings;
+    root["offenders"] = offenders;
+    root["symbols"] = report.symbols;
+    root["symbol_table_bytes"] = report.symbolTableBytes;
+    root["total_bytes"] = report.totalBytes;
+    return root;
+}
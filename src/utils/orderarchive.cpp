@@ -0,0 +1,360 @@
+#include "utils/orderarchive.h"
+#include "utils/filemanager.h"
+#include "utils/jsonserializer.h"
+#include "utils/recordindex.h"
+#include "utils/tracer.h"
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QPair>
+#include <QSaveFile>
+#include <QSet>
+#include <algorithm>
+
+bool OrderArchive::Block::overlaps(const QDate& first, const QDate& last) const {
+    if (!firstDate.isValid() || !lastDate.isValid()) {
+        return !first.isValid() && !last.isValid();
+    }
+    return (!first.isValid() || lastDate >= first) && (!last.isValid() || firstDate <= last);
+}
+
+OrderArchive::OrderArchive(const QString& dataPath)
+    : path_(dataPath.isEmpty() ? QString() : pathIn(dataPath))
+{
+}
+
+QString OrderArchive::pathIn(const QString& dataPath) {
+    return QDir(dataPath + "/archive").absoluteFilePath("orders.arc");
+}
+
+bool OrderArchive::existsIn(const QString& dataPath) {
+    return QFile::exists(pathIn(dataPath));
+}
+
+bool OrderArchive::isArchivable(const Order& order, const QDate& before) {
+    return OrderStatusInfo::isFinal(order.getStatus()) &&
+           (!before.isValid() || order.getOrderDate().date() < before);
+}
+
+void OrderArchive::open() {
+    TRACE_SCOPE("OrderArchive::open", "io");
+    blocks_.clear();
+    live_.clear();
+    archiveSize_ = 0;
+    if (!QFile::exists(path_)) {
+        return;
+    }
+
+    if (!loadIndex()) {
+        scan();
+        saveIndex();
+    }
+    rebuildLive();
+}
+
+bool OrderArchive::loadIndex() {
+    QFile file(RecordIndex::pathFor(path_));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint64 archiveSize = 0;
+    qint32 count = 0;
+    in >> magic >> version >> archiveSize >> count;
+    if (in.status() != QDataStream::Ok || magic != Magic || version != FormatVersion ||
+        archiveSize != QFileInfo(path_).size() || count < 0) {
+        return false;
+    }
+
+    QVector<Block> blocks(count);
+    for (Block& block : blocks) {
+        in >> block.offset >> block.length >> block.tombstone >> block.firstDate >> block.lastDate >> block.ids;
+    }
+    if (in.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    blocks_ = std::move(blocks);
+    archiveSize_ = archiveSize;
+    return true;
+}
+
+void OrderArchive::saveIndex() const {
+    QSaveFile file(RecordIndex::pathFor(path_));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Cannot write archive index:" << file.fileName();
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << Magic << FormatVersion << archiveSize_ << static_cast<qint32>(blocks_.size());
+    for (const Block& block : blocks_) {
+        out << block.offset << block.length << block.tombstone << block.firstDate << block.lastDate << block.ids;
+    }
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        qWarning() << "Cannot write archive index:" << file.fileName();
+    }
+}
+
+void OrderArchive::scan() {
+    QFile file(path_);
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw FileException(QString("Cannot open file for reading: %1").arg(path_));
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (in.status() != QDataStream::Ok || magic != Magic || version != FormatVersion) {
+        throw FileException(QString("Invalid archive format: %1").arg(path_));
+    }
+    archiveSize_ = file.pos();
+
+    while (!in.atEnd()) {
+        Block block;
+        block.offset = file.pos();
+        quint32 blockMagic = 0;
+        quint32 blockVersion = 0;
+        quint32 payloadSize = 0;
+        in >> blockMagic >> blockVersion >> block.tombstone >> block.firstDate >> block.lastDate
+           >> block.ids >> payloadSize;
+        if (in.status() != QDataStream::Ok || blockMagic != BlockMagic || blockVersion != FormatVersion) {
+            break;
+        }
+        if (payloadSize != 0xFFFFFFFF && in.skipRawData(payloadSize) != static_cast<int>(payloadSize)) {
+            break;
+        }
+        block.length = file.pos() - block.offset;
+        blocks_.append(block);
+        archiveSize_ = file.pos();
+    }
+
+    if (archiveSize_ < file.size()) {
+        qWarning() << "Discarding incomplete archive block at offset" << archiveSize_ << "in" << path_;
+        file.close();
+        if (!QFile::resize(path_, archiveSize_)) {
+            throw FileException(QString("Cannot truncate archive: %1").arg(path_));
+        }
+    }
+}
+
+void OrderArchive::rebuildLive() {
+    live_.clear();
+    for (int row = 0; row < blocks_.size(); ++row) {
+        for (qint32 orderId : blocks_[row].ids) {
+            if (blocks_[row].tombstone) {
+                live_.remove(orderId);
+            } else {
+                live_.insert(orderId, row);
+            }
+        }
+    }
+}
+
+void OrderArchive::writeBlock(Block block, const QByteArray& payload) {
+    QDir().mkpath(QFileInfo(path_).absolutePath());
+    QFile file(path_);
+    if (!file.open(QIODevice::ReadWrite)) {
+        throw FileException(QString("Cannot open file for writing: %1").arg(path_));
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    if (archiveSize_ == 0) {
+        file.resize(0);
+        out << Magic << FormatVersion;
+    } else if (file.size() != archiveSize_) {
+        throw FileException(QString("Archive was modified by another process: %1").arg(path_));
+    }
+    file.seek(file.size());
+
+    block.offset = file.pos();
+    out << BlockMagic << FormatVersion << block.tombstone << block.firstDate << block.lastDate
+        << block.ids << payload;
+    if (out.status() != QDataStream::Ok || !file.flush()) {
+        file.resize(block.offset);
+        throw FileException(QString("Error writing to file: %1").arg(path_));
+    }
+    block.length = file.pos() - block.offset;
+    archiveSize_ = file.pos();
+    file.close();
+
+    blocks_.append(block);
+    rebuildLive();
+    saveIndex();
+}
+
+int OrderArchive::append(const DataContainer<Order>& orders) {
+    TRACE_SCOPE("OrderArchive::append", "io");
+    const QVector<Order>& data = orders.getData();
+    QVector<QPair<Block, QByteArray>> pending;
+    for (int start = 0; start < data.size(); start += OrdersPerBlock) {
+        int end = std::min<int>(data.size(), start + OrdersPerBlock);
+        Block block;
+        QJsonArray array;
+        for (int i = start; i < end; ++i) {
+            const Order& order = data[i];
+            QDate date = order.getOrderDate().date();
+            if (date.isValid() && (!block.firstDate.isValid() || date < block.firstDate)) {
+                block.firstDate = date;
+            }
+            if (date.isValid() && (!block.lastDate.isValid() || date > block.lastDate)) {
+                block.lastDate = date;
+            }
+            block.ids.append(order.getId());
+            array.append(JsonSerializer::orderToJson(order));
+        }
+
+        QJsonObject root;
+        root["version"] = JsonSerializer::FormatVersion;
+        root["orders"] = array;
+        pending.append(qMakePair(block, qCompress(JsonSerializer::encode(root, true))));
+    }
+
+    for (const auto& entry : pending) {
+        writeBlock(entry.first, entry.second);
+    }
+    return data.size();
+}
+
+int OrderArchive::archive(DataContainer<Order>& orders, const QDate& before) {
+    DataContainer<Order> moved;
+    DataContainer<Order> kept;
+    for (const auto& order : orders.getData()) {
+        if (isArchivable(order, before)) {
+            moved.add(order);
+        } else {
+            kept.add(order);
+        }
+    }
+    if (moved.isEmpty()) {
+        return 0;
+    }
+
+    append(moved);
+    orders = std::move(kept);
+    return moved.size();
+}
+
+DataContainer<Order> OrderArchive::readBlock(int row) const {
+    const Block& block = blocks_[row];
+    QFile file(path_);
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(block.offset)) {
+        throw FileException(QString("Cannot open file for reading: %1").arg(path_));
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 blockMagic = 0;
+    quint32 blockVersion = 0;
+    bool tombstone = false;
+    QDate firstDate;
+    QDate lastDate;
+    QVector<qint32> ids;
+    QByteArray payload;
+    in >> blockMagic >> blockVersion >> tombstone >> firstDate >> lastDate >> ids >> payload;
+    if (in.status() != QDataStream::Ok || blockMagic != BlockMagic || ids != block.ids) {
+        throw FileException(QString("Corrupt archive block at offset %1 in %2").arg(block.offset).arg(path_));
+    }
+
+    QByteArray data = qUncompress(payload);
+    if (data.isEmpty()) {
+        throw FileException(QString("Cannot decompress archive block at offset %1 in %2")
+            .arg(block.offset).arg(path_));
+    }
+
+    QJsonObject root = JsonSerializer::decode(data, true);
+    DataContainer<Order> orders;
+    for (const QJsonValue& value : root["orders"].toArray()) {
+        orders.add(JsonSerializer::orderFromJson(value.toObject()));
+    }
+    return orders;
+}
+
+DataContainer<Order> OrderArchive::search(const Query& query) const {
+    TRACE_SCOPE("OrderArchive::search", "io");
+    QVector<int> rows;
+    if (query.id > 0) {
+        if (live_.contains(query.id)) {
+            rows.append(live_.value(query.id));
+        }
+    } else {
+        for (int row = 0; row < blocks_.size(); ++row) {
+            if (!blocks_[row].tombstone && blocks_[row].overlaps(query.since, query.until)) {
+                rows.append(row);
+            }
+        }
+    }
+
+    DataContainer<Order> result;
+    for (int row : rows) {
+        for (const auto& order : readBlock(row).getData()) {
+            QDate date = order.getOrderDate().date();
+            if (live_.value(order.getId(), -1) != row || (query.id > 0 && order.getId() != query.id)) {
+                continue;
+            }
+            if ((query.since.isValid() || query.until.isValid()) &&
+                (!date.isValid() || (query.since.isValid() && date < query.since) ||
+                 (query.until.isValid() && date > query.until))) {
+                continue;
+            }
+            if (!query.text.isEmpty() &&
+                !order.getClientName().contains(query.text, Qt::CaseInsensitive) &&
+                !order.getClientPhone().contains(query.text, Qt::CaseInsensitive) &&
+                !order.getClientEmail().contains(query.text, Qt::CaseInsensitive) &&
+                !order.getTourName().contains(query.text, Qt::CaseInsensitive)) {
+                continue;
+            }
+            result.add(order);
+        }
+    }
+    return result;
+}
+
+int OrderArchive::restore(const QVector<int>& orderIds, DataContainer<Order>& orders) {
+    TRACE_SCOPE("OrderArchive::restore", "io");
+    QSet<int> hot;
+    for (const auto& order : orders.getData()) {
+        hot.insert(order.getId());
+    }
+
+    QHash<int, QSet<int>> wanted;
+    Block tombstone;
+    tombstone.tombstone = true;
+    for (int orderId : orderIds) {
+        if (live_.contains(orderId) && !tombstone.ids.contains(orderId)) {
+            wanted[live_.value(orderId)].insert(orderId);
+            tombstone.ids.append(orderId);
+        }
+    }
+    if (tombstone.ids.isEmpty()) {
+        return 0;
+    }
+
+    DataContainer<Order> restored;
+    for (auto it = wanted.cbegin(); it != wanted.cend(); ++it) {
+        for (const auto& order : readBlock(it.key()).getData()) {
+            if (it.value().contains(order.getId()) && !hot.contains(order.getId())) {
+                restored.add(order);
+                hot.insert(order.getId());
+            }
+        }
+    }
+
+    writeBlock(tombstone, QByteArray());
+    orders.getData().reserve(orders.size() + restored.size());
+    for (const auto& order : restored.getData()) {
+        orders.add(order);
+    }
+    return restored.size();
+}
@@ -0,0 +1,80 @@
+#include "utils/orderdetailsource.h"
+#include "utils/filemanager.h"
+#include "utils/mappedfileparser.h"
+#include "utils/tracer.h"
+#include <QDateTime>
+#include <QFileInfo>
+
+OrderDetailSource::OrderDetailSource(const QString& filename, const QString& header)
+    : filename_(QFileInfo(filename).absoluteFilePath())
+    , normalized_(header == "ORDERS_V2")
+{
+    QFileInfo info(filename_);
+    sourceSize_ = info.size();
+    sourceModified_ = info.lastModified().toMSecsSinceEpoch();
+}
+
+void OrderDetailSource::openIndex() const {
+    QFileInfo info(filename_);
+    if (info.size() != sourceSize_ || info.lastModified().toMSecsSinceEpoch() != sourceModified_) {
+        throw FileException(QString("File has changed since it was loaded: %1").arg(filename_));
+    }
+
+    RecordIndex index;
+    if (!index.load(RecordIndex::pathFor(filename_)) || !index.matches(filename_)) {
+        index = MappedFileParser().buildIndex(filename_);
+    }
+    index_ = index;
+    indexed_ = true;
+}
+
+std::shared_ptr<const Tour> OrderDetailSource::tour(int row) const {
+    TRACE_SCOPE("OrderDetailSource::tour", "io");
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (remapped_) {
+        int mapped = rows_.value(row, -1);
+        if (mapped < 0) {
+            throw FileException(QString("Order details for row %1 are no longer available in %2")
+                .arg(row).arg(filename_));
+        }
+        row = mapped;
+    }
+
+    auto cached = tours_.constFind(row);
+    if (cached != tours_.cend()) {
+        return cached.value();
+    }
+
+    if (!indexed_) {
+        openIndex();
+    }
+    if (!index_.matches(filename_)) {
+        throw FileException(QString("File has changed since it was loaded: %1").arg(filename_));
+    }
+
+    MappedFileParser parser;
+    auto result = normalized_
+        ? std::make_shared<const Tour>(parser.readCatalogTour(filename_, index_, row))
+        : std::make_shared<const Tour>(parser.readOrder(filename_, index_, row).getTour());
+    tours_.insert(row, result);
+    return result;
+}
+
+void OrderDetailSource::rebind(const RecordIndex& index, const QHash<int, int>& rows) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    normalized_ = index.header() == "ORDERS_V2";
+    index_ = index;
+    indexed_ = true;
+    rows_ = rows;
+    remapped_ = true;
+    tours_.clear();
+}
+
+void OrderDetailSource::refresh(const RecordIndex& index) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    index_ = index;
+    indexed_ = true;
+    if (!normalized_) {
+        tours_.clear();
+    }
+}
@@ -0,0 +1,24 @@
+#include "utils/orderidallocator.h"
+
+OrderIdAllocator& OrderIdAllocator::instance() {
+    static OrderIdAllocator allocator;
+    return allocator;
+}
+
+int OrderIdAllocator::allocate() {
+    return next_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+int OrderIdAllocator::reserve(int count) {
+    if (count <= 0) {
+        return peekNext();
+    }
+    return next_.fetch_add(count, std::memory_order_acq_rel);
+}
+
+void OrderIdAllocator::observe(int id) {
+    int current = next_.load(std::memory_order_acquire);
+    while (current <= id &&
+           !next_.compare_exchange_weak(current, id + 1, std::memory_order_acq_rel)) {
+    }
+}
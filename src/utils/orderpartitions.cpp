@@ -0,0 +1,311 @@
+#include "utils/orderpartitions.h"
+#include "utils/blockchecksums.h"
+#include "utils/filemanager.h"
+#include "utils/recordindex.h"
+#include "utils/tracer.h"
+#include <QDir>
+#include <QFile>
+#include <QMap>
+#include <QSaveFile>
+#include <QSet>
+#include <QStringConverter>
+#include <QTextStream>
+#include <algorithm>
+#include <numeric>
+
+bool OrderPartitions::Partition::overlaps(const QDate& first, const QDate& last) const {
+    if (!firstDate.isValid() || !lastDate.isValid()) {
+        return !first.isValid() && !last.isValid();
+    }
+    return (!first.isValid() || lastDate >= first) && (!last.isValid() || firstDate <= last);
+}
+
+OrderPartitions::OrderPartitions(const QString& dataPath)
+    : directory_(dataPath.isEmpty() ? QString() : directoryIn(dataPath))
+{
+}
+
+QString OrderPartitions::directoryIn(const QString& dataPath) {
+    return QDir(dataPath + "/orders").absolutePath();
+}
+
+bool OrderPartitions::existIn(const QString& dataPath) {
+    return QFile::exists(directoryIn(dataPath) + "/partitions.txt");
+}
+
+QString OrderPartitions::fileNameFor(int year) {
+    return year > 0 ? QString("orders_%1.txt").arg(year) : QString("orders_undated.txt");
+}
+
+int OrderPartitions::yearOf(const Order& order) {
+    QDate date = order.getOrderDate().date();
+    return date.isValid() ? date.year() : 0;
+}
+
+bool OrderPartitions::isOpen(const Order& order) {
+    return !OrderStatusInfo::isFinal(order.getStatus());
+}
+
+QString OrderPartitions::catalogPath() const {
+    return directory_ + "/partitions.txt";
+}
+
+QString OrderPartitions::filePath(const Partition& partition) const {
+    return directory_ + "/" + partition.fileName;
+}
+
+QString OrderPartitions::filePathFor(const Order& order) const {
+    int row = find(yearOf(order));
+    return row >= 0 ? filePath(partitions_[row]) : QString();
+}
+
+QStringList OrderPartitions::sourceFiles() const {
+    QStringList files{catalogPath()};
+    for (const Partition& partition : partitions_) {
+        files.append(filePath(partition));
+    }
+    return files;
+}
+
+int OrderPartitions::loadedCount() const {
+    return std::count_if(partitions_.cbegin(), partitions_.cend(),
+                         [](const Partition& partition) { return partition.loaded; });
+}
+
+int OrderPartitions::find(int year) const {
+    for (int row = 0; row < partitions_.size(); ++row) {
+        if (partitions_[row].year == year) {
+            return row;
+        }
+    }
+    return -1;
+}
+
+bool OrderPartitions::readCatalog() {
+    partitions_.clear();
+    QFile file(catalogPath());
+    if (!file.exists()) {
+        return false;
+    }
+    BlockChecksums::Report report = BlockChecksums::verify(catalogPath());
+    if (report.isCorrupt()) {
+        throw FileException(report.describe());
+    }
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        throw FileException(QString("Cannot open file for reading: %1").arg(catalogPath()));
+    }
+
+    QTextStream in(&file);
+    in.setEncoding(QStringConverter::Encoding::Utf8);
+    if (in.readLine() != "ORDER_PARTITIONS") {
+        throw FileException(QString("Invalid partition catalog: %1").arg(catalogPath()));
+    }
+
+    int count = in.readLine().toInt();
+    partitions_.reserve(std::max(0, count));
+    for (int i = 0; i < count; ++i) {
+        Partition partition;
+        partition.year = in.readLine().trimmed().toInt();
+        partition.fileName = in.readLine().trimmed();
+        partition.orderCount = in.readLine().trimmed().toInt();
+        partition.openCount = in.readLine().trimmed().toInt();
+        partition.firstDate = QDate::fromString(in.readLine().trimmed(), Qt::ISODate);
+        partition.lastDate = QDate::fromString(in.readLine().trimmed(), Qt::ISODate);
+        if (partition.fileName.isEmpty() || partition.fileName.contains('/')) {
+            throw FileException(QString("Invalid partition %1 in %2").arg(i).arg(catalogPath()));
+        }
+        partitions_.append(partition);
+    }
+    return true;
+}
+
+void OrderPartitions::writeCatalog() const {
+    QSaveFile file(catalogPath());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        throw FileException(QString("Cannot open file for writing: %1").arg(catalogPath()));
+    }
+
+    QTextStream out(&file);
+    out.setEncoding(QStringConverter::Encoding::Utf8);
+    out << "ORDER_PARTITIONS\n";
+    out << partitions_.size() << "\n";
+    for (const Partition& partition : partitions_) {
+        out << partition.year << "\n";
+        out << partition.fileName << "\n";
+        out << partition.orderCount << "\n";
+        out << partition.openCount << "\n";
+        out << partition.firstDate.toString(Qt::ISODate) << "\n";
+        out << partition.lastDate.toString(Qt::ISODate) << "\n";
+    }
+    out.flush();
+    if (!file.commit()) {
+        throw FileException(QString("Cannot write file: %1").arg(catalogPath()));
+    }
+    BlockChecksums::seal(catalogPath());
+}
+
+QVector<int> OrderPartitions::prune(const QDate& first, const QDate& last) const {
+    QVector<int> rows;
+    for (int row = 0; row < partitions_.size(); ++row) {
+        if (partitions_[row].overlaps(first, last)) {
+            rows.append(row);
+        }
+    }
+    return rows;
+}
+
+QVector<int> OrderPartitions::recent(int years, const QDate& today) const {
+    int firstYear = today.year() - std::max(1, years) + 1;
+    QVector<int> rows;
+    for (int row = 0; row < partitions_.size(); ++row) {
+        if (partitions_[row].year >= firstYear || partitions_[row].openCount > 0) {
+            rows.append(row);
+        }
+    }
+    return rows;
+}
+
+int OrderPartitions::load(const FileManager& fileManager, DataContainer<Order>& orders, const QVector<int>& rows) {
+    TRACE_SCOPE("OrderPartitions::load", "io");
+    int added = 0;
+    for (int row : rows) {
+        Partition& partition = partitions_[row];
+        if (partition.loaded) {
+            continue;
+        }
+
+        DataContainer<Order> loaded;
+        fileManager.loadOrders(loaded, filePath(partition));
+        orders.getData().reserve(orders.size() + loaded.size());
+        for (const auto& order : loaded.getData()) {
+            orders.add(order);
+        }
+        partition.loaded = true;
+        added += loaded.size();
+    }
+    return added;
+}
+
+int OrderPartitions::loadRange(const FileManager& fileManager, DataContainer<Order>& orders,
+                               const QDate& first, const QDate& last) {
+    return load(fileManager, orders, prune(first, last));
+}
+
+int OrderPartitions::loadRecent(const FileManager& fileManager, DataContainer<Order>& orders, int years) {
+    return load(fileManager, orders, recent(years));
+}
+
+int OrderPartitions::loadAll(const FileManager& fileManager, DataContainer<Order>& orders) {
+    QVector<int> rows(partitions_.size());
+    std::iota(rows.begin(), rows.end(), 0);
+    return load(fileManager, orders, rows);
+}
+
+void OrderPartitions::markLoaded(const DataContainer<Order>& orders) {
+    QSet<int> years;
+    for (const auto& order : orders.getData()) {
+        years.insert(yearOf(order));
+    }
+    for (Partition& partition : partitions_) {
+        partition.loaded = years.contains(partition.year);
+    }
+}
+
+void OrderPartitions::markAllLoaded() {
+    for (Partition& partition : partitions_) {
+        partition.loaded = true;
+    }
+}
+
+void OrderPartitions::summarize(Partition& partition, const DataContainer<Order>& orders) {
+    partition.orderCount = orders.size();
+    partition.openCount = 0;
+    partition.firstDate = QDate();
+    partition.lastDate = QDate();
+    for (const auto& order : orders.getData()) {
+        if (isOpen(order)) {
+            ++partition.openCount;
+        }
+        QDate date = order.getOrderDate().date();
+        if (!date.isValid()) {
+            continue;
+        }
+        if (!partition.firstDate.isValid() || date < partition.firstDate) {
+            partition.firstDate = date;
+        }
+        if (!partition.lastDate.isValid() || date > partition.lastDate) {
+            partition.lastDate = date;
+        }
+    }
+}
+
+void OrderPartitions::save(const FileManager& fileManager, const DataContainer<Order>& orders) {
+    TRACE_SCOPE("OrderPartitions::save", "io");
+    if (!QDir().mkpath(directory_)) {
+        throw FileException(QString("Cannot create directory: %1").arg(directory_));
+    }
+
+    QMap<int, DataContainer<Order>> groups;
+    for (const auto& order : orders.getData()) {
+        groups[yearOf(order)].add(order);
+    }
+
+    for (auto it = groups.begin(); it != groups.end(); ++it) {
+        int row = find(it.key());
+        if (row < 0) {
+            Partition partition;
+            partition.year = it.key();
+            partition.fileName = fileNameFor(it.key());
+            partition.loaded = true;
+            partitions_.append(partition);
+            row = partitions_.size() - 1;
+        }
+
+        DataContainer<Order>& group = it.value();
+        if (!partitions_[row].loaded) {
+            QSet<int> ids;
+            for (const auto& order : group.getData()) {
+                ids.insert(order.getId());
+            }
+            DataContainer<Order> stored;
+            fileManager.loadOrders(stored, filePath(partitions_[row]));
+            DataContainer<Order> merged;
+            merged.getData().reserve(stored.size() + group.size());
+            for (const auto& order : stored.getData()) {
+                if (!ids.contains(order.getId())) {
+                    merged.add(order);
+                }
+            }
+            for (const auto& order : group.getData()) {
+                merged.add(order);
+            }
+            group = std::move(merged);
+        }
+
+        fileManager.saveOrders(group, filePath(partitions_[row]));
+        summarize(partitions_[row], group);
+    }
+
+    for (int row = partitions_.size() - 1; row >= 0; --row) {
+        const Partition& partition = partitions_[row];
+        if (partition.loaded && !groups.contains(partition.year)) {
+            QFile::remove(filePath(partition));
+            QFile::remove(RecordIndex::pathFor(filePath(partition)));
+            QFile::remove(BlockChecksums::pathFor(filePath(partition)));
+            partitions_.removeAt(row);
+        }
+    }
+
+    std::sort(partitions_.begin(), partitions_.end(), [](const Partition& a, const Partition& b) {
+        return a.year < b.year;
+    });
+    writeCatalog();
+}
+
+void OrderPartitions::orderClosed(const Order& order) {
+    int row = find(yearOf(order));
+    if (row >= 0 && partitions_[row].openCount > 0) {
+        --partitions_[row].openCount;
+        writeCatalog();
+    }
+}
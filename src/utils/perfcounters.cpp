@@ -0,0 +1,102 @@
+#include "utils/perfcounters.h"
+#include <QtAlgorithms>
+
+PerfCounters& PerfCounters::instance() {
+    static PerfCounters counters;
+    return counters;
+}
+
+QString PerfCounters::metricName(Metric metric) {
+    switch (metric) {
+    case LoadCountries: return "Загрузка стран";
+    case LoadHotels: return "Загрузка отелей";
+    case LoadTransport: return "Загрузка транспорта";
+    case LoadTours: return "Загрузка туров";
+    case LoadOrders: return "Загрузка заказов";
+    case LinkTours: return "Связывание туров";
+    case LinkOrders: return "Связывание заказов";
+    case TableRefresh: return "Обновление таблицы";
+    case Filter: return "Фильтрация";
+    case MetricCount: break;
+    }
+    return QString();
+}
+
+int PerfCounters::bucketFor(qint64 nanoseconds) {
+    if (nanoseconds < SubBuckets) {
+        return nanoseconds > 0 ? static_cast<int>(nanoseconds) : 0;
+    }
+    quint64 value = static_cast<quint64>(nanoseconds);
+    int msb = 63 - qCountLeadingZeroBits(value);
+    int fraction = static_cast<int>((value >> (msb - 2)) & (SubBuckets - 1));
+    return msb * SubBuckets + fraction;
+}
+
+qint64 PerfCounters::bucketMidpoint(int bucket) {
+    int msb = bucket / SubBuckets;
+    int fraction = bucket % SubBuckets;
+    if (msb < 2) {
+        return bucket;
+    }
+    qint64 lower = static_cast<qint64>(SubBuckets + fraction) << (msb - 2);
+    qint64 width = qint64(1) << (msb - 2);
+    return lower + width / 2;
+}
+
+void PerfCounters::record(Metric metric, qint64 nanoseconds) {
+    if (metric < 0 || metric >= MetricCount) {
+        return;
+    }
+    Slot& slot = slots_[metric];
+    slot.lastNs.store(nanoseconds, std::memory_order_relaxed);
+    slot.buckets[bucketFor(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+}
+
+PerfCounters::Snapshot PerfCounters::snapshot(Metric metric) const {
+    Snapshot result;
+    if (metric < 0 || metric >= MetricCount) {
+        return result;
+    }
+
+    const Slot& slot = slots_[metric];
+    result.lastNs = slot.lastNs.load(std::memory_order_relaxed);
+
+    std::array<quint32, BucketCount> buckets;
+    qint64 total = 0;
+    for (int i = 0; i < BucketCount; ++i) {
+        buckets[i] = slot.buckets[i].load(std::memory_order_relaxed);
+        total += buckets[i];
+    }
+    result.count = total;
+    if (total == 0) {
+        return result;
+    }
+
+    qint64 p50Rank = (total * 50 + 99) / 100;
+    qint64 p99Rank = (total * 99 + 99) / 100;
+    qint64 seen = 0;
+    for (int i = 0; i < BucketCount; ++i) {
+        if (buckets[i] == 0) {
+            continue;
+        }
+        qint64 before = seen;
+        seen += buckets[i];
+        if (before < p50Rank && seen >= p50Rank) {
+            result.p50Ns = bucketMidpoint(i);
+        }
+        if (before < p99Rank && seen >= p99Rank) {
+            result.p99Ns = bucketMidpoint(i);
+            break;
+        }
+    }
+    return result;
+}
+
+void PerfCounters::reset() {
+    for (Slot& slot : slots_) {
+        slot.lastNs.store(0, std::memory_order_relaxed);
+        for (auto& bucket : slot.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,132 @@
+#include "utils/recordindex.h"
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <algorithm>
+
+QString RecordIndex::pathFor(const QString& dataFile) {
+    return dataFile + ".idx";
+}
+
+quint64 RecordIndex::keyHash(const char* data, qsizetype size, quint64 seed) {
+    quint64 hash = seed;
+    for (qsizetype i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+quint64 RecordIndex::keyHash(const QString& key) {
+    QByteArray utf8 = key.toUtf8();
+    return keyHash(utf8.constData(), utf8.size());
+}
+
+quint64 RecordIndex::tourKey(const Tour& tour) {
+    return keyHash(tour.getName() + '\n' + tour.getCountry());
+}
+
+quint64 RecordIndex::orderKey(int orderId) {
+    return keyHash(reinterpret_cast<const char*>(&orderId), sizeof(orderId));
+}
+
+int RecordIndex::find(Section section, quint64 keyHash, int from) const {
+    const QVector<Entry>& entries = sections_[section];
+    for (int row = std::max(0, from); row < entries.size(); ++row) {
+        if (entries[row].keyHash == keyHash) {
+            return row;
+        }
+    }
+    return -1;
+}
+
+void RecordIndex::resize(Section section, int row, qint64 length) {
+    Entry& changed = sections_[section][row];
+    qint64 delta = length - changed.length;
+    qint64 offset = changed.offset;
+    changed.length = length;
+    if (delta == 0) {
+        return;
+    }
+
+    for (QVector<Entry>& entries : sections_) {
+        for (Entry& entry : entries) {
+            if (entry.offset > offset) {
+                entry.offset += delta;
+            }
+        }
+    }
+}
+
+void RecordIndex::stamp(const QString& dataFile) {
+    QFileInfo info(dataFile);
+    sourceSize_ = info.exists() ? info.size() : -1;
+    sourceModified_ = info.exists() ? info.lastModified().toMSecsSinceEpoch() : 0;
+}
+
+bool RecordIndex::matches(const QString& dataFile) const {
+    QFileInfo info(dataFile);
+    return info.exists() && info.size() == sourceSize_ &&
+           info.lastModified().toMSecsSinceEpoch() == sourceModified_;
+}
+
+bool RecordIndex::load(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (in.status() != QDataStream::Ok || magic != Magic || version != FormatVersion) {
+        return false;
+    }
+
+    RecordIndex loaded;
+    in >> loaded.header_ >> loaded.hasStoredIds_ >> loaded.sourceSize_ >> loaded.sourceModified_;
+    for (QVector<Entry>& entries : loaded.sections_) {
+        qint32 count = 0;
+        in >> count;
+        if (in.status() != QDataStream::Ok || count < 0) {
+            return false;
+        }
+        entries.resize(count);
+        for (Entry& entry : entries) {
+            in >> entry.offset >> entry.length >> entry.keyHash;
+        }
+    }
+    if (in.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    *this = std::move(loaded);
+    return true;
+}
+
+bool RecordIndex::save(const QString& path) const {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << Magic << FormatVersion;
+    out << header_ << hasStoredIds_ << sourceSize_ << sourceModified_;
+    for (const QVector<Entry>& entries : sections_) {
+        out << static_cast<qint32>(entries.size());
+        for (const Entry& entry : entries) {
+            out << entry.offset << entry.length << entry.keyHash;
+        }
+    }
+    if (out.status() != QDataStream::Ok) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
@@ -0,0 +1,187 @@
+#include "utils/routeplanner.h"
+#include <QStringList>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+QString Route::toString() const {
+    if (legs.isEmpty()) {
+        return QString();
+    }
+
+    QStringList cities;
+    cities.append(legs.first().from.toString());
+    for (const RouteLeg& leg : legs) {
+        cities.append(leg.to.toString());
+    }
+    return cities.join(" → ");
+}
+
+void RoutePlanner::rebuild(const DataContainer<TransportCompany>& companies) {
+    clear();
+
+    int companyIndex = 0;
+    for (const auto& company : companies.getData()) {
+        const QVector<TransportSchedule> schedules = company.getSchedules();
+        for (int i = 0; i < schedules.size(); ++i) {
+            const TransportSchedule& schedule = schedules[i];
+            if (!schedule.departureDate.isValid() || schedule.departureCity.isEmpty() ||
+                schedule.arrivalCity.isEmpty() || schedule.departureCity == schedule.arrivalCity) {
+                continue;
+            }
+
+            Edge edge;
+            edge.from = schedule.departureCity.id();
+            edge.to = schedule.arrivalCity.id();
+            edge.departure = schedule.departureDate.toJulianDay();
+            edge.arrival = schedule.arrivalDate.isValid()
+                ? std::max(edge.departure, schedule.arrivalDate.toJulianDay()) : edge.departure;
+            edge.price = schedule.price.kopecks();
+            edge.companyIndex = companyIndex;
+            edge.scheduleIndex = i;
+
+            outgoing_[edge.from].append(edges_.size());
+            edges_.append(edge);
+        }
+        ++companyIndex;
+    }
+
+    for (auto it = outgoing_.begin(); it != outgoing_.end(); ++it) {
+        std::sort(it.value().begin(), it.value().end(), [this](int lhs, int rhs) {
+            return edges_[lhs].departure < edges_[rhs].departure;
+        });
+    }
+}
+
+void RoutePlanner::clear() {
+    edges_.clear();
+    outgoing_.clear();
+}
+
+QVector<Symbol> RoutePlanner::departureCities() const {
+    QVector<Symbol> cities;
+    cities.reserve(outgoing_.size());
+    for (auto it = outgoing_.cbegin(); it != outgoing_.cend(); ++it) {
+        cities.append(Symbol::fromId(it.key()));
+    }
+    std::sort(cities.begin(), cities.end(), [](Symbol lhs, Symbol rhs) {
+        return lhs.toString() < rhs.toString();
+    });
+    return cities;
+}
+
+bool RoutePlanner::isDominated(const QVector<Label>& labels, const QVector<int>& bag,
+                               const Label& candidate) const {
+    for (int index : bag) {
+        const Label& existing = labels[index];
+        if (existing.legs <= candidate.legs && existing.cost <= candidate.cost &&
+            existing.arrival <= candidate.arrival) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Route RoutePlanner::buildRoute(const QVector<Label>& labels, int last) const {
+    Route route;
+    for (int index = last; index >= 0 && labels[index].edge >= 0; index = labels[index].parent) {
+        const Edge& edge = edges_[labels[index].edge];
+        RouteLeg leg;
+        leg.companyIndex = edge.companyIndex;
+        leg.scheduleIndex = edge.scheduleIndex;
+        leg.from = Symbol::fromId(edge.from);
+        leg.to = Symbol::fromId(edge.to);
+        leg.departure = QDate::fromJulianDay(edge.departure);
+        leg.arrival = QDate::fromJulianDay(edge.arrival);
+        leg.price = Money(edge.price);
+        route.legs.prepend(leg);
+    }
+    route.totalPrice = Money(labels[last].cost);
+    return route;
+}
+
+Route RoutePlanner::findRoute(const RouteRequest& request) const {
+    if (request.origin.isEmpty() || request.destinations.isEmpty() || edges_.isEmpty()) {
+        return Route();
+    }
+
+    QSet<quint32> destinations;
+    for (Symbol city : request.destinations) {
+        destinations.insert(city.id());
+    }
+
+    qint64 earliest = request.earliestDeparture.isValid()
+        ? request.earliestDeparture.toJulianDay() : std::numeric_limits<qint64>::min();
+    qint64 latest = request.latestArrival.isValid()
+        ? request.latestArrival.toJulianDay() : std::numeric_limits<qint64>::max();
+    int maxLegs = std::max(0, request.maxTransfers) + 1;
+    qint64 layover = std::max(0, request.minLayoverDays);
+    bool cheapest = request.criterion == RouteCriterion::Cheapest;
+
+    using QueueEntry = std::pair<std::pair<qint64, qint64>, int>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+    QVector<Label> labels;
+    QHash<quint32, QVector<int>> bags;
+
+    auto push = [&](const Label& label) {
+        labels.append(label);
+        int index = labels.size() - 1;
+        bags[label.city].append(index);
+        queue.push({cheapest ? std::make_pair(label.cost, label.arrival)
+                             : std::make_pair(label.arrival, label.cost), index});
+    };
+
+    Label start;
+    start.city = request.origin.id();
+    start.arrival = earliest;
+    push(start);
+
+    while (!queue.empty()) {
+        int current = queue.top().second;
+        queue.pop();
+        Label label = labels[current];
+
+        if (label.legs > 0 && destinations.contains(label.city)) {
+            return buildRoute(labels, current);
+        }
+        if (label.legs >= maxLegs) {
+            continue;
+        }
+
+        auto outgoing = outgoing_.constFind(label.city);
+        if (outgoing == outgoing_.cend()) {
+            continue;
+        }
+
+        qint64 bound = label.legs == 0 ? earliest : label.arrival + layover;
+        const QVector<int>& candidates = outgoing.value();
+        auto it = std::lower_bound(candidates.cbegin(), candidates.cend(), bound,
+            [this](int edgeIndex, qint64 day) { return edges_[edgeIndex].departure < day; });
+
+        for (; it != candidates.cend(); ++it) {
+            const Edge& edge = edges_[*it];
+            if (edge.departure > latest) {
+                break;
+            }
+            if (edge.arrival > latest || edge.to == request.origin.id()) {
+                continue;
+            }
+
+            Label next;
+            next.city = edge.to;
+            next.arrival = edge.arrival;
+            next.cost = label.cost + edge.price;
+            next.legs = label.legs + 1;
+            next.edge = *it;
+            next.parent = current;
+
+            if (!isDominated(labels, bags.value(next.city), next)) {
+                push(next);
+            }
+        }
+    }
+
+    return Route();
+}
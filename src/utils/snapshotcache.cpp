@@ -0,0 +1,148 @@
+#include "utils/snapshotcache.h"
+#include "utils/jsonserializer.h"
+#include "utils/filemanager.h"
+#include "utils/orderpartitions.h"
+#include "utils/tracer.h"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+SnapshotCache::SnapshotCache(const QString& cachePath, const QStringList& sourceFiles)
+    : cachePath_(cachePath)
+    , sourceFiles_(sourceFiles)
+{
+}
+
+QString SnapshotCache::defaultCachePath(const QString& dataPath) {
+    QString directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (directory.isEmpty()) {
+        directory = QDir::tempPath();
+    }
+    QByteArray key = QCryptographicHash::hash(QDir(dataPath).absolutePath().toUtf8(),
+                                              QCryptographicHash::Sha1).toHex().left(16);
+    return directory + "/snapshot-" + QString::fromLatin1(key) + ".bin";
+}
+
+QStringList SnapshotCache::sourceFilesIn(const QString& dataPath) {
+    QStringList files = {
+        dataPath + "/countries.txt",
+        dataPath + "/hotels.txt",
+        dataPath + "/transport_companies.txt",
+        dataPath + "/tours.txt",
+        dataPath + "/orders.txt"
+    };
+    OrderPartitions partitions(dataPath);
+    try {
+        if (partitions.readCatalog()) {
+            files += partitions.sourceFiles();
+        }
+    } catch (const FileException&) {
+        files += partitions.catalogPath();
+    }
+    return files;
+}
+
+QByteArray SnapshotCache::fingerprint() const {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArray::number(FormatVersion));
+    hash.addData(QByteArray::number(JsonSerializer::FormatVersion));
+    for (const QString& source : sourceFiles_) {
+        QFileInfo info(source);
+        hash.addData(info.absoluteFilePath().toUtf8());
+        if (!info.exists()) {
+            hash.addData("missing");
+            continue;
+        }
+        hash.addData(QByteArray::number(info.size()));
+        hash.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+    }
+    return hash.result();
+}
+
+bool SnapshotCache::load(DataContainer<Country>& countries,
+                         DataContainer<Hotel>& hotels,
+                         DataContainer<TransportCompany>& companies,
+                         DataContainer<Tour>& tours,
+                         DataContainer<Order>& orders) const {
+    TRACE_SCOPE("SnapshotCache::load", "io");
+    QFile file(cachePath_);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    QByteArray storedFingerprint;
+    QByteArray payload;
+    in >> magic >> version >> storedFingerprint;
+    if (in.status() != QDataStream::Ok || magic != Magic || version != FormatVersion ||
+        storedFingerprint != fingerprint()) {
+        return false;
+    }
+    in >> payload;
+    if (in.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    DataContainer<Country> loadedCountries;
+    DataContainer<Hotel> loadedHotels;
+    DataContainer<TransportCompany> loadedCompanies;
+    DataContainer<Tour> loadedTours;
+    DataContainer<Order> loadedOrders;
+    try {
+        JsonSerializer::fromJson(JsonSerializer::decode(payload, true), loadedCountries, loadedHotels,
+                                 loadedCompanies, loadedTours, loadedOrders);
+    } catch (const FileException&) {
+        return false;
+    }
+
+    countries = std::move(loadedCountries);
+    hotels = std::move(loadedHotels);
+    companies = std::move(loadedCompanies);
+    tours = std::move(loadedTours);
+    orders = std::move(loadedOrders);
+    return true;
+}
+
+bool SnapshotCache::save(const QByteArray& fingerprint,
+                         const DataContainer<Country>& countries,
+                         const DataContainer<Hotel>& hotels,
+                         const DataContainer<TransportCompany>& companies,
+                         const DataContainer<Tour>& tours,
+                         const DataContainer<Order>& orders) const {
+    TRACE_SCOPE("SnapshotCache::save", "io");
+    QByteArray payload;
+    try {
+        payload = JsonSerializer::encode(JsonSerializer::toJson(countries, hotels, companies, tours, orders), true);
+    } catch (const FileException& e) {
+        qWarning() << "Cannot write snapshot:" << e.what();
+        return false;
+    }
+
+    QDir().mkpath(QFileInfo(cachePath_).absolutePath());
+    QSaveFile file(cachePath_);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << Magic << FormatVersion << fingerprint << payload;
+    if (out.status() != QDataStream::Ok) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+void SnapshotCache::remove() const {
+    QFile::remove(cachePath_);
+}
@@ -0,0 +1,89 @@
+#include "utils/symboltable.h"
+#include <QReadLocker>
+#include <QWriteLocker>
+
+Symbol::Symbol(const QString& text)
+    : id_(SymbolTable::instance().intern(text)) {
+}
+
+Symbol Symbol::fromId(quint32 id) {
+    Symbol symbol;
+    symbol.id_ = id;
+    return symbol;
+}
+
+Symbol Symbol::find(const QString& text) {
+    return fromId(SymbolTable::instance().lookup(text));
+}
+
+QString Symbol::toString() const {
+    return SymbolTable::instance().text(id_);
+}
+
+SymbolTable::SymbolTable() {
+    strings_.append(QString());
+}
+
+SymbolTable& SymbolTable::instance() {
+    static SymbolTable table;
+    return table;
+}
+
+quint32 SymbolTable::intern(const QString& text) {
+    if (text.isEmpty()) {
+        return 0;
+    }
+    
+    {
+        QReadLocker locker(&lock_);
+        auto it = ids_.constFind(text);
+        if (it != ids_.constEnd()) {
+            return it.value();
+        }
+    }
+    
+    QWriteLocker locker(&lock_);
+    auto it = ids_.constFind(text);
+    if (it != ids_.constEnd()) {
+        return it.value();
+    }
+    
+    quint32 id = static_cast<quint32>(strings_.size());
+    strings_.append(text);
+    ids_.insert(text, id);
+    return id;
+}
+
+quint32 SymbolTable::lookup(const QString& text) const {
+    if (text.isEmpty()) {
+        return 0;
+    }
+    
+    QReadLocker locker(&lock_);
+    return ids_.value(text, 0);
+}
+
+QString SymbolTable::text(quint32 id) const {
+    QReadLocker locker(&lock_);
+    if (id < static_cast<quint32>(strings_.size())) {
+        return strings_[static_cast<int>(id)];
+    }
+    return QString();
+}
+
+int SymbolTable::size() const {
+    QReadLocker locker(&lock_);
+    return strings_.size();
+}
+
+qint64 SymbolTable::memoryUsage() const {
+    QReadLocker locker(&lock_);
+    qint64 bytes = strings_.capacity() * qint64(sizeof(QString));
+    for (const QString& text : strings_) {
+        if (!text.isNull()) {
+            bytes += qint64(sizeof(QArrayData)) + (text.capacity() + 1) * qint64(sizeof(QChar));
+        }
+    }
+    bytes += ids_.capacity() * qint64(sizeof(QString) + sizeof(quint32) + sizeof(void*));
+    return bytes;
+}
@@ -0,0 +1,235 @@
+#include "utils/tourlinker.h"
+#include "utils/perfcounters.h"
+#include "utils/tracer.h"
+#include <QHash>
+#include <QPair>
+
+TourLinker::TourLinker(DataContainer<Country>* countries,
+                       DataContainer<Hotel>* hotels,
+                       DataContainer<TransportCompany>* companies,
+                       DataContainer<Tour>* tours,
+                       DataContainer<Order>* orders)
+    : countries_(countries)
+    , hotels_(hotels)
+    , companies_(companies)
+    , tours_(tours)
+    , orders_(orders)
+{
+}
+
+QString TourLinker::findCountryCapital(const QString& countryName) const {
+    for (const auto& country : countries_->getData()) {
+        if (country.getName() == countryName) {
+            return country.getCapital();
+        }
+    }
+    return "";
+}
+
+QSet<Symbol> TourLinker::collectTargetCities(const QString& tourCountry, const QString& capital) const {
+    QSet<Symbol> targetCities;
+    
+    if (!capital.isEmpty()) {
+        targetCities.insert(Symbol(capital));
+    }
+    
+    Symbol countrySymbol(tourCountry);
+    for (const auto& hotel : hotels_->getData()) {
+        if (hotel.getCountrySymbol() != countrySymbol || hotel.getRoomCount() == 0) {
+            continue;
+        }
+        
+        QString address = hotel.getAddress();
+        if (address.isEmpty()) {
+            continue;
+        }
+        
+        QString city = address.split(',').first().trimmed();
+        if (!city.isEmpty()) {
+            targetCities.insert(Symbol(city));
+        }
+    }
+    
+    return targetCities;
+}
+
+Hotel* TourLinker::findHotelForTour(const QString& tourCountry) {
+    Symbol countrySymbol(tourCountry);
+    for (auto& hotel : hotels_->getData()) {
+        if (hotel.getCountrySymbol() == countrySymbol && hotel.getRoomCount() > 0) {
+            return &hotel;
+        }
+    }
+    return nullptr;
+}
+
+bool TourLinker::matchesCity(Symbol arrivalCity, const CountryTargets& targets,
+                             const QString& tourCountry) const {
+    if (targets.cities.contains(arrivalCity)) {
+        return true;
+    }
+    
+    QString arrivalCityLower = arrivalCity.toString().toLower();
+    
+    for (const QString& targetCityLower : targets.loweredCities) {
+        if (arrivalCityLower == targetCityLower ||
+            arrivalCityLower.contains(targetCityLower) ||
+            targetCityLower.contains(arrivalCityLower)) {
+            return true;
+        }
+    }
+    
+    if (tourCountry == "ОАЭ") {
+        if (arrivalCityLower.contains("дубай") || arrivalCityLower.contains("абу-даби") || 
+            arrivalCityLower.contains("abu dhabi") || arrivalCityLower.contains("dubai")) {
+            return true;
+        }
+    }
+    
+    for (Symbol similar : cityIndex_.similarTo(arrivalCity)) {
+        if (targets.cities.contains(similar)) {
+            return true;
+        }
+    }
+    
+    return FuzzyMatcher::matchesNormalized(cityIndex_.normalized(arrivalCity), targets.normalizedCapital);
+}
+
+bool TourLinker::findTransportForTour(Tour& tour, const CountryTargets& targets, const QDate& tourStartDate) {
+    if (!tourStartDate.isValid()) {
+        for (auto& company : companies_->getData()) {
+            for (int i = 0; i < company.getScheduleCount(); ++i) {
+                TransportSchedule* schedule = company.getSchedule(i);
+                if (schedule && matchesCity(schedule->arrivalCity, targets, tour.getCountry())) {
+                    tour.setTransportCompany(company);
+                    tour.setTransportSchedule(*schedule);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+    
+    TransportCompany* company = nullptr;
+    TransportSchedule* schedule = nullptr;
+    ScheduleRef found = scheduleIndex_.findDepartureBefore(tourStartDate, [&](const ScheduleRef& ref) {
+        company = companies_->get(ref.companyIndex);
+        schedule = company ? company->getSchedule(ref.scheduleIndex) : nullptr;
+        return schedule && matchesCity(schedule->arrivalCity, targets, tour.getCountry());
+    });
+    if (found.companyIndex < 0) {
+        return false;
+    }
+    
+    tour.setTransportCompany(*company);
+    tour.setTransportSchedule(*schedule);
+    return true;
+}
+
+void TourLinker::buildCityIndex(FuzzyIndex& index,
+                                const DataContainer<Country>* countries,
+                                const DataContainer<Hotel>* hotels,
+                                const DataContainer<TransportCompany>* companies) {
+    index.clear();
+    
+    if (companies) {
+        for (const auto& company : companies->getData()) {
+            for (const auto& schedule : company.getSchedules()) {
+                index.add(schedule.arrivalCity);
+            }
+        }
+    }
+    
+    if (hotels) {
+        for (const auto& hotel : hotels->getData()) {
+            QString address = hotel.getAddress();
+            if (!address.isEmpty()) {
+                index.add(Symbol(address.split(',').first().trimmed()));
+            }
+        }
+    }
+    
+    if (countries) {
+        for (const auto& country : countries->getData()) {
+            if (!country.getCapital().isEmpty()) {
+                index.add(Symbol(country.getCapital()));
+            }
+        }
+    }
+}
+
+TourLinker::Result TourLinker::linkTours() {
+    TRACE_SCOPE("TourLinker::linkTours", "link");
+    PerfTimer perfTimer(PerfCounters::LinkTours);
+    Result result;
+    if (!countries_ || !hotels_ || !companies_ || !tours_) {
+        return result;
+    }
+    
+    scheduleIndex_.rebuild(*companies_);
+    buildCityIndex(cityIndex_, countries_, hotels_, companies_);
+    
+    QHash<quint32, CountryTargets> targetsByCountry;
+    for (auto& tour : tours_->getData()) {
+        QString tourCountry = tour.getCountry();
+        QDate tourStartDate = tour.getStartDate();
+        
+        auto targets = targetsByCountry.find(tour.getCountrySymbol().id());
+        if (targets == targetsByCountry.end()) {
+            CountryTargets computed;
+            computed.capital = findCountryCapital(tourCountry);
+            if (!computed.capital.isEmpty()) {
+                computed.normalizedCapital = cityIndex_.normalized(Symbol(computed.capital));
+            }
+            computed.cities = collectTargetCities(tourCountry, computed.capital);
+            for (const Symbol& city : computed.cities) {
+                computed.loweredCities.append(city.toString().toLower());
+            }
+            computed.hotel = findHotelForTour(tourCountry);
+            targets = targetsByCountry.insert(tour.getCountrySymbol().id(), computed);
+        }
+        Hotel* selectedHotel = targets->hotel;
+        if (selectedHotel) {
+            tour.setHotel(*selectedHotel);
+            ++result.withHotel;
+        }
+        
+        if (findTransportForTour(tour, *targets, tourStartDate)) {
+            ++result.withTransport;
+        }
+        ++result.tours;
+    }
+    TRACE_COUNTER("linkedTours", result.withTransport);
+    return result;
+}
+
+TourLinker::Result TourLinker::linkOrders() {
+    TRACE_SCOPE("TourLinker::linkOrders", "link");
+    PerfTimer perfTimer(PerfCounters::LinkOrders);
+    Result result;
+    if (!tours_ || !orders_) {
+        return result;
+    }
+    
+    QHash<QPair<QString, quint32>, int> tourByKey;
+    const QVector<Tour>& tours = tours_->getData();
+    for (int i = tours.size() - 1; i >= 0; --i) {
+        tourByKey.insert(qMakePair(tours[i].getName(), tours[i].getCountrySymbol().id()), i);
+    }
+    
+    QVector<std::shared_ptr<const Tour>> sharedTours(tours.size());
+    for (auto& order : orders_->getData()) {
+        auto match = tourByKey.constFind(qMakePair(order.getTourName(), order.getTourCountrySymbol().id()));
+        if (match != tourByKey.cend()) {
+            std::shared_ptr<const Tour>& shared = sharedTours[match.value()];
+            if (!shared) {
+                shared = std::make_shared<const Tour>(tours[match.value()]);
+            }
+            order.setTour(shared);
+            ++result.ordersLinked;
+        }
+        ++result.orders;
+    }
+    TRACE_COUNTER("linkedOrders", result.ordersLinked);
+    return result;
+}
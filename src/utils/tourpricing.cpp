@@ -0,0 +1,44 @@
+#include "utils/tourpricing.h"
+
+double TourPricing::starMultiplier(int stars) {
+    switch (stars) {
+        case 5: return 1.5;
+        case 4: return 1.2;
+        case 3: return 1.0;
+        case 2: return 0.8;
+        case 1: return 0.6;
+        default: return 1.0;
+    }
+}
+
+double TourPricing::countryMultiplier(const QString& country) {
+    if (country.contains("Франция") || country.contains("Италия") || 
+        country.contains("Испания")) {
+        return 1.1;
+    }
+    if (country.contains("Египет") || country.contains("Турция")) {
+        return 0.9;
+    }
+    return 1.0;
+}
+
+Money TourPricing::hotelCost(const Hotel& hotel, int roomIndex, int nights) {
+    if (nights <= 0) {
+        return Money();
+    }
+    
+    const Room* room = hotel.getRoom(roomIndex);
+    if (!room) {
+        return Money();
+    }
+    return (room->getPricePerNight() * nights).scaled(starMultiplier(hotel.getStars()));
+}
+
+Money TourPricing::totalCost(const Money& transportCost, const Money& hotelCost, const QString& country) {
+    return (transportCost + hotelCost).scaled(countryMultiplier(country));
+}
+
+Money TourPricing::quote(const Tour& tour, int roomIndex) {
+    Money hotel = hotelCost(tour.getHotel(), roomIndex, tour.getDuration());
+    return totalCost(tour.getTransportSchedule().price, hotel, tour.getCountry());
+}
@@ -0,0 +1,126 @@
+#include "utils/tracer.h"
+#include <QCoreApplication>
+#include <QFile>
+
+Tracer& Tracer::instance() {
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::Tracer() {
+    clock_.start();
+}
+
+void Tracer::setEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+quint32 Tracer::currentThread() {
+    static std::atomic<quint32> nextThread{1};
+    thread_local quint32 thread = nextThread.fetch_add(1, std::memory_order_relaxed);
+    return thread;
+}
+
+bool Tracer::append(const Event& event) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (events_.size() >= MaxEvents) {
+        ++dropped_;
+        return false;
+    }
+    events_.append(event);
+    return true;
+}
+
+void Tracer::recordZone(const char* name, const char* category, qint64 startNs, qint64 durationNs) {
+    Event event;
+    event.name = name;
+    event.category = category;
+    event.timestampNs = startNs;
+    event.value = durationNs;
+    event.thread = currentThread();
+    event.type = EventType::Zone;
+    append(event);
+}
+
+void Tracer::recordCounter(const char* name, qint64 value) {
+    Event event;
+    event.name = name;
+    event.category = "counter";
+    event.timestampNs = nowNs();
+    event.value = value;
+    event.thread = currentThread();
+    event.type = EventType::Counter;
+    append(event);
+}
+
+void Tracer::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.clear();
+    dropped_ = 0;
+}
+
+int Tracer::eventCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return events_.size();
+}
+
+int Tracer::droppedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dropped_;
+}
+
+QByteArray Tracer::toChromeJson() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto microseconds = [](qint64 ns) {
+        return QByteArray::number(static_cast<double>(ns) / 1000.0, 'f', 3);
+    };
+    auto quoted = [](const char* text) {
+        QByteArray escaped(text ? text : "");
+        escaped.replace('\\', "\\\\").replace('"', "\\\"");
+        return '"' + escaped + '"';
+    };
+
+    QByteArray json;
+    json.reserve(events_.size() * 96 + 256);
+    json += "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":";
+    json += QByteArray::number(dropped_);
+    json += "},\"traceEvents\":[\n";
+
+    QByteArray process = QCoreApplication::applicationName().toUtf8();
+    json += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":";
+    json += quoted(process.isEmpty() ? "TouristAgency" : process.constData());
+    json += "}}";
+
+    for (const Event& event : events_) {
+        json += ",\n{\"name\":";
+        json += quoted(event.name);
+        json += ",\"cat\":";
+        json += quoted(event.category);
+        json += ",\"pid\":1,\"tid\":";
+        json += QByteArray::number(event.thread);
+        json += ",\"ts\":";
+        json += microseconds(event.timestampNs);
+        if (event.type == EventType::Zone) {
+            json += ",\"ph\":\"X\",\"dur\":";
+            json += microseconds(event.value);
+            json += "}";
+        } else {
+            json += ",\"ph\":\"C\",\"args\":{\"value\":";
+            json += QByteArray::number(event.value);
+            json += "}}";
+        }
+    }
+
+    json += "\n]}\n";
+    return json;
+}
+
+bool Tracer::exportToFile(const QString& filename) const {
+    QByteArray json = toChromeJson();
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return file.write(json) == json.size();
+}